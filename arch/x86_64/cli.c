@@ -113,6 +113,7 @@ static void cmd_blkwrite(int argc, char **argv);
 static void cmd_tasks(int argc, char **argv);
 static void cmd_mod(int argc, char **argv);
 static void cmd_metrics(int argc, char **argv);
+static void cmd_alloc(int argc, char **argv);
 static void cmd_uptime(int argc, char **argv);
 static void cmd_halt(int argc, char **argv);
 static void cmd_reboot(int argc, char **argv);
@@ -132,6 +133,7 @@ static const cli_cmd_t commands[] = {
     { "tasks",    "Task dispatch statistics",    cmd_tasks    },
     { "mod",      "List modules and handlers",   cmd_mod      },
     { "metrics",  "Global metric counters",      cmd_metrics  },
+    { "alloc",    "Allocator classes [tenant]",  cmd_alloc    },
     { "uptime",   "System uptime",               cmd_uptime   },
     { "halt",     "Shutdown kernel",             cmd_halt     },
     { "reboot",   "Reboot system",               cmd_reboot   },
@@ -427,13 +429,14 @@ static const char *metric_names[] = {
     "tasks_failed",   "tasks_retried",  "tasks_yielded",
     "alloc_bytes",    "alloc_fails",    "chan_emits",
     "chan_drops",      "chan_full",       "worker_parks",
-    "worker_wakes",
+    "worker_wakes",   "tasks_stolen",   "alloc_grows",
+    "alloc_in_use",   "alloc_reserved",
 };
 
 static void cmd_metrics(int argc, char **argv) {
     (void)argc; (void)argv;
     kprintf("Global metrics:\n");
-    for (uint32_t i = 0; i < 13; i++) {
+    for (uint32_t i = 0; i < sizeof(metric_names) / sizeof(metric_names[0]); i++) {
         uint64_t val = gmk_metric_get(&cli_kernel->metrics, i);
         kprintf("  ");
         print_padded(metric_names[i], 20);
@@ -441,6 +444,68 @@ static void cmd_metrics(int argc, char **argv) {
     }
 }
 
+/* ── alloc ───────────────────────────────────────────────────────── */
+
+static void alloc_summary(const char *name, const gmk_alloc_stats_t *st) {
+    kprintf("  ");
+    print_padded(name, 12);
+    kprintf("reserved %lu KB  in use %lu KB  chunks %u  fails %lu  frag %u/1000\n",
+            (unsigned long)(st->reserved_bytes >> 10),
+            (unsigned long)(st->used_bytes >> 10), st->chunks,
+            (unsigned long)st->alloc_fails, st->frag_permille);
+}
+
+/* Classes that were ever used; large extents count pages, not objects */
+static void alloc_classes(const gmk_alloc_stats_t *st) {
+    kprintf("  class  size     cap      used     peak     fails  frag/1000\n");
+    for (uint32_t i = 0; i < GMK_ALLOC_N_CLASSES; i++) {
+        const gmk_block_stats_t *c = &st->cls[i];
+        if (c->allocs == 0 && c->used == 0 && c->fails == 0) continue;
+        if (i == GMK_MAG_TASK)               kprintf("  task   ");
+        else if (i == GMK_MAG_TRACE)         kprintf("  trace  ");
+        else if (i == GMK_ALLOC_CLASS_LARGE) kprintf("  large  ");
+        else                                 kprintf("  bin %u  ", i - GMK_MAG_BLOCK);
+        kprintf("%u  %u  %u  %u  %lu  %u\n",
+                c->obj_size, c->capacity,
+                i == GMK_ALLOC_CLASS_LARGE ? c->pages : c->used,
+                c->high_water, (unsigned long)c->fails, c->frag_permille);
+    }
+}
+
+static void cmd_alloc(int argc, char **argv) {
+    gmk_alloc_stats_t st;
+
+    if (argc >= 2) {
+        int ok;
+        uint64_t t = parse_u64(argv[1], &ok);
+        if (!ok || t >= cli_kernel->cfg.n_tenants) {
+            kprintf("Usage: alloc [tenant < %u]\n", cli_kernel->cfg.n_tenants);
+            return;
+        }
+        gmk_alloc_t *a = gmk_tenant_alloc(cli_kernel, (uint16_t)t);
+        gmk_alloc_stats(a, &st);
+        kprintf("Tenant %lu (%s allocator):\n", (unsigned long)t,
+                a == &cli_kernel->alloc ? "shared" : "own");
+        alloc_summary("total", &st);
+        alloc_classes(&st);
+        return;
+    }
+
+    kprintf("Allocators:\n");
+    gmk_alloc_stats(&cli_kernel->alloc, &st);
+    alloc_summary("shared", &st);
+    for (uint32_t t = 0; t < cli_kernel->cfg.n_tenants; t++) {
+        gmk_alloc_t *a = cli_kernel->tenant_alloc[t];
+        if (!a) continue;
+        char name[12] = "tenant ";
+        name[7] = (char)('0' + t / 10);
+        name[8] = (char)('0' + t % 10);
+        name[9] = '\0';
+        gmk_alloc_stats(a, &st);
+        alloc_summary(name, &st);
+    }
+}
+
 /* ── uptime ──────────────────────────────────────────────────────── */
 
 static void cmd_uptime(int argc, char **argv) {
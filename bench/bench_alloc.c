@@ -0,0 +1,86 @@
+/*
+ * GGMK/cpu — Payload allocation throughput vs worker count
+ *
+ * Each thread runs gmk_payload_alloc / gmk_payload_release on a small
+ * working set. "shared" threads have no worker id and hit the slab lock
+ * on every call; "magazine" threads bind a worker id and go through
+ * their per-worker magazines.
+ */
+#include "ggmk/alloc.h"
+#include "bench_util.h"
+
+#define ARENA_SIZE   (64u << 20)
+#define PAYLOAD_SIZE 64
+#define WORKING_SET  8
+
+typedef struct {
+    gmk_alloc_t     *alloc;
+    bench_barrier_t *barrier;
+    uint64_t         ops;
+    uint32_t         worker_id;   /* UINT32_MAX = unbound */
+} bench_arg_t;
+
+static void *worker_fn(void *arg) {
+    bench_arg_t *a = (bench_arg_t *)arg;
+    void *live[WORKING_SET] = {0};
+
+    if (a->worker_id != UINT32_MAX)
+        gmk_hal_self_set(a->worker_id);
+    bench_barrier_wait(a->barrier);
+
+    for (uint64_t i = 0; i < a->ops; i++) {
+        uint32_t slot = (uint32_t)(i % WORKING_SET);
+        if (live[slot])
+            gmk_payload_release(a->alloc, live[slot]);
+        live[slot] = gmk_payload_alloc(a->alloc, PAYLOAD_SIZE);
+    }
+    for (uint32_t i = 0; i < WORKING_SET; i++)
+        if (live[i]) gmk_payload_release(a->alloc, live[i]);
+
+    if (a->worker_id != UINT32_MAX)
+        gmk_alloc_cache_flush(a->alloc, a->worker_id);
+    return NULL;
+}
+
+static void run(uint32_t threads, bool magazines, uint64_t ops) {
+    gmk_alloc_t alloc;
+    if (gmk_alloc_init(&alloc, ARENA_SIZE) != 0 ||
+        gmk_alloc_cache_init(&alloc, threads) != 0) {
+        fprintf(stderr, "alloc init failed\n");
+        exit(1);
+    }
+
+    bench_barrier_t barrier;
+    bench_barrier_init(&barrier);
+
+    pthread_t th[BENCH_MAX_THREADS];
+    bench_arg_t args[BENCH_MAX_THREADS];
+    uint64_t per = ops / threads;
+
+    for (uint32_t i = 0; i < threads; i++) {
+        args[i] = (bench_arg_t){ &alloc, &barrier, per,
+                                 magazines ? i : UINT32_MAX };
+        pthread_create(&th[i], NULL, worker_fn, &args[i]);
+    }
+
+    uint64_t t0 = bench_barrier_release(&barrier, threads);
+    for (uint32_t i = 0; i < threads; i++)
+        pthread_join(th[i], NULL);
+    uint64_t ns = bench_now_ns() - t0;
+
+    /* One op = one alloc + one release */
+    bench_report("payload_alloc", magazines ? "magazine" : "shared",
+                 threads, per * threads, ns);
+    gmk_alloc_destroy(&alloc);
+}
+
+int main(void) {
+    uint64_t ops = bench_ops(2000000);
+    static const uint32_t threads[] = { 1, 2, 4, 8 };
+
+    for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); i++) {
+        run(threads[i], false, ops);
+        run(threads[i], true, ops);
+    }
+    return 0;
+}
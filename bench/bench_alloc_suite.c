@@ -0,0 +1,311 @@
+/*
+ * GGMK/cpu — Allocator suite: gmk_alloc vs glibc malloc
+ *
+ * Four workloads, each run with the kernel allocator (variant "ggmk",
+ * bound worker ids, so magazines and bump slices are live) and with
+ * malloc/free (variant "libc"):
+ *   alloc_local    alloc/free on a per-thread working set
+ *   alloc_xfree    producer/consumer pairs: one side allocates, the other
+ *                  frees what it receives over an SPSC ring
+ *   alloc_payload  like xfree with refcounted payloads: the producer
+ *                  retains before handing over, and both sides release
+ *   alloc_bump     scratch bumps (sizes capped at BUMP_MAX) in batches of
+ *                  BUMP_BATCH under the tick epoch (libc: malloc the
+ *                  batch, then free it)
+ * Sizes follow channel traffic: mostly task-sized messages, a tail of
+ * payloads up to 16 KB (see size_table). One op is one alloc and its
+ * free; xfree/payload count the producer's allocations.
+ */
+#include "ggmk/alloc.h"
+#include "ggmk/ring_spsc.h"
+#include "ggmk/types.h"
+#include "bench_util.h"
+#include <sched.h>
+
+#define ARENA_SIZE   (256u << 20)
+#define WORKING_SET  64
+#define RING_CAP     1024
+#define BUMP_BATCH   64
+#define BUMP_MAX     1024
+
+/* 16 equally likely entries: ~half task-sized, tail to 16 KB */
+static const uint32_t size_table[16] = {
+    48, 48, 48, 48, 48, 48, 48, 64,
+    64, 96, 128, 256, 512, 1024, 4096, 16384,
+};
+
+static inline uint32_t next_rand(uint32_t *x) {
+    *x ^= *x << 13;
+    *x ^= *x >> 17;
+    *x ^= *x << 5;
+    return *x;
+}
+
+static inline uint32_t pick_size(uint32_t *x) {
+    return size_table[next_rand(x) & 15];
+}
+
+static inline uint32_t pick_scratch(uint32_t *x) {
+    uint32_t size = pick_size(x);
+    return size < BUMP_MAX ? size : BUMP_MAX;
+}
+
+/* ── Shared state for one run ──────────────────────────────────── */
+typedef struct {
+    bool              libc;
+    gmk_alloc_t       alloc;
+    gmk_epoch_t       epoch;
+    _Atomic(uint64_t) tick;
+    gmk_ring_spsc_t   rings[BENCH_MAX_THREADS / 2];
+    bench_barrier_t   barrier;
+    _Atomic(uint64_t) libc_fails;
+} suite_t;
+
+typedef struct {
+    suite_t  *s;
+    uint32_t  id;
+    uint64_t  ops;
+} bench_arg_t;
+
+static suite_t suite;
+
+static inline void *libc_alloc(suite_t *s, size_t size) {
+    void *p = malloc(size);
+    if (!p) gmk_atomic_add(&s->libc_fails, 1, memory_order_relaxed);
+    return p;
+}
+
+static inline void *obj_alloc(suite_t *s, uint32_t size) {
+    return s->libc ? libc_alloc(s, size) : gmk_alloc(&s->alloc, size);
+}
+
+static inline void obj_free(suite_t *s, void *p) {
+    if (s->libc) free(p);
+    else         gmk_free(&s->alloc, p);
+}
+
+/* libc payloads get the same hidden refcount header */
+static inline void *pay_alloc(suite_t *s, uint32_t size) {
+    if (!s->libc) return gmk_payload_alloc(&s->alloc, size);
+    gmk_payload_hdr_t *h = (gmk_payload_hdr_t *)libc_alloc(s, sizeof(*h) + size);
+    if (!h) return NULL;
+    atomic_init(&h->refcount, 1);
+    return h + 1;
+}
+
+static inline void pay_retain(void *p) {
+    gmk_payload_retain(p);   /* header layout is the same for both */
+}
+
+static inline void pay_release(suite_t *s, void *p) {
+    if (!s->libc) {
+        gmk_payload_release(&s->alloc, p);
+        return;
+    }
+    gmk_payload_hdr_t *h = (gmk_payload_hdr_t *)p - 1;
+    if (atomic_fetch_sub_explicit(&h->refcount, 1, memory_order_acq_rel) == 1)
+        free(h);
+}
+
+static void thread_begin(bench_arg_t *a) {
+    if (!a->s->libc) gmk_hal_self_set(a->id);
+    bench_barrier_wait(&a->s->barrier);
+}
+
+static void thread_end(bench_arg_t *a) {
+    if (!a->s->libc) gmk_alloc_cache_flush(&a->s->alloc, a->id);
+}
+
+/* ── Workloads ─────────────────────────────────────────────────── */
+static void *local_fn(void *arg) {
+    bench_arg_t *a = (bench_arg_t *)arg;
+    void *live[WORKING_SET] = {0};
+    uint32_t x = 2463534242u + a->id;
+    thread_begin(a);
+
+    for (uint64_t i = 0; i < a->ops; i++) {
+        uint32_t slot = next_rand(&x) % WORKING_SET;
+        if (live[slot]) obj_free(a->s, live[slot]);
+        live[slot] = obj_alloc(a->s, pick_size(&x));
+    }
+    for (uint32_t i = 0; i < WORKING_SET; i++)
+        if (live[i]) obj_free(a->s, live[i]);
+
+    thread_end(a);
+    return NULL;
+}
+
+/* Even ids produce into ring id/2, odd ids consume from it. A NULL
+ * pointer ends the stream. */
+static void ring_put(gmk_ring_spsc_t *r, void *p) {
+    while (gmk_ring_spsc_push(r, &p) != 0)
+        sched_yield();
+}
+
+static void *ring_get(gmk_ring_spsc_t *r) {
+    void *p;
+    while (gmk_ring_spsc_pop(r, &p) != 0)
+        sched_yield();
+    return p;
+}
+
+static void *xfree_fn(void *arg) {
+    bench_arg_t *a = (bench_arg_t *)arg;
+    gmk_ring_spsc_t *r = &a->s->rings[a->id / 2];
+    uint32_t x = 2463534242u + a->id;
+    thread_begin(a);
+
+    if (a->id % 2 == 0) {
+        for (uint64_t i = 0; i < a->ops; i++) {
+            void *p = obj_alloc(a->s, pick_size(&x));
+            if (p) ring_put(r, p);
+        }
+        ring_put(r, NULL);
+    } else {
+        void *p;
+        while ((p = ring_get(r)) != NULL)
+            obj_free(a->s, p);
+    }
+
+    thread_end(a);
+    return NULL;
+}
+
+static void *payload_fn(void *arg) {
+    bench_arg_t *a = (bench_arg_t *)arg;
+    gmk_ring_spsc_t *r = &a->s->rings[a->id / 2];
+    uint32_t x = 2463534242u + a->id;
+    thread_begin(a);
+
+    if (a->id % 2 == 0) {
+        void *live[WORKING_SET] = {0};
+        for (uint64_t i = 0; i < a->ops; i++) {
+            uint32_t slot = next_rand(&x) % WORKING_SET;
+            if (live[slot]) pay_release(a->s, live[slot]);
+            live[slot] = pay_alloc(a->s, pick_size(&x));
+            if (!live[slot]) continue;
+            pay_retain(live[slot]);
+            ring_put(r, live[slot]);
+        }
+        ring_put(r, NULL);
+        for (uint32_t i = 0; i < WORKING_SET; i++)
+            if (live[i]) pay_release(a->s, live[i]);
+    } else {
+        void *p;
+        while ((p = ring_get(r)) != NULL)
+            pay_release(a->s, p);
+    }
+
+    thread_end(a);
+    return NULL;
+}
+
+static void *bump_fn(void *arg) {
+    bench_arg_t *a = (bench_arg_t *)arg;
+    suite_t *s = a->s;
+    void *batch[BUMP_BATCH];
+    uint32_t x = 2463534242u + a->id;
+    thread_begin(a);
+
+    for (uint64_t i = 0; i < a->ops; i += BUMP_BATCH) {
+        if (s->libc) {
+            for (uint32_t k = 0; k < BUMP_BATCH; k++)
+                batch[k] = libc_alloc(s, pick_scratch(&x));
+            for (uint32_t k = 0; k < BUMP_BATCH; k++)
+                free(batch[k]);
+            continue;
+        }
+        gmk_epoch_enter(&s->epoch, a->id, &s->tick);
+        for (uint32_t k = 0; k < BUMP_BATCH; k++)
+            batch[k] = gmk_bump(&s->alloc, pick_scratch(&x));
+        gmk_epoch_exit(&s->epoch, a->id);
+        /* Every batch ends a tick, as if the timer ran at batch rate */
+        gmk_epoch_advance(&s->epoch,
+                          gmk_atomic_add(&s->tick, 1, memory_order_acq_rel) + 1);
+    }
+    (void)batch;
+
+    thread_end(a);
+    return NULL;
+}
+
+/* ── Driver ────────────────────────────────────────────────────── */
+typedef struct {
+    const char *name;
+    void     *(*fn)(void *);
+    bool        pairs;      /* producer/consumer: threads must be even */
+} workload_t;
+
+static void run(const workload_t *w, bool libc, uint32_t threads, uint64_t ops) {
+    suite_t *s = &suite;
+    s->libc = libc;
+    if (gmk_alloc_init(&s->alloc, ARENA_SIZE) != 0 ||
+        gmk_alloc_cache_init(&s->alloc, threads) != 0 ||
+        gmk_epoch_init(&s->epoch, threads) != 0) {
+        fprintf(stderr, "alloc init failed\n");
+        exit(1);
+    }
+    gmk_alloc_set_epoch(&s->alloc, &s->epoch);
+    atomic_init(&s->tick, 1);
+    atomic_init(&s->libc_fails, 0);
+    for (uint32_t i = 0; w->pairs && i < threads / 2; i++) {
+        if (gmk_ring_spsc_init(&s->rings[i], RING_CAP, sizeof(void *)) != 0) {
+            fprintf(stderr, "ring init failed\n");
+            exit(1);
+        }
+    }
+    bench_barrier_init(&s->barrier);
+
+    pthread_t th[BENCH_MAX_THREADS];
+    bench_arg_t args[BENCH_MAX_THREADS];
+    uint32_t producers = w->pairs ? threads / 2 : threads;
+    uint64_t per = ops / producers;
+
+    for (uint32_t i = 0; i < threads; i++) {
+        args[i] = (bench_arg_t){ s, i, per };
+        pthread_create(&th[i], NULL, w->fn, &args[i]);
+    }
+
+    uint64_t t0 = bench_barrier_release(&s->barrier, threads);
+    for (uint32_t i = 0; i < threads; i++)
+        pthread_join(th[i], NULL);
+    uint64_t ns = bench_now_ns() - t0;
+
+    /* A failed alloc is cheap and flatters ops_per_sec, so report them.
+     * Bump slices fail when a preempted worker holds the epoch back. */
+    uint64_t fails = 0;
+    if (libc) {
+        fails = gmk_atomic_load(&s->libc_fails, memory_order_relaxed);
+    } else {
+        fails = gmk_atomic_load(&s->alloc.total_alloc_fails, memory_order_relaxed);
+        for (uint32_t i = 0; i < threads; i++)
+            fails += s->alloc.caches[i]->bump.fails;
+    }
+    bench_report_fails(w->name, libc ? "libc" : "ggmk", threads, per * producers,
+                       ns, fails);
+
+    for (uint32_t i = 0; w->pairs && i < threads / 2; i++)
+        gmk_ring_spsc_destroy(&s->rings[i]);
+    gmk_epoch_destroy(&s->epoch);
+    gmk_alloc_destroy(&s->alloc);
+}
+
+int main(void) {
+    uint64_t ops = bench_ops(1000000);
+    static const uint32_t threads[] = { 1, 2, 4, 8, 16, 32 };
+    static const workload_t workloads[] = {
+        { "alloc_local",   local_fn,   false },
+        { "alloc_xfree",   xfree_fn,   true  },
+        { "alloc_payload", payload_fn, true  },
+        { "alloc_bump",    bump_fn,    false },
+    };
+
+    for (size_t w = 0; w < sizeof(workloads) / sizeof(workloads[0]); w++) {
+        for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+            if (workloads[w].pairs && threads[t] < 2) continue;
+            run(&workloads[w], false, threads[t], ops);
+            run(&workloads[w], true, threads[t], ops);
+        }
+    }
+    return 0;
+}
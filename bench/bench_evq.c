@@ -0,0 +1,309 @@
+/*
+ * GGMK/cpu — EVQ: timing wheel vs the binary heap it replaced
+ *
+ * The heap variant is the old EVQ kept here as a baseline: a locked
+ * min-heap keyed by (tick << 32) | (priority << 16) | seq.
+ *   evq_hold    classic hold model: N timers pending; each tick pops
+ *               everything due and re-arms it 1..SPAN ticks ahead
+ *   evq_cancel  arm a timer and cancel an earlier one, N pending
+ *               (wheel only: the heap has no cancel)
+ * N runs from 10K to 1M. One op is one arm plus its pop or cancel.
+ * Variant names carry N ("wheel_100k") since the threads field is 1.
+ *
+ * Across 1-32 threads, as the scheduler's shards see it:
+ *   evq_shard   each thread arms near timers and expires what is due;
+ *               "shared" puts every thread on one EVQ, "sharded" gives
+ *               each its own
+ *   evq_idle    idle polls of a shard with nothing due: "lock" pops
+ *               under the lock, "peek" reads next_due first
+ */
+#include "ggmk/sched.h"
+#include "ggmk/hal.h"
+#include "bench_util.h"
+#include <string.h>
+
+#define SPAN   1024
+#define BATCH  64
+
+static inline uint32_t next_rand(uint32_t *x) {
+    *x ^= *x << 13;
+    *x ^= *x >> 17;
+    *x ^= *x << 5;
+    return *x;
+}
+
+/* ── Baseline: the heap EVQ ────────────────────────────────────── */
+typedef struct {
+    uint64_t    key;
+    gmk_task_t  task;
+} heap_entry_t;
+
+typedef struct {
+    heap_entry_t *heap;
+    uint32_t      count, cap, next_seq;
+    gmk_lock_t    lock;
+} heap_evq_t;
+
+static int heap_init(heap_evq_t *q, uint32_t cap) {
+    q->heap = (heap_entry_t *)calloc(cap, sizeof(heap_entry_t));
+    if (!q->heap) return -1;
+    q->count = 0;
+    q->cap = cap;
+    q->next_seq = 0;
+    gmk_lock_init(&q->lock);
+    return 0;
+}
+
+static void heap_destroy(heap_evq_t *q) {
+    free(q->heap);
+    gmk_lock_destroy(&q->lock);
+}
+
+static int heap_push(heap_evq_t *q, const gmk_task_t *t) {
+    gmk_lock_acquire(&q->lock);
+    if (q->count >= q->cap) {
+        gmk_lock_release(&q->lock);
+        return -1;
+    }
+    uint32_t seq = q->next_seq++;
+    uint32_t i = q->count++;
+    q->heap[i].key = ((uint64_t)(uint32_t)t->meta0 << 32) |
+                     ((uint64_t)GMK_PRIORITY(t->flags) << 16) | (seq & 0xFFFF);
+    q->heap[i].task = *t;
+    q->heap[i].task.seq = seq;
+    while (i > 0) {
+        uint32_t p = (i - 1) / 2;
+        if (q->heap[i].key >= q->heap[p].key) break;
+        heap_entry_t tmp = q->heap[i];
+        q->heap[i] = q->heap[p];
+        q->heap[p] = tmp;
+        i = p;
+    }
+    gmk_lock_release(&q->lock);
+    return 0;
+}
+
+static int heap_pop_due(heap_evq_t *q, uint32_t now, gmk_task_t *out) {
+    gmk_lock_acquire(&q->lock);
+    if (q->count == 0 || (uint32_t)(q->heap[0].key >> 32) > now) {
+        gmk_lock_release(&q->lock);
+        return -1;
+    }
+    *out = q->heap[0].task;
+    uint32_t n = --q->count, i = 0;
+    if (n > 0) {
+        q->heap[0] = q->heap[n];
+        for (;;) {
+            uint32_t m = i, l = 2 * i + 1, r = 2 * i + 2;
+            if (l < n && q->heap[l].key < q->heap[m].key) m = l;
+            if (r < n && q->heap[r].key < q->heap[m].key) m = r;
+            if (m == i) break;
+            heap_entry_t tmp = q->heap[i];
+            q->heap[i] = q->heap[m];
+            q->heap[m] = tmp;
+            i = m;
+        }
+    }
+    gmk_lock_release(&q->lock);
+    return 0;
+}
+
+/* ── Workloads ─────────────────────────────────────────────────── */
+static gmk_task_t make_timer(uint32_t tick, uint32_t *x) {
+    gmk_task_t t;
+    memset(&t, 0, sizeof(t));
+    t.meta0 = tick;
+    t.flags = GMK_SET_PRIORITY(0, next_rand(x) & 3);
+    return t;
+}
+
+static void variant_name(char *buf, size_t len, const char *impl, uint32_t n) {
+    if (n >= 1000000) snprintf(buf, len, "%s_%um", impl, n / 1000000);
+    else              snprintf(buf, len, "%s_%uk", impl, n / 1000);
+}
+
+static void hold(bool wheel, uint32_t n, uint64_t ops) {
+    heap_evq_t heap;
+    gmk_evq_t  evq;
+    int rc = wheel ? gmk_evq_init(&evq, n) : heap_init(&heap, n);
+    if (rc != 0) {
+        fprintf(stderr, "evq init failed\n");
+        exit(1);
+    }
+
+    uint32_t x = 2463534242u;
+    for (uint32_t i = 0; i < n; i++) {
+        gmk_task_t t = make_timer(1 + next_rand(&x) % SPAN, &x);
+        if (wheel) gmk_evq_push(&evq, &t);
+        else       heap_push(&heap, &t);
+    }
+
+    gmk_task_t batch[BATCH];
+    uint64_t done = 0;
+    uint32_t tick = 0;
+    uint64_t t0 = bench_now_ns();
+    while (done < ops) {
+        tick++;
+        for (;;) {
+            uint32_t got = 0;
+            if (wheel) {
+                got = gmk_evq_pop_due_n(&evq, tick, batch, BATCH);
+            } else {
+                while (got < BATCH && heap_pop_due(&heap, tick, &batch[got]) == 0)
+                    got++;
+            }
+            for (uint32_t i = 0; i < got; i++) {
+                batch[i].meta0 = tick + 1 + next_rand(&x) % SPAN;
+                if (wheel) gmk_evq_push(&evq, &batch[i]);
+                else       heap_push(&heap, &batch[i]);
+            }
+            done += got;
+            if (got < BATCH) break;
+        }
+    }
+    uint64_t ns = bench_now_ns() - t0;
+
+    char variant[32];
+    variant_name(variant, sizeof(variant), wheel ? "wheel" : "heap", n);
+    bench_report("evq_hold", variant, 1, done, ns);
+
+    if (wheel) gmk_evq_destroy(&evq);
+    else       heap_destroy(&heap);
+}
+
+static void cancel(uint32_t n, uint64_t ops) {
+    gmk_evq_t evq;
+    gmk_evq_handle_t *h = (gmk_evq_handle_t *)calloc(n, sizeof(*h));
+    if (!h || gmk_evq_init(&evq, n + 1) != 0) {
+        fprintf(stderr, "evq init failed\n");
+        exit(1);
+    }
+
+    uint32_t x = 2463534242u;
+    for (uint32_t i = 0; i < n; i++) {
+        gmk_task_t t = make_timer(1 + next_rand(&x) % (SPAN * 64), &x);
+        gmk_evq_arm(&evq, &t, &h[i]);
+    }
+
+    uint64_t fails = 0;
+    uint64_t t0 = bench_now_ns();
+    for (uint64_t i = 0; i < ops; i++) {
+        uint32_t slot = next_rand(&x) % n;
+        if (gmk_evq_cancel(&evq, h[slot]) != 0) fails++;
+        gmk_task_t t = make_timer(1 + next_rand(&x) % (SPAN * 64), &x);
+        gmk_evq_arm(&evq, &t, &h[slot]);
+    }
+    uint64_t ns = bench_now_ns() - t0;
+
+    char variant[32];
+    variant_name(variant, sizeof(variant), "wheel", n);
+    bench_report_fails("evq_cancel", variant, 1, ops, ns, fails);
+
+    gmk_evq_destroy(&evq);
+    free(h);
+}
+
+/* ── Shards across threads ─────────────────────────────────────── */
+typedef struct {
+    gmk_evq_t        evqs[BENCH_MAX_THREADS];
+    bool             sharded;
+    bool             peek;
+    bench_barrier_t  barrier;
+} shard_bench_t;
+
+typedef struct {
+    shard_bench_t *b;
+    uint32_t       id;
+    uint64_t       ops;
+} shard_arg_t;
+
+static shard_bench_t sb;
+
+static void *shard_fn(void *arg) {
+    shard_arg_t *a = (shard_arg_t *)arg;
+    gmk_evq_t *evq = &a->b->evqs[a->b->sharded ? a->id : 0];
+    gmk_task_t batch[BATCH];
+    uint32_t x = 2463534242u + a->id;
+    bench_barrier_wait(&a->b->barrier);
+
+    uint32_t tick = 0;
+    for (uint64_t i = 0; i < a->ops; i++) {
+        gmk_task_t t = make_timer(tick + 1 + next_rand(&x) % 64, &x);
+        gmk_evq_push(evq, &t);
+        if ((i & 15) == 15)
+            gmk_evq_pop_due_n(evq, ++tick, batch, BATCH);
+    }
+    return NULL;
+}
+
+static void *idle_fn(void *arg) {
+    shard_arg_t *a = (shard_arg_t *)arg;
+    gmk_evq_t *evq = &a->b->evqs[a->id];
+    gmk_task_t out;
+    bench_barrier_wait(&a->b->barrier);
+
+    /* The shard holds one far timer: every poll finds nothing due */
+    for (uint64_t i = 0; i < a->ops; i++) {
+        if (a->b->peek && gmk_evq_next_due(evq) > i)
+            continue;
+        gmk_evq_pop_due(evq, i, &out);
+    }
+    return NULL;
+}
+
+static void run_threads(const char *name, const char *variant, void *(*fn)(void *),
+                        uint32_t threads, uint64_t ops) {
+    shard_bench_t *b = &sb;
+    for (uint32_t i = 0; i < threads; i++) {
+        if (gmk_evq_init(&b->evqs[i], (uint32_t)(ops / threads) + 1024) != 0) {
+            fprintf(stderr, "evq init failed\n");
+            exit(1);
+        }
+        gmk_task_t far;
+        memset(&far, 0, sizeof(far));
+        far.meta0 = UINT64_MAX - 1;
+        gmk_evq_push(&b->evqs[i], &far);
+    }
+    bench_barrier_init(&b->barrier);
+
+    pthread_t th[BENCH_MAX_THREADS];
+    shard_arg_t args[BENCH_MAX_THREADS];
+    for (uint32_t i = 0; i < threads; i++) {
+        args[i] = (shard_arg_t){ b, i, ops / threads };
+        pthread_create(&th[i], NULL, fn, &args[i]);
+    }
+    uint64_t t0 = bench_barrier_release(&b->barrier, threads);
+    for (uint32_t i = 0; i < threads; i++)
+        pthread_join(th[i], NULL);
+    uint64_t ns = bench_now_ns() - t0;
+
+    bench_report(name, variant, threads, (ops / threads) * threads, ns);
+    for (uint32_t i = 0; i < threads; i++)
+        gmk_evq_destroy(&b->evqs[i]);
+}
+
+int main(void) {
+    uint64_t ops = bench_ops(2000000);
+    static const uint32_t pending[] = { 10000, 100000, 1000000 };
+    static const uint32_t threads[] = { 1, 2, 4, 8, 16, 32 };
+
+    for (size_t i = 0; i < sizeof(pending) / sizeof(pending[0]); i++) {
+        hold(false, pending[i], ops);
+        hold(true, pending[i], ops);
+        cancel(pending[i], ops);
+    }
+
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        sb.sharded = false;
+        run_threads("evq_shard", "shared", shard_fn, threads[t], ops);
+        sb.sharded = true;
+        run_threads("evq_shard", "sharded", shard_fn, threads[t], ops);
+    }
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        sb.peek = false;
+        run_threads("evq_idle", "lock", idle_fn, threads[t], ops);
+        sb.peek = true;
+        run_threads("evq_idle", "peek", idle_fn, threads[t], ops);
+    }
+    return 0;
+}
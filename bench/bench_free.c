@@ -0,0 +1,81 @@
+/*
+ * GGMK/cpu — Free-path class lookup: range-compare chain vs page map
+ *
+ * "range" is the pre-page-map gmk_free dispatch: compare the pointer
+ * against each region, then recompute the block bin from a caller-kept
+ * size. "page_map" is gmk_alloc_class. Both resolve the owning slab for
+ * a mixed set of live pointers; "free" is a full gmk_free/gmk_alloc pair.
+ */
+#include "ggmk/alloc.h"
+#include "ggmk/types.h"
+#include "bench_util.h"
+
+#define ARENA_SIZE  (64u << 20)
+#define N_PTRS      1024
+
+static void *ptrs[N_PTRS];
+static uint32_t sizes[N_PTRS];
+
+static inline bool in_slab(const gmk_slab_t *s, const uint8_t *p) {
+    return p >= s->base && p < s->base + s->total_size;
+}
+
+static int range_class(const gmk_alloc_t *a, const void *ptr, uint32_t size) {
+    const uint8_t *p = (const uint8_t *)ptr;
+    if (in_slab(&a->task_slab, p))  return GMK_MAG_TASK;
+    if (in_slab(&a->trace_slab, p)) return GMK_MAG_TRACE;
+    if (p >= a->block.bins[0].base &&
+        p < a->bump.base)           return GMK_MAG_BLOCK + gmk_block_bin(size);
+    return -1;
+}
+
+static void fill(gmk_alloc_t *a) {
+    /* Deterministic mix: tasks and every block bin */
+    uint32_t x = 0x9E3779B9u;
+    for (uint32_t i = 0; i < N_PTRS; i++) {
+        x = x * 1664525u + 1013904223u;
+        sizes[i] = (x >> 30) == 0 ? (uint32_t)sizeof(gmk_task_t)
+                                  : 16u << ((x >> 16) % 10);
+        ptrs[i] = gmk_alloc(a, sizes[i]);
+        if (!ptrs[i]) {
+            fprintf(stderr, "alloc failed\n");
+            exit(1);
+        }
+    }
+}
+
+int main(void) {
+    uint64_t ops = bench_ops(20000000);
+    gmk_alloc_t a;
+    if (gmk_alloc_init(&a, ARENA_SIZE) != 0) {
+        fprintf(stderr, "alloc init failed\n");
+        return 1;
+    }
+    fill(&a);
+
+    volatile int sink = 0;
+    uint64_t t0 = bench_now_ns();
+    for (uint64_t i = 0; i < ops; i++) {
+        uint32_t k = (uint32_t)(i % N_PTRS);
+        sink += range_class(&a, ptrs[k], sizes[k]);
+    }
+    bench_report("free_lookup", "range", 1, ops, bench_now_ns() - t0);
+
+    t0 = bench_now_ns();
+    for (uint64_t i = 0; i < ops; i++)
+        sink += gmk_alloc_class(&a, ptrs[i % N_PTRS]);
+    bench_report("free_lookup", "page_map", 1, ops, bench_now_ns() - t0);
+
+    /* One op = gmk_free + gmk_alloc of the same size */
+    t0 = bench_now_ns();
+    for (uint64_t i = 0; i < ops; i++) {
+        uint32_t k = (uint32_t)(i % N_PTRS);
+        gmk_free(&a, ptrs[k]);
+        ptrs[k] = gmk_alloc(&a, sizes[k]);
+    }
+    bench_report("free_lookup", "free", 1, ops, bench_now_ns() - t0);
+
+    (void)sink;
+    gmk_alloc_destroy(&a);
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * GGMK/cpu — Idle parking: wake latency and idle CPU
+ *
+ * Boots the kernel with 1-8 workers in two park modes: "spin" (the
+ * default GMK_PARK_SPIN_NS spin before parking) and "park"
+ * (GMK_PARK_SPIN_OFF, straight to the futex).
+ *   park_wake  the host submits one task, waits for it to run, then idles
+ *              GAP_NS so every worker is parked again; latency is submit
+ *              to handler entry. Extra fields: p50_ns, p99_ns, max_ns
+ *   park_idle  nothing is submitted for IDLE_NS; reports the process CPU
+ *              time burned (cpu_ns) and worker wakes over that window
+ * One op is one submitted task (park_wake) or one idle window (park_idle).
+ */
+#include "ggmk/ggmk.h"
+#include "bench_util.h"
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define GAP_NS   500000ull        /* > GMK_PARK_SPIN_NS: workers are parked */
+#define IDLE_NS  200000000ull
+#define SETTLE_US 20000
+
+static _Atomic(uint64_t) ran_ns;
+
+static int stamp_handler(gmk_ctx_t *ctx) {
+    (void)ctx;
+    gmk_atomic_store(&ran_ns, gmk_hal_now_ns(), memory_order_release);
+    return GMK_OK;
+}
+
+static gmk_handler_reg_t handlers[] = {
+    { .type = 1, .fn = stamp_handler, .name = "stamp" },
+};
+static gmk_module_t mod = {
+    .name = "park_bench", .version = GMK_VERSION(0, 1, 0),
+    .handlers = handlers, .n_handlers = 1,
+};
+
+static gmk_kernel_t kernel;
+
+static void boot(uint32_t workers, uint64_t spin_ns) {
+    gmk_module_t *mods[] = { &mod };
+    gmk_boot_cfg_t cfg = {
+        .arena_size   = 16 * 1024 * 1024,
+        .n_workers    = workers,
+        .n_tenants    = 1,
+        .park_spin_ns = spin_ns,
+    };
+    if (gmk_boot(&kernel, &cfg, mods, 1) != 0) {
+        fprintf(stderr, "boot failed\n");
+        exit(1);
+    }
+    usleep(SETTLE_US);
+}
+
+static uint64_t cpu_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void wake(const char *variant, uint64_t spin_ns, uint32_t workers,
+                 uint64_t samples) {
+    uint64_t *lat = (uint64_t *)calloc(samples, sizeof(uint64_t));
+    if (!lat) {
+        fprintf(stderr, "alloc failed\n");
+        exit(1);
+    }
+    boot(workers, spin_ns);
+
+    uint64_t total = 0, fails = 0;
+    for (uint64_t i = 0; i < samples; i++) {
+        gmk_task_t t;
+        memset(&t, 0, sizeof(t));
+        t.type = 1;
+        gmk_atomic_store(&ran_ns, 0, memory_order_relaxed);
+        uint64_t t0 = gmk_hal_now_ns();
+        if (gmk_submit(&kernel, &t) != 0) {
+            fails++;
+            continue;
+        }
+        uint64_t seen;
+        while ((seen = gmk_atomic_load(&ran_ns, memory_order_acquire)) == 0)
+            ;
+        lat[i - fails] = seen - t0;
+        total += seen - t0;
+
+        uint64_t idle = gmk_hal_now_ns() + GAP_NS;
+        while (gmk_hal_now_ns() < idle)
+            usleep(GAP_NS / 2000);
+    }
+    gmk_halt(&kernel);
+
+    uint64_t n = samples - fails;
+    qsort(lat, n, sizeof(uint64_t), cmp_u64);
+    bench_report_line("park_wake", variant, workers, n, total);
+    printf(" p50_ns=%llu p99_ns=%llu max_ns=%llu fails=%llu\n",
+           (unsigned long long)(n ? lat[n / 2] : 0),
+           (unsigned long long)(n ? lat[n * 99 / 100] : 0),
+           (unsigned long long)(n ? lat[n - 1] : 0),
+           (unsigned long long)fails);
+    fflush(stdout);
+    free(lat);
+}
+
+static void idle(const char *variant, uint64_t spin_ns, uint32_t workers) {
+    boot(workers, spin_ns);
+
+    uint64_t wakes = gmk_metric_get(&kernel.metrics, GMK_METRIC_WORKER_WAKES);
+    uint64_t cpu = cpu_now_ns();
+    uint64_t t0 = gmk_hal_now_ns();
+    usleep(IDLE_NS / 1000);
+    uint64_t ns = gmk_hal_now_ns() - t0;
+    cpu = cpu_now_ns() - cpu;
+    wakes = gmk_metric_get(&kernel.metrics, GMK_METRIC_WORKER_WAKES) - wakes;
+    gmk_halt(&kernel);
+
+    bench_report_line("park_idle", variant, workers, 1, ns);
+    printf(" cpu_ns=%llu wakes=%llu\n",
+           (unsigned long long)cpu, (unsigned long long)wakes);
+    fflush(stdout);
+}
+
+int main(void) {
+    uint64_t samples = bench_ops(2000);
+    static const uint32_t workers[] = { 1, 2, 4, 8 };
+    static const struct { const char *name; uint64_t spin_ns; } modes[] = {
+        { "spin", 0 },
+        { "park", GMK_PARK_SPIN_OFF },
+    };
+
+    for (size_t w = 0; w < sizeof(workers) / sizeof(workers[0]); w++)
+        for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++)
+            wake(modes[m].name, modes[m].spin_ns, workers[w], samples);
+    for (size_t w = 0; w < sizeof(workers) / sizeof(workers[0]); w++)
+        for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++)
+            idle(modes[m].name, modes[m].spin_ns, workers[w]);
+    return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * GGMK/cpu — MPMC cell layout comparison on task-carrying rings
+ *
+ * Every thread alternates push and pop of a gmk_task_t on one shared
+ * ring, the way workers both feed and drain the RQ. Run for the RQ
+ * sub-queue shape (GMK_RQ_DEFAULT_CAP) and the channel ring shape
+ * (GMK_CHAN_DEFAULT_SLOTS) under each layout, 1–32 threads.
+ */
+#include "ggmk/ring_mpmc.h"
+#include "ggmk/types.h"
+#include "ggmk/error.h"
+#include "bench_util.h"
+
+typedef struct {
+    gmk_ring_mpmc_t *ring;
+    bench_barrier_t *barrier;
+    uint64_t         ops;   /* push+pop pairs */
+} bench_arg_t;
+
+static void *worker_fn(void *arg) {
+    bench_arg_t *a = (bench_arg_t *)arg;
+    gmk_task_t t;
+    memset(&t, 0, sizeof(t));
+    bench_barrier_wait(a->barrier);
+
+    for (uint64_t i = 0; i < a->ops; i++) {
+        t.meta0 = i;
+        while (gmk_ring_mpmc_push(a->ring, &t) != 0) { /* spin */ }
+        while (gmk_ring_mpmc_pop(a->ring, &t) != 0)  { /* spin */ }
+    }
+    return NULL;
+}
+
+static const char *layout_name(uint32_t layout) {
+    switch (layout) {
+    case GMK_RING_PACKED: return "packed";
+    case GMK_RING_PADDED: return "padded";
+    case GMK_RING_SPLIT:  return "split";
+    default:              return "?";
+    }
+}
+
+static void run(const char *bench, uint32_t cap, uint32_t layout,
+                uint32_t threads, uint64_t ops) {
+    gmk_ring_mpmc_t ring;
+    if (gmk_ring_mpmc_init_layout(&ring, cap, sizeof(gmk_task_t), layout) != 0) {
+        fprintf(stderr, "ring init failed\n");
+        exit(1);
+    }
+
+    bench_barrier_t barrier;
+    bench_barrier_init(&barrier);
+
+    pthread_t th[BENCH_MAX_THREADS];
+    bench_arg_t args[BENCH_MAX_THREADS];
+    uint64_t per = ops / threads;
+
+    for (uint32_t i = 0; i < threads; i++) {
+        args[i] = (bench_arg_t){ &ring, &barrier, per };
+        pthread_create(&th[i], NULL, worker_fn, &args[i]);
+    }
+
+    uint64_t t0 = bench_barrier_release(&barrier, threads);
+    for (uint32_t i = 0; i < threads; i++)
+        pthread_join(th[i], NULL);
+    uint64_t ns = bench_now_ns() - t0;
+
+    /* Each pair is two ring operations */
+    bench_report(bench, layout_name(layout), threads, per * threads * 2, ns);
+    gmk_ring_mpmc_destroy(&ring);
+}
+
+int main(void) {
+    uint64_t ops = bench_ops(1000000);
+    static const uint32_t threads[] = { 1, 2, 4, 8, 16, 32 };
+    static const uint32_t layouts[] = {
+        GMK_RING_PACKED, GMK_RING_PADDED, GMK_RING_SPLIT
+    };
+
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        for (size_t l = 0; l < sizeof(layouts) / sizeof(layouts[0]); l++) {
+            run("ring_layout_rq", GMK_RQ_DEFAULT_CAP, layouts[l],
+                threads[t], ops);
+            run("ring_layout_chan", GMK_CHAN_DEFAULT_SLOTS, layouts[l],
+                threads[t], ops);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * GGMK/cpu — MPMC ring throughput: single-element vs bulk push/pop
+ *
+ * N producers and N consumers share one task-sized ring. Each producer
+ * pushes ops/N elements; throughput is total elements moved per second.
+ */
+#include "ggmk/ring_mpmc.h"
+#include "ggmk/types.h"
+#include "bench_util.h"
+
+#define RING_CAP   4096
+#define BULK_N     32
+
+typedef struct {
+    gmk_ring_mpmc_t  *ring;
+    bench_barrier_t  *barrier;
+    uint64_t          ops;      /* elements this thread moves */
+    uint32_t          bulk;     /* 0 = single-element path    */
+} bench_arg_t;
+
+static void *producer_fn(void *arg) {
+    bench_arg_t *a = (bench_arg_t *)arg;
+    gmk_task_t tasks[BULK_N];
+    memset(tasks, 0, sizeof(tasks));
+    bench_barrier_wait(a->barrier);
+
+    uint64_t done = 0;
+    while (done < a->ops) {
+        if (a->bulk) {
+            uint64_t left = a->ops - done;
+            uint32_t n = left < a->bulk ? (uint32_t)left : a->bulk;
+            done += gmk_ring_mpmc_push_n(a->ring, tasks, n);
+        } else if (gmk_ring_mpmc_push(a->ring, &tasks[0]) == 0) {
+            done++;
+        }
+    }
+    return NULL;
+}
+
+static void *consumer_fn(void *arg) {
+    bench_arg_t *a = (bench_arg_t *)arg;
+    gmk_task_t tasks[BULK_N];
+    bench_barrier_wait(a->barrier);
+
+    uint64_t done = 0;
+    while (done < a->ops) {
+        if (a->bulk) {
+            uint64_t left = a->ops - done;
+            uint32_t n = left < a->bulk ? (uint32_t)left : a->bulk;
+            done += gmk_ring_mpmc_pop_n(a->ring, tasks, n);
+        } else if (gmk_ring_mpmc_pop(a->ring, &tasks[0]) == 0) {
+            done++;
+        }
+    }
+    return NULL;
+}
+
+static void run(uint32_t pairs, uint32_t bulk, uint64_t ops) {
+    gmk_ring_mpmc_t ring;
+    if (gmk_ring_mpmc_init(&ring, RING_CAP, sizeof(gmk_task_t)) != 0) {
+        fprintf(stderr, "ring init failed\n");
+        exit(1);
+    }
+
+    bench_barrier_t barrier;
+    bench_barrier_init(&barrier);
+
+    pthread_t th[BENCH_MAX_THREADS];
+    bench_arg_t args[BENCH_MAX_THREADS];
+    uint64_t per = ops / pairs;
+
+    for (uint32_t i = 0; i < pairs * 2; i++) {
+        args[i] = (bench_arg_t){ &ring, &barrier, per, bulk };
+        pthread_create(&th[i], NULL, i < pairs ? producer_fn : consumer_fn,
+                       &args[i]);
+    }
+
+    uint64_t t0 = bench_barrier_release(&barrier, pairs * 2);
+    for (uint32_t i = 0; i < pairs * 2; i++)
+        pthread_join(th[i], NULL);
+    uint64_t ns = bench_now_ns() - t0;
+
+    bench_report("ring_mpmc", bulk ? "bulk32" : "single", pairs * 2,
+                 per * pairs, ns);
+    gmk_ring_mpmc_destroy(&ring);
+}
+
+int main(void) {
+    uint64_t ops = bench_ops(2000000);
+    static const uint32_t pairs[] = { 1, 2, 4 };
+
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+        run(pairs[i], 0, ops);
+        run(pairs[i], BULK_N, ops);
+    }
+    return 0;
+}
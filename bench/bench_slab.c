@@ -0,0 +1,88 @@
+/*
+ * GGMK/cpu — Slab contention: LOCKED vs SPIN vs LOCKFREE
+ *
+ * All threads hammer one slab with alloc/free pairs (no magazines), the
+ * worst case the per-worker caches fall back to on refill and flush.
+ */
+#include "ggmk/alloc.h"
+#include "bench_util.h"
+
+#define SLAB_OBJS    4096
+#define OBJ_SIZE     64
+#define WORKING_SET  4
+
+typedef struct {
+    gmk_slab_t      *slab;
+    bench_barrier_t *barrier;
+    uint64_t         ops;
+} bench_arg_t;
+
+static void *worker_fn(void *arg) {
+    bench_arg_t *a = (bench_arg_t *)arg;
+    void *live[WORKING_SET] = {0};
+    bench_barrier_wait(a->barrier);
+
+    for (uint64_t i = 0; i < a->ops; i++) {
+        uint32_t slot = (uint32_t)(i % WORKING_SET);
+        if (live[slot])
+            gmk_slab_free(a->slab, live[slot]);
+        live[slot] = gmk_slab_alloc(a->slab);
+    }
+    for (uint32_t i = 0; i < WORKING_SET; i++)
+        if (live[i]) gmk_slab_free(a->slab, live[i]);
+    return NULL;
+}
+
+static const char *mode_name(uint32_t mode) {
+    switch (mode) {
+    case GMK_SLAB_LOCKED:   return "locked";
+    case GMK_SLAB_SPIN:     return "spin";
+    case GMK_SLAB_LOCKFREE: return "lockfree";
+    default:                return "?";
+    }
+}
+
+static void run(uint32_t mode, uint32_t threads, uint64_t ops) {
+    size_t mem_size = (size_t)SLAB_OBJS * (OBJ_SIZE + sizeof(int32_t));
+    void *mem = gmk_hal_page_alloc(mem_size, GMK_CACHE_LINE);
+    gmk_slab_t slab;
+    if (!mem || gmk_slab_init(&slab, mem, mem_size, OBJ_SIZE) != 0) {
+        fprintf(stderr, "slab init failed\n");
+        exit(1);
+    }
+    gmk_slab_set_mode(&slab, mode);
+
+    bench_barrier_t barrier;
+    bench_barrier_init(&barrier);
+
+    pthread_t th[BENCH_MAX_THREADS];
+    bench_arg_t args[BENCH_MAX_THREADS];
+    uint64_t per = ops / threads;
+
+    for (uint32_t i = 0; i < threads; i++) {
+        args[i] = (bench_arg_t){ &slab, &barrier, per };
+        pthread_create(&th[i], NULL, worker_fn, &args[i]);
+    }
+
+    uint64_t t0 = bench_barrier_release(&barrier, threads);
+    for (uint32_t i = 0; i < threads; i++)
+        pthread_join(th[i], NULL);
+    uint64_t ns = bench_now_ns() - t0;
+
+    bench_report("slab_contention", mode_name(mode), threads, per * threads, ns);
+    gmk_slab_destroy(&slab);
+    gmk_hal_page_free(mem, mem_size);
+}
+
+int main(void) {
+    uint64_t ops = bench_ops(2000000);
+    static const uint32_t threads[] = { 1, 2, 4, 8 };
+    static const uint32_t modes[] = {
+        GMK_SLAB_LOCKED, GMK_SLAB_SPIN, GMK_SLAB_LOCKFREE
+    };
+
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++)
+        for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++)
+            run(modes[m], threads[t], ops);
+    return 0;
+}
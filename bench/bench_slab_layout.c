@@ -0,0 +1,73 @@
+/*
+ * GGMK/cpu — Slab free-list layout: link array vs intrusive links
+ *
+ * One thread churns a large working set in random order on the task slab
+ * and the 32/64-byte block bins, so the free list is scattered and a link
+ * array costs a second cache line per alloc and free.
+ */
+#include "ggmk/alloc.h"
+#include "ggmk/types.h"
+#include "bench_util.h"
+
+#define ARENA_SIZE   (64u << 20)
+#define WORKING_SET  16384
+
+typedef struct {
+    const char *name;
+    int         cls;       /* GMK_MAG_TASK or a block bin size */
+} target_t;
+
+static void *obj_get(gmk_alloc_t *a, int cls) {
+    if (cls == GMK_MAG_TASK) return gmk_slab_alloc(&a->task_slab);
+    return gmk_block_alloc(&a->block, (uint32_t)cls);
+}
+
+static void obj_put(gmk_alloc_t *a, int cls, void *p) {
+    if (cls == GMK_MAG_TASK) gmk_slab_free(&a->task_slab, p);
+    else                     gmk_block_free(&a->block, p, (uint32_t)cls);
+}
+
+static void run(const target_t *t, bool intrusive, uint64_t ops) {
+    static gmk_alloc_t a;
+    static void *live[WORKING_SET];
+
+    if (gmk_alloc_init(&a, ARENA_SIZE) != 0 ||
+        gmk_alloc_set_slab_intrusive(&a, intrusive) != 0) {
+        fprintf(stderr, "alloc init failed\n");
+        exit(1);
+    }
+    for (uint32_t i = 0; i < WORKING_SET; i++)
+        live[i] = obj_get(&a, t->cls);
+
+    /* xorshift picks the slot to recycle */
+    uint32_t x = 2463534242u;
+    uint64_t t0 = bench_now_ns();
+    for (uint64_t i = 0; i < ops; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        uint32_t slot = x % WORKING_SET;
+        if (live[slot]) obj_put(&a, t->cls, live[slot]);
+        live[slot] = obj_get(&a, t->cls);
+        if (live[slot]) *(volatile uint8_t *)live[slot] = 1;
+    }
+    uint64_t ns = bench_now_ns() - t0;
+
+    bench_report(t->name, intrusive ? "intrusive" : "array", 1, ops, ns);
+    gmk_alloc_destroy(&a);
+}
+
+int main(void) {
+    uint64_t ops = bench_ops(5000000);
+    static const target_t targets[] = {
+        { "slab_layout_task", GMK_MAG_TASK },
+        { "slab_layout_b32",  32 },
+        { "slab_layout_b64",  64 },
+    };
+
+    for (size_t i = 0; i < sizeof(targets) / sizeof(targets[0]); i++) {
+        run(&targets[i], false, ops);
+        run(&targets[i], true, ops);
+    }
+    return 0;
+}
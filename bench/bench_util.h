@@ -0,0 +1,84 @@
+/*
+ * GGMK/cpu — Benchmark utilities
+ * Wall-clock timing, a start barrier for thread fan-out, and one logfmt
+ * result line per measurement:
+ *   bench=<name> variant=<v> threads=<n> ops=<n> ns=<n> ops_per_sec=<n>
+ * Allocator benches append fails=<n> (allocations that returned NULL).
+ */
+#ifndef GMK_BENCH_UTIL_H
+#define GMK_BENCH_UTIL_H
+
+#include "ggmk/platform.h"
+#include "ggmk/hal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define BENCH_MAX_THREADS 64
+
+static inline uint64_t bench_now_ns(void) {
+    return gmk_hal_now_ns();
+}
+
+/* Start barrier: threads spin until released so setup cost is excluded. */
+typedef struct {
+    _Atomic(uint32_t) ready;
+    _Atomic(bool)     go;
+} bench_barrier_t;
+
+static inline void bench_barrier_init(bench_barrier_t *b) {
+    atomic_init(&b->ready, 0);
+    atomic_init(&b->go, false);
+}
+
+static inline void bench_barrier_wait(bench_barrier_t *b) {
+    gmk_atomic_add(&b->ready, 1, memory_order_acq_rel);
+    while (!gmk_atomic_load(&b->go, memory_order_acquire)) {
+        /* spin */
+    }
+}
+
+/* Wait until n threads are parked at the barrier, then release them.
+ * Returns the release timestamp. */
+static inline uint64_t bench_barrier_release(bench_barrier_t *b, uint32_t n) {
+    while (gmk_atomic_load(&b->ready, memory_order_acquire) < n) {
+        /* spin */
+    }
+    uint64_t t0 = bench_now_ns();
+    gmk_atomic_store(&b->go, true, memory_order_release);
+    return t0;
+}
+
+static inline void bench_report_line(const char *bench, const char *variant,
+                                     uint32_t threads, uint64_t ops, uint64_t ns) {
+    double secs = (double)ns / 1e9;
+    printf("bench=%s variant=%s threads=%u ops=%llu ns=%llu ops_per_sec=%.0f",
+           bench, variant, threads, (unsigned long long)ops,
+           (unsigned long long)ns, secs > 0 ? (double)ops / secs : 0.0);
+}
+
+static inline void bench_report(const char *bench, const char *variant,
+                                uint32_t threads, uint64_t ops, uint64_t ns) {
+    bench_report_line(bench, variant, threads, ops, ns);
+    printf("\n");
+    fflush(stdout);
+}
+
+static inline void bench_report_fails(const char *bench, const char *variant,
+                                      uint32_t threads, uint64_t ops, uint64_t ns,
+                                      uint64_t fails) {
+    bench_report_line(bench, variant, threads, ops, ns);
+    printf(" fails=%llu\n", (unsigned long long)fails);
+    fflush(stdout);
+}
+
+/* Ops count override: BENCH_OPS=<n> in the environment. */
+static inline uint64_t bench_ops(uint64_t dflt) {
+    const char *s = getenv("BENCH_OPS");
+    if (!s || !*s) return dflt;
+    uint64_t v = strtoull(s, NULL, 10);
+    return v ? v : dflt;
+}
+
+#endif /* GMK_BENCH_UTIL_H */
@@ -5,6 +5,8 @@
 #define GMK_HAL_LINUX_TYPES_H
 
 #include <pthread.h>
+#include <stdint.h>
+#include <stdatomic.h>
 
 typedef struct gmk_hal_thread {
     pthread_t pt;
@@ -15,8 +17,8 @@ typedef struct gmk_hal_lock {
 } gmk_hal_lock_t;
 
 typedef struct gmk_hal_park {
-    pthread_mutex_t m;
-    pthread_cond_t  c;
+    _Atomic(uint32_t) epoch;    /* futex word, bumped by wakes   */
+    _Atomic(uint32_t) waiters;  /* prepared and not yet returned */
 } gmk_hal_park_t;
 
 #endif /* GMK_HAL_LINUX_TYPES_H */
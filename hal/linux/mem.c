@@ -1,23 +1,134 @@
 /*
- * GGMK/cpu — Linux HAL: memory (libc wrappers)
+ * GGMK/cpu — Linux HAL: memory
+ *
+ * Page allocations are anonymous mmaps: already zero, so nothing is
+ * touched up front. Regions of 2 MB and more are 2 MB aligned and either
+ * advised for transparent huge pages or mapped from hugetlbfs, per
+ * gmk_hal_mem_policy. With NUMA on, a thread's node hint (and explicit
+ * gmk_hal_mem_bind calls) set a preferred-node policy through mbind.
  */
 #include "ggmk/hal.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define HUGE_SIZE       (2u << 20)
+#define SMALL_PAGE      4096u
+#define MPOL_PREFERRED  1
+
+static uint32_t huge_policy = GMK_HAL_HUGE_THP;
+static bool     numa_on;
+static uint32_t n_nodes;                    /* 0 = not probed yet */
+static __thread int node_hint = GMK_HAL_NODE_ANY;
+
+/* Mapped length for a request: huge multiples from 2 MB up. Depends on
+ * size only, so page_free unmaps exactly what page_alloc mapped. */
+static size_t map_len(size_t size) {
+    size_t unit = size >= HUGE_SIZE ? HUGE_SIZE : SMALL_PAGE;
+    return (size + unit - 1) & ~(size_t)(unit - 1);
+}
+
+/* Anonymous mapping of len bytes aligned to align (a power of two). */
+static void *map_aligned(size_t len, size_t align) {
+    if (align <= SMALL_PAGE) {
+        void *p = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return p == MAP_FAILED ? NULL : p;
+    }
+
+    /* Over-map, then trim the unaligned head and the tail */
+    uint8_t *p = (uint8_t *)mmap(NULL, len + align, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) return NULL;
+    uintptr_t start = ((uintptr_t)p + align - 1) & ~(uintptr_t)(align - 1);
+    size_t head = start - (uintptr_t)p;
+    if (head) munmap(p, head);
+    munmap((uint8_t *)start + len, align - head);
+    return (void *)start;
+}
+
+void gmk_hal_mem_policy(uint32_t huge, bool numa) {
+    huge_policy = huge;
+    numa_on     = numa;
+}
+
+uint32_t gmk_hal_node_count(void) {
+    if (n_nodes != 0) return n_nodes;
+
+    /* "0" or "0-1" (nodes are numbered densely on the hosts we run) */
+    uint32_t n = 1;
+    FILE *f = fopen("/sys/devices/system/node/online", "r");
+    if (f) {
+        unsigned lo = 0, hi = 0;
+        int got = fscanf(f, "%u-%u", &lo, &hi);
+        if (got == 2 && hi >= lo) n = hi + 1;
+        fclose(f);
+    }
+    n_nodes = n;
+    return n;
+}
+
+int gmk_hal_worker_node(uint32_t worker) {
+    if (!numa_on || worker == UINT32_MAX) return GMK_HAL_NODE_ANY;
+    uint32_t n = gmk_hal_node_count();
+    if (n < 2) return GMK_HAL_NODE_ANY;
+    return (int)(worker % n);
+}
+
+int gmk_hal_mem_node(int node) {
+    int prev = node_hint;
+    node_hint = node;
+    return prev;
+}
+
+void gmk_hal_mem_bind(void *ptr, size_t size, int node) {
+    if (!ptr || node < 0 || node >= 64 || !numa_on) return;
+
+    /* Whole pages inside [ptr, ptr + size) only */
+    uintptr_t start = ((uintptr_t)ptr + SMALL_PAGE - 1) & ~(uintptr_t)(SMALL_PAGE - 1);
+    uintptr_t end   = ((uintptr_t)ptr + size) & ~(uintptr_t)(SMALL_PAGE - 1);
+    if (end <= start) return;
+
+    unsigned long mask = 1ul << node;
+    /* Best effort: a kernel without NUMA simply keeps the default policy */
+    (void)syscall(SYS_mbind, (void *)start, end - start, MPOL_PREFERRED,
+                  &mask, sizeof(mask) * 8 + 1, 0);
+}
 
 void *gmk_hal_page_alloc(size_t size, size_t align) {
-    if (align < sizeof(void *))
-        align = sizeof(void *);
-    /* aligned_alloc requires size to be a multiple of alignment */
-    size = (size + align - 1) & ~(align - 1);
-    void *p = aligned_alloc(align, size);
-    if (p) memset(p, 0, size);
+    if (size == 0) return NULL;
+    size_t len = map_len(size);
+    void *p = NULL;
+
+    if (len >= HUGE_SIZE) {
+        if (align < HUGE_SIZE) align = HUGE_SIZE;
+        if (huge_policy == GMK_HAL_HUGE_TLB) {
+            /* Needs reserved pages (vm.nr_hugepages); fall back quietly */
+            p = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p == MAP_FAILED) p = NULL;
+        }
+        if (!p) {
+            p = map_aligned(len, align);
+            if (p && huge_policy != GMK_HAL_HUGE_OFF)
+                madvise(p, len, MADV_HUGEPAGE);
+        }
+    } else {
+        p = map_aligned(len, align);
+    }
+
+    /* Policy is set before first touch, so pages fault in on the node */
+    if (p && node_hint != GMK_HAL_NODE_ANY)
+        gmk_hal_mem_bind(p, len, node_hint);
     return p;
 }
 
 void gmk_hal_page_free(void *ptr, size_t size) {
-    (void)size;
-    free(ptr);
+    if (!ptr || size == 0) return;
+    munmap(ptr, map_len(size));
 }
 
 void *gmk_hal_calloc(size_t n, size_t size) {
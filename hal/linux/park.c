@@ -1,41 +1,64 @@
 /*
- * GGMK/cpu — Linux HAL: park (condvar with CLOCK_MONOTONIC)
+ * GGMK/cpu — Linux HAL: park (futex eventcount)
+ *
+ * prepare registers a waiter and reads the epoch; commit sleeps in
+ * FUTEX_WAIT only while the epoch still holds that key. wake bumps the
+ * epoch and calls FUTEX_WAKE only when someone is prepared, so waking a
+ * busy thread never enters the kernel.
  */
 #include "ggmk/hal.h"
-#include <pthread.h>
+#include "ggmk/platform.h"
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
 #include <time.h>
+#include <unistd.h>
+
+static long futex(_Atomic(uint32_t) *word, int op, uint32_t val,
+                  const struct timespec *timeout) {
+    return syscall(SYS_futex, (uint32_t *)word, op, val, timeout, NULL, 0);
+}
 
 void gmk_hal_park_init(gmk_hal_park_t *p) {
-    pthread_mutex_init(&p->m, NULL);
+    atomic_init(&p->epoch, 0);
+    atomic_init(&p->waiters, 0);
+}
 
-    pthread_condattr_t attr;
-    pthread_condattr_init(&attr);
-    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
-    pthread_cond_init(&p->c, &attr);
-    pthread_condattr_destroy(&attr);
+uint32_t gmk_hal_park_prepare(gmk_hal_park_t *p) {
+    gmk_atomic_add(&p->waiters, 1, memory_order_seq_cst);
+    /* Order the registration before the caller's re-check */
+    gmk_atomic_fence(memory_order_seq_cst);
+    return gmk_atomic_load(&p->epoch, memory_order_acquire);
 }
 
-void gmk_hal_park_wait(gmk_hal_park_t *p, uint64_t timeout_ns) {
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    ts.tv_nsec += (long)timeout_ns;
-    while (ts.tv_nsec >= 1000000000L) {
-        ts.tv_sec++;
-        ts.tv_nsec -= 1000000000L;
-    }
+void gmk_hal_park_cancel(gmk_hal_park_t *p) {
+    gmk_atomic_sub(&p->waiters, 1, memory_order_release);
+}
 
-    pthread_mutex_lock(&p->m);
-    pthread_cond_timedwait(&p->c, &p->m, &ts);
-    pthread_mutex_unlock(&p->m);
+void gmk_hal_park_commit(gmk_hal_park_t *p, uint32_t key, uint64_t timeout_ns) {
+    if (gmk_atomic_load(&p->epoch, memory_order_acquire) == key) {
+        struct timespec ts, *tp = NULL;
+        if (timeout_ns != GMK_HAL_PARK_FOREVER) {
+            ts.tv_sec  = (time_t)(timeout_ns / 1000000000ull);
+            ts.tv_nsec = (long)(timeout_ns % 1000000000ull);
+            tp = &ts;
+        }
+        /* Returns at once (EAGAIN) if a wake moved the epoch meanwhile */
+        futex(&p->epoch, FUTEX_WAIT_PRIVATE, key, tp);
+    }
+    gmk_atomic_sub(&p->waiters, 1, memory_order_release);
 }
 
 void gmk_hal_park_wake(gmk_hal_park_t *p) {
-    pthread_mutex_lock(&p->m);
-    pthread_cond_signal(&p->c);
-    pthread_mutex_unlock(&p->m);
+    /* Pairs with the fence in prepare: either we see the waiter, or its
+     * re-check sees whatever the caller published before waking */
+    gmk_atomic_fence(memory_order_seq_cst);
+    if (gmk_atomic_load(&p->waiters, memory_order_relaxed) == 0)
+        return;
+    gmk_atomic_add(&p->epoch, 1, memory_order_release);
+    futex(&p->epoch, FUTEX_WAKE_PRIVATE, INT_MAX, NULL);
 }
 
 void gmk_hal_park_destroy(gmk_hal_park_t *p) {
-    pthread_cond_destroy(&p->c);
-    pthread_mutex_destroy(&p->m);
+    (void)p;
 }
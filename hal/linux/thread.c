@@ -3,6 +3,10 @@
  */
 #include "ggmk/hal.h"
 #include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+static __thread uint32_t hal_self_id = UINT32_MAX;
 
 int gmk_hal_thread_create(gmk_hal_thread_t *t, void *(*fn)(void *), void *arg) {
     if (!t) return -1;
@@ -13,3 +17,42 @@ int gmk_hal_thread_join(gmk_hal_thread_t *t) {
     if (!t) return -1;
     return pthread_join(t->pt, NULL) == 0 ? 0 : -1;
 }
+
+/* Pin the calling thread to the CPUs listed for node ("0-3,8-11"). */
+static void pin_to_node(int node) {
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+    FILE *f = fopen(path, "r");
+    if (!f) return;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    unsigned lo, hi;
+    int sep;
+    while (fscanf(f, "%u", &lo) == 1) {
+        hi = lo;
+        sep = fgetc(f);
+        if (sep == '-') {
+            if (fscanf(f, "%u", &hi) != 1) break;
+            sep = fgetc(f);
+        }
+        for (unsigned c = lo; c <= hi && c < CPU_SETSIZE; c++)
+            CPU_SET(c, &set);
+        if (sep != ',') break;
+    }
+    fclose(f);
+
+    if (CPU_COUNT(&set) > 0)
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+void gmk_hal_self_set(uint32_t id) {
+    hal_self_id = id;
+    int node = gmk_hal_worker_node(id);
+    if (node != GMK_HAL_NODE_ANY)
+        pin_to_node(node);
+}
+
+uint32_t gmk_hal_self(void) {
+    return hal_self_id;
+}
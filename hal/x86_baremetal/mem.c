@@ -41,3 +41,26 @@ void *gmk_hal_memset(void *dst, int val, size_t n) {
 void *gmk_hal_memcpy(void *dst, const void *src, size_t n) {
     return memcpy(dst, src, n);
 }
+
+/* One node, and the PMM has no large pages to hand out */
+void gmk_hal_mem_policy(uint32_t huge, bool numa) {
+    (void)huge; (void)numa;
+}
+
+uint32_t gmk_hal_node_count(void) {
+    return 1;
+}
+
+int gmk_hal_worker_node(uint32_t worker) {
+    (void)worker;
+    return GMK_HAL_NODE_ANY;
+}
+
+int gmk_hal_mem_node(int node) {
+    (void)node;
+    return GMK_HAL_NODE_ANY;
+}
+
+void gmk_hal_mem_bind(void *ptr, size_t size, int node) {
+    (void)ptr; (void)size; (void)node;
+}
@@ -8,8 +8,19 @@ void gmk_hal_park_init(gmk_hal_park_t *p) {
     p->cpu_id = 0;
 }
 
-void gmk_hal_park_wait(gmk_hal_park_t *p, uint64_t timeout_ns) {
-    (void)p; (void)timeout_ns;
+/* Nothing to count: a wake IPI that lands before the hlt stays pending
+ * behind cli and ends the hlt at once, and the LAPIC timer bounds it. */
+uint32_t gmk_hal_park_prepare(gmk_hal_park_t *p) {
+    (void)p;
+    return 0;
+}
+
+void gmk_hal_park_cancel(gmk_hal_park_t *p) {
+    (void)p;
+}
+
+void gmk_hal_park_commit(gmk_hal_park_t *p, uint32_t key, uint64_t timeout_ns) {
+    (void)p; (void)key; (void)timeout_ns;
     __asm__ volatile("sti; hlt; cli");
 }
 
@@ -2,6 +2,10 @@
  * GGMK/cpu — x86 bare-metal HAL: thread (no-op, APs pre-started by SMP)
  */
 #include "ggmk/hal.h"
+#include "../../arch/x86_64/lapic.h"
+
+/* Worker id + 1 per LAPIC ID (xAPIC IDs are 8 bits); 0 = unbound */
+static uint32_t self_ids[256];
 
 int gmk_hal_thread_create(gmk_hal_thread_t *t, void *(*fn)(void *), void *arg) {
     (void)t; (void)fn; (void)arg;
@@ -12,3 +16,11 @@ int gmk_hal_thread_join(gmk_hal_thread_t *t) {
     (void)t;
     return 0;
 }
+
+void gmk_hal_self_set(uint32_t id) {
+    self_ids[lapic_id() & 0xFF] = id + 1;
+}
+
+uint32_t gmk_hal_self(void) {
+    return self_ids[lapic_id() & 0xFF] - 1;
+}
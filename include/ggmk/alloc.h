@@ -4,9 +4,13 @@
  * One large aligned_alloc arena at boot, subdivided:
  *   10% task slab, 2% trace slab, 68% block allocator, 20% bump.
  *
- * Slab: index-based free list, mutex-protected.
- * Block: 12 bins (32B to 64KB), each bin is a slab.
+ * Slab: index-based free list; HAL lock, spinlock or lock-free mode.
+ * Block: 45 size classes (32B to 64KB, four per power of two). Each class
+ * owns up to GMK_BLOCK_SEGS slabs carved from a shared page pool. Larger
+ * objects take a whole-page extent from the same pool.
  * Bump: atomic offset, gmk_bump_reset sets offset to 0.
+ * Magazines: per-worker caches in front of every slab, refilled and
+ * flushed in batches so workers rarely touch the slab lock.
  */
 #ifndef GMK_ALLOC_H
 #define GMK_ALLOC_H
@@ -14,6 +18,13 @@
 #include "platform.h"
 #include "lock.h"
 
+/* ── Arena pages ─────────────────────────────────────────────── */
+/* Region and bin boundaries are page-aligned so one byte per page can
+ * name the size class that owns it (see gmk_alloc_t.page_map). */
+#define GMK_ALLOC_PAGE_SHIFT 12
+#define GMK_ALLOC_PAGE       (1u << GMK_ALLOC_PAGE_SHIFT)
+#define GMK_ALLOC_MIN_ARENA  (64u * GMK_ALLOC_PAGE)
+
 /* ── Forward typedefs ────────────────────────────────────────── */
 typedef struct gmk_arena gmk_arena_t;
 typedef struct gmk_alloc gmk_alloc_t;
@@ -28,39 +39,215 @@ int  gmk_arena_init(gmk_arena_t *a, size_t size);
 void gmk_arena_destroy(gmk_arena_t *a);
 
 /* ── Slab allocator: fixed-size objects with free list ───────── */
+/*
+ * Slab modes:
+ *   LOCKED    HAL lock (pthread mutex hosted, ticket spinlock bare metal)
+ *   SPIN      test-and-test-and-set spinlock embedded in the slab
+ *   LOCKFREE  Treiber stack over the free-list indices; free_head packs a
+ *             32-bit ABA tag above the index and moves with one 64-bit CAS.
+ *             high_water is approximate in this mode.
+ * All modes share the same free list, so the mode can be switched while
+ * the slab is quiescent.
+ *
+ * A new slab starts in bump mode: the free list is empty and objects are
+ * handed out in address order from the fresh index. Freed objects go on
+ * the list and are reused first, so init writes nothing into the slab
+ * memory and untouched pages stay uncommitted.
+ *
+ * The free-list links normally live in an index array after the objects.
+ * An intrusive slab keeps each link in the first 4 bytes of the free
+ * object instead: no array (4 bytes more per object) and alloc/free touch
+ * only the object's own cache line. The first word of a freed object is
+ * overwritten.
+ */
+#define GMK_SLAB_LOCKED    1
+#define GMK_SLAB_SPIN      2
+#define GMK_SLAB_LOCKFREE  3
+
+#ifndef GMK_SLAB_DEFAULT_MODE
+#define GMK_SLAB_DEFAULT_MODE GMK_SLAB_LOCKED
+#endif
+
 typedef struct {
     uint8_t        *base;       /* start of slab memory  */
     size_t          total_size; /* total bytes available  */
     uint32_t        obj_size;   /* size of each object   */
     uint32_t        capacity;   /* max objects           */
+    uint32_t        mode;       /* GMK_SLAB_*            */
     _Atomic(uint32_t) alloc_count; /* currently allocated */
-    uint32_t        high_water; /* peak alloc_count      */
-    int32_t        *free_list;  /* free list indices (-1 = end) */
-    int32_t         free_head;  /* index of first free slot */
+    _Atomic(uint32_t) high_water;  /* peak alloc_count    */
+    _Atomic(int32_t) *free_list;   /* free list indices (-1 = end),
+                                      NULL when intrusive          */
+    _Atomic(uint64_t) free_head;   /* tag << 32 | first free index */
+    _Atomic(uint32_t) fresh;       /* first never-allocated index  */
+    _Atomic(bool)     spin;        /* SPIN mode lock word  */
+    bool              intrusive;   /* links live in free objects  */
     gmk_lock_t lock;
 } gmk_slab_t;
 
 int    gmk_slab_init(gmk_slab_t *s, void *mem, size_t mem_size, uint32_t obj_size);
 void   gmk_slab_destroy(gmk_slab_t *s);
+/* Switch locking mode. Only while no other thread uses the slab.
+ * Returns 0 on success, -1 for an unknown mode. */
+int    gmk_slab_set_mode(gmk_slab_t *s, uint32_t mode);
+/* Switch between array and intrusive links. The slab is laid out again, so
+ * this only works before its first allocation (or on a slab without
+ * memory, where it applies to the next attach). Returns 0, or -1 if the
+ * slab was used. */
+int    gmk_slab_set_intrusive(gmk_slab_t *s, bool on);
 void  *gmk_slab_alloc(gmk_slab_t *s);
 void   gmk_slab_free(gmk_slab_t *s, void *ptr);
+/* Batch variants: one lock round-trip for up to n objects.
+ * alloc_n returns the number of objects written to out[]. */
+uint32_t gmk_slab_alloc_n(gmk_slab_t *s, void **out, uint32_t n);
+void     gmk_slab_free_n(gmk_slab_t *s, void *const *ptrs, uint32_t n);
+/* Objects handed out by the slab, including any parked in magazines. */
 uint32_t gmk_slab_used(const gmk_slab_t *s);
+/* Re-point an initialized slab at new memory, keeping its lock and mode.
+ * The slab must have been emptied by gmk_slab_drain first. */
+int    gmk_slab_attach(gmk_slab_t *s, void *mem, size_t mem_size, uint32_t obj_size);
+/* Detach a slab with no object out: empties its free list under the lock
+ * so later allocs fail, and returns 0. Returns -1 if any object is still
+ * allocated or the slab is LOCKFREE (a stalled pop may still read it). */
+int    gmk_slab_drain(gmk_slab_t *s);
 
-/* ── Block allocator: power-of-two bins ──────────────────────── */
-#define GMK_BLOCK_BINS     12   /* 32, 64, 128, ..., 65536 */
+/* ── Block allocator: size classes ───────────────────────────── */
+/*
+ * jemalloc-style spacing: 32, then four evenly spaced classes per power
+ * of two up to 64 KB (40, 48, 56, 64, 80, 96, 112, 128, 160, ...), so
+ * rounding wastes at most 20% of an object instead of up to 50%.
+ * Class i > 0 sits in group g = (i-1)/4 with spacing 8 << g.
+ */
+#define GMK_BLOCK_BINS     45
 #define GMK_BLOCK_MIN_SIZE 32
 #define GMK_BLOCK_MAX_SIZE 65536
+#define GMK_BLOCK_CLASS_SIZE(i)                                          \
+    ((i) == 0 ? (uint32_t)GMK_BLOCK_MIN_SIZE                             \
+              : (32u << (((i) - 1) / 4)) +                               \
+                ((((i) - 1) % 4) + 1) * (8u << (((i) - 1) / 4)))
 
+/*
+ * Segments and the page pool: the region starts with a small page table
+ * (segment id + 1 per page, 0 = pool). Each class gets a home segment
+ * sized by its weight; GMK_BLOCK_RESERVE_PCT of the region stays in the
+ * pool. A class that runs dry grows a new segment from the pool, and if
+ * the pool is dry too it spills into the next GMK_BLOCK_SPILL larger
+ * classes. gmk_block_rebalance returns fully free segments of idle
+ * classes to the pool and pre-grows classes whose demand outran their
+ * free objects.
+ *
+ * Large objects (above GMK_BLOCK_MAX_SIZE) are extents of whole pages
+ * taken first-fit from the pool and returned to it on free. Neighbouring
+ * free pages need no merge step: the page table already shows them as
+ * one run, so free costs one write per page of the extent.
+ */
+#define GMK_BLOCK_SEGS         8    /* slabs per class, slot 0 = home */
+#define GMK_BLOCK_SEG_MIN      (16u * GMK_ALLOC_PAGE)
+#define GMK_BLOCK_SPILL        4    /* larger classes tried when dry  */
+#define GMK_BLOCK_RESERVE_PCT  50   /* region held back for growth    */
+
+/* Lifetime request accounting per class, for fragmentation stats */
+typedef struct {
+    _Atomic(uint64_t) allocs;     /* objects handed out               */
+    _Atomic(uint64_t) req_bytes;  /* bytes the callers asked for      */
+    _Atomic(uint64_t) spills;     /* requests served by a larger class */
+    _Atomic(uint64_t) grows;      /* segments taken from the pool     */
+} gmk_block_acct_t;
+
+/* Large-extent accounting */
 typedef struct {
-    gmk_slab_t bins[GMK_BLOCK_BINS];
-    uint8_t   *base;
-    size_t     total_size;
+    _Atomic(uint64_t) allocs;
+    _Atomic(uint64_t) req_bytes;
+    _Atomic(uint64_t) served_bytes; /* whole pages handed out          */
+    _Atomic(uint64_t) fails;
+    _Atomic(uint32_t) live;         /* extents currently allocated     */
+    _Atomic(uint32_t) pages;        /* pages in live extents           */
+    _Atomic(uint32_t) peak_pages;
+} gmk_block_large_t;
+
+typedef struct {
+    gmk_slab_t       bins[GMK_BLOCK_BINS];   /* home segment per class */
+    gmk_slab_t       segs[GMK_BLOCK_BINS][GMK_BLOCK_SEGS - 1];
+    _Atomic(uint32_t) seg_mask[GMK_BLOCK_BINS]; /* live slots, bit 0 = home */
+    gmk_block_acct_t acct[GMK_BLOCK_BINS];
+    gmk_block_large_t large;
+    uint64_t         rb_allocs[GMK_BLOCK_BINS]; /* allocs at last rebalance */
+    uint16_t        *page_seg;     /* per page: bin * SEGS + slot + 1,
+                                      or a large-extent marker       */
+    uint32_t         n_pages;
+    _Atomic(uint32_t) pool_pages;  /* free pages in the pool        */
+    gmk_lock_t       pool_lock;    /* page table and segment changes */
+    uint8_t         *base;
+    size_t           total_size;
 } gmk_block_t;
 
+typedef struct {
+    uint32_t obj_size;
+    uint32_t capacity;    /* objects across live segments        */
+    uint32_t used;
+    uint32_t high_water;  /* sum of per-segment peaks            */
+    uint32_t segs;        /* live segments                       */
+    uint32_t pages;       /* pages backing the live segments     */
+    uint64_t allocs;
+    uint64_t req_bytes;
+    uint64_t spills;
+    uint64_t grows;
+    uint64_t fails;       /* requests for this class that got NULL
+                             (filled by gmk_alloc_stats)           */
+    /* Internal fragmentation over all allocations so far:
+     * 1000 * (1 - req_bytes / (allocs * obj_size)), 0 with no allocs. */
+    uint32_t frag_permille;
+} gmk_block_stats_t;
+
 int    gmk_block_init(gmk_block_t *b, void *mem, size_t mem_size);
+/* Like gmk_block_init, but every page starts in the pool (no homes). */
+int    gmk_block_init_pooled(gmk_block_t *b, void *mem, size_t mem_size);
 void   gmk_block_destroy(gmk_block_t *b);
+/* Detach the memory of a block with nothing allocated: every segment goes
+ * back to the pool and the block then shows zero pages, so concurrent
+ * callers fail cleanly. Returns 0 when the memory may be freed, -1 if
+ * anything is still out. Locks stay valid; gmk_block_reattach revives it
+ * with new memory, all pooled. */
+int    gmk_block_retire(gmk_block_t *b);
+int    gmk_block_reattach(gmk_block_t *b, void *mem, size_t mem_size);
+/* Objects (including magazine-held ones) and large extents out. */
+uint32_t gmk_block_live(const gmk_block_t *b);
 void  *gmk_block_alloc(gmk_block_t *b, uint32_t size);
+/* Free ptr to the segment owning its page, or release its large extent.
+ * size is not needed and is only kept for source compatibility. */
 void   gmk_block_free(gmk_block_t *b, void *ptr, uint32_t size);
+/* Page-aligned extent of at least size bytes (any size), or NULL. */
+void  *gmk_block_large_alloc(gmk_block_t *b, size_t size);
+void   gmk_block_large_free(gmk_block_t *b, void *ptr);
+/* Bytes in the large extent starting at ptr, or 0 if ptr starts none. */
+size_t gmk_block_large_size(const gmk_block_t *b, const void *ptr);
+/* Large extents as one pseudo-bin: obj_size 0, capacity = free pool
+ * pages, used = live extents, pages = live pages, high_water = peak
+ * pages, fails = failed allocations. Extents have no segments and never
+ * spill, so segs, spills and grows stay 0. */
+void   gmk_block_large_stats(const gmk_block_t *b, gmk_block_stats_t *out);
+/* Batch variants for magazines. alloc_n grows or spills like
+ * gmk_block_alloc and does no accounting; free_n takes any mix of bins. */
+uint32_t gmk_block_alloc_n(gmk_block_t *b, int bin, void **out, uint32_t n);
+void     gmk_block_free_n(gmk_block_t *b, void *const *ptrs, uint32_t n);
+/* Bin serving size bytes, or -1 if size is out of range. */
+int    gmk_block_bin(uint32_t size);
+/* Object size of bin, or 0 if bin is out of range. */
+uint32_t gmk_block_bin_size(int bin);
+/* Bin of the segment owning ptr, or -1 if ptr is not in a live segment. */
+int    gmk_block_ptr_bin(const gmk_block_t *b, const void *ptr);
+/* Record an allocation of size bytes returned as ptr. */
+void   gmk_block_account(gmk_block_t *b, const void *ptr, uint32_t size);
+/* Snapshot one bin. Returns 0, or -1 if bin is out of range. */
+int    gmk_block_stats(const gmk_block_t *b, int bin, gmk_block_stats_t *out);
+/* Move pages between classes by demand since the last call. Safe while
+ * other threads allocate and free. Returns the number of pages moved. */
+uint32_t gmk_block_rebalance(gmk_block_t *b);
+/* Switch every segment slab to mode. Quiescent only. */
+int    gmk_block_set_mode(gmk_block_t *b, uint32_t mode);
+/* Intrusive links for every segment, present and future (see
+ * gmk_slab_set_intrusive). Before the first allocation only. */
+int    gmk_block_set_intrusive(gmk_block_t *b, bool on);
 
 /* ── Bump allocator: atomic offset ───────────────────────────── */
 typedef struct {
@@ -75,10 +262,51 @@ void  *gmk_bump_alloc(gmk_bump_t *b, uint32_t size);
 void   gmk_bump_reset(gmk_bump_t *b);
 uint32_t gmk_bump_used(const gmk_bump_t *b);
 
+/* ── Worker bump slices, reclaimed by tick epoch ─────────────── */
+/*
+ * Each worker owns a slice of the bump region and bumps it without
+ * atomics. A worker publishes the tick its batch started in
+ * (gmk_epoch_enter) and clears it when the batch is done. On every tick,
+ * gmk_epoch_advance raises `safe` to the oldest tick still running. A
+ * worker rewinds its slice on its first allocation in a new tick if all
+ * of it is older than safe. Every task that could have seen that memory
+ * has then finished. Scratch must not be handed to tasks that start
+ * later.
+ */
+#define GMK_EPOCH_IDLE  UINT64_MAX
+
+typedef struct {
+    _Atomic(uint64_t) *active;    /* per worker: batch start tick or IDLE */
+    uint32_t           n_workers;
+    _Atomic(uint64_t)  safe;      /* every batch started before it is done */
+} gmk_epoch_t;
+
+typedef struct {
+    uint8_t  *base;
+    uint32_t  size;
+    uint32_t  offset;
+    uint32_t  high_water;
+    uint64_t  tick;               /* tick of the newest allocation */
+    uint64_t  resets;
+    uint64_t  fails;
+} gmk_bump_local_t;
+
+int      gmk_epoch_init(gmk_epoch_t *e, uint32_t n_workers);
+void     gmk_epoch_destroy(gmk_epoch_t *e);
+/* Publish worker as running a batch from the current *tick. Returns the
+ * tick entered, re-read so gmk_epoch_advance never misses it. */
+uint64_t gmk_epoch_enter(gmk_epoch_t *e, uint32_t worker, _Atomic(uint64_t) *tick);
+void     gmk_epoch_exit(gmk_epoch_t *e, uint32_t worker);
+/* Recompute safe after the tick moved to tick. Returns the new value. */
+uint64_t gmk_epoch_advance(gmk_epoch_t *e, uint64_t tick);
+/* Owner-only bump at tick; rewinds first if everything is older than safe. */
+void    *gmk_bump_local_alloc(gmk_bump_local_t *b, uint64_t tick, uint64_t safe,
+                              uint32_t size);
+
 /* ── Payload refcount header (hidden before payload data) ────── */
 typedef struct {
     _Atomic(uint32_t) refcount;
-    uint32_t          size;     /* payload data size (excl. header) */
+    uint32_t          _pad;     /* keeps payload data 8-byte aligned */
 } gmk_payload_hdr_t;
 
 /* Allocate a refcounted payload (refcount=1). Returns pointer past header. */
@@ -88,22 +316,177 @@ void   gmk_payload_retain(void *payload);
 /* Decrement refcount. Frees when it reaches 0. Returns 1 if freed, 0 if still live. */
 int    gmk_payload_release(gmk_alloc_t *a, void *payload);
 
+/* ── Per-worker magazines ────────────────────────────────────── */
+/*
+ * One magazine per worker per slab (task, trace, each block bin). Only
+ * the owning worker touches it. An empty magazine refills with
+ * GMK_ALLOC_MAG_BATCH objects under one slab lock; a full one flushes its
+ * older half the same way. Objects freed on a worker other than the one
+ * that allocated them simply land in the freeing worker's magazine and
+ * reach the shared slab on its next flush. Threads without a worker id
+ * (gmk_hal_self() == UINT32_MAX) go straight to the slab.
+ */
+#define GMK_ALLOC_MAG_SIZE   32
+#define GMK_ALLOC_MAG_BATCH  (GMK_ALLOC_MAG_SIZE / 2)
+#define GMK_MAG_TASK         0
+#define GMK_MAG_TRACE        1
+#define GMK_MAG_BLOCK        2   /* + block bin index */
+#define GMK_ALLOC_N_MAGS     (GMK_MAG_BLOCK + GMK_BLOCK_BINS)
+#define GMK_ALLOC_CLASS_LARGE GMK_ALLOC_N_MAGS  /* gmk_alloc_class: extent */
+#define GMK_ALLOC_N_CLASSES  (GMK_ALLOC_CLASS_LARGE + 1)
+
+typedef struct {
+    uint32_t count;
+    void    *objs[GMK_ALLOC_MAG_SIZE];
+} gmk_mag_t;
+
+typedef struct {
+    gmk_mag_t mags[GMK_ALLOC_N_MAGS];
+    gmk_bump_local_t bump;        /* this worker's bump slice */
+} gmk_alloc_cache_t;
+
+/* ── Elastic chunks ──────────────────────────────────────────── */
+/*
+ * With gmk_alloc_set_elastic, block-class and large allocations that find
+ * the arena dry take a new chunk from gmk_hal_page_alloc. Each chunk is a
+ * block allocator whose pages all start in its pool, so any class can
+ * grow into it. Chunks are added up to max_size (arena included). A chunk
+ * that stays empty for GMK_ALLOC_CHUNK_IDLE_PASSES rebalance passes goes
+ * back to the HAL. Its descriptor is kept and reused, so a caller racing
+ * with the release only ever sees an empty block.
+ */
+#define GMK_ALLOC_MAX_CHUNKS         32
+#define GMK_ALLOC_CHUNK_DEFAULT      (16u << 20)
+#define GMK_ALLOC_CHUNK_IDLE_PASSES  16
+
+/* ── Snapshot ────────────────────────────────────────────────── */
+/*
+ * cls[] is indexed by class (GMK_MAG_TASK, GMK_MAG_TRACE, GMK_MAG_BLOCK +
+ * bin, GMK_ALLOC_CLASS_LARGE). Block classes and extents add up the arena
+ * and every chunk; the slab classes report one segment. Objects parked in
+ * worker magazines count as used. Fields are read without locks, so a
+ * snapshot taken under load is approximate.
+ */
+typedef struct {
+    gmk_block_stats_t cls[GMK_ALLOC_N_CLASSES];
+    uint64_t reserved_bytes;  /* arena + chunks                      */
+    uint64_t used_bytes;      /* objects and extents handed out      */
+    uint32_t bump_used;       /* shared bump region                  */
+    uint32_t bump_size;
+    uint32_t chunks;          /* live chunks                         */
+    uint64_t chunk_grows;
+    uint64_t chunk_releases;
+    uint64_t alloc_bytes;
+    uint64_t alloc_fails;
+    uint32_t frag_permille;   /* internal, over every class          */
+    uint16_t tenant;
+} gmk_alloc_stats_t;
+
+/* Tenant of an allocator shared by tenants without their own: its
+ * metrics only move the global counters. */
+#define GMK_ALLOC_SHARED  0xFFFFu
+
 /* ── Unified allocator ───────────────────────────────────────── */
 struct gmk_alloc {
     gmk_arena_t  arena;
     gmk_slab_t   task_slab;    /* for gmk_task_t-sized objects */
     gmk_slab_t   trace_slab;   /* for trace events             */
     gmk_block_t  block;        /* variable-size allocations    */
-    gmk_bump_t   bump;         /* transient per-tick           */
+    gmk_bump_t   bump;         /* transient, for unbound callers */
+    gmk_alloc_cache_t **caches; /* per-worker magazines, each on the
+                                   worker's node, or NULL          */
+    uint32_t     n_caches;
+    uint8_t     *page_map;     /* per arena page: GMK_MAG_* + 1, 0 = none;
+                                  block pages resolve via block.page_seg */
+    size_t       n_pages;
+    uint32_t     slab_mode;    /* applied to new chunks         */
+    bool         slab_intrusive;
+
+    /* Elastic chunks; descriptors live from first use until destroy */
+    gmk_block_t *chunks[GMK_ALLOC_MAX_CHUNKS];
+    _Atomic(uintptr_t) chunk_base[GMK_ALLOC_MAX_CHUNKS]; /* 0 = no memory */
+    _Atomic(uintptr_t) chunk_end[GMK_ALLOC_MAX_CHUNKS];
+    uint32_t     chunk_idle[GMK_ALLOC_MAX_CHUNKS]; /* empty passes in a row */
+    size_t       chunk_size;   /* 0 = fixed arena               */
+    size_t       max_size;     /* arena + chunks ceiling        */
+    gmk_lock_t   chunk_lock;
+    _Atomic(uint64_t) chunk_bytes;    /* memory held in chunks  */
+    _Atomic(uint64_t) chunk_grows;
+    _Atomic(uint64_t) chunk_releases;
+
+    /* Allocators sharing pointers (kernel + tenant arenas) form a ring;
+     * frees of a peer's pointer are forwarded to it. NULL = alone. */
+    gmk_alloc_t *peer;
+    struct gmk_metrics *metrics;  /* per-tenant counters, or NULL  */
+    uint16_t     tenant;
+    gmk_epoch_t *epoch;        /* enables per-worker bump slices */
+
     _Atomic(uint64_t) total_alloc_bytes;
     _Atomic(uint64_t) total_alloc_fails;
+    _Atomic(uint64_t) class_fails[GMK_ALLOC_N_CLASSES];
+    uint64_t     pub_used;     /* gauges as of the last publish  */
+    uint64_t     pub_reserved;
 };
 
+/* arena_size must be at least GMK_ALLOC_MIN_ARENA. */
 int    gmk_alloc_init(gmk_alloc_t *a, size_t arena_size);
 void   gmk_alloc_destroy(gmk_alloc_t *a);
+/* Sizes above GMK_BLOCK_MAX_SIZE get a large extent from the block pool. */
 void  *gmk_alloc(gmk_alloc_t *a, uint32_t size);
-void   gmk_free(gmk_alloc_t *a, void *ptr, uint32_t size);
+/* Free ptr from gmk_alloc. The owning size class comes from the page map;
+ * bump pointers and foreign pointers are ignored. */
+void   gmk_free(gmk_alloc_t *a, void *ptr);
+/* Size class (GMK_MAG_*) owning ptr, GMK_ALLOC_CLASS_LARGE for a large
+ * extent, or -1 for bump/foreign pointers. */
+int    gmk_alloc_class(const gmk_alloc_t *a, const void *ptr);
+/* Object size of the class owning ptr (extent size if large), or 0. */
+size_t gmk_alloc_usable_size(const gmk_alloc_t *a, const void *ptr);
+/* Transient bytes: from the caller's worker slice while it runs a batch
+ * under an epoch, else from the shared region. */
 void  *gmk_bump(gmk_alloc_t *a, uint32_t size);
+/* Switch every slab (task, trace, block bins) to mode. Quiescent only. */
+int    gmk_alloc_set_slab_mode(gmk_alloc_t *a, uint32_t mode);
+/* Intrusive free lists in every slab, chunks included. Right after init
+ * only; returns -1 once anything was allocated. */
+int    gmk_alloc_set_slab_intrusive(gmk_alloc_t *a, bool on);
+/* Rebalance block pages by demand (see gmk_block_rebalance) in the arena
+ * and every chunk, and release chunks that stayed empty. */
+uint32_t gmk_alloc_rebalance(gmk_alloc_t *a);
+/* Let the allocator grow by chunk_size chunks up to max_size bytes in
+ * total (arena included). Returns 0, or -1 if the sizes are invalid. */
+int    gmk_alloc_set_elastic(gmk_alloc_t *a, size_t chunk_size, size_t max_size);
+/* Add peer to a's ring: either may then free the other's pointers. */
+void   gmk_alloc_link(gmk_alloc_t *a, gmk_alloc_t *peer);
+/* Count ALLOC_BYTES, ALLOC_FAILS and ALLOC_GROWS against tenant in m. */
+void   gmk_alloc_set_metrics(gmk_alloc_t *a, struct gmk_metrics *m, uint16_t tenant);
+/* Fill out with a snapshot of a. Returns 0, or -1 on bad arguments. */
+int    gmk_alloc_stats(const gmk_alloc_t *a, gmk_alloc_stats_t *out);
+/* Move the ALLOC_IN_USE and ALLOC_RESERVED gauges of a's metrics to the
+ * current snapshot. Not reentrant per allocator (worker 0 calls it). */
+void   gmk_alloc_publish(gmk_alloc_t *a);
+/* Serve gmk_bump from worker slices reclaimed through e (see gmk_epoch_t). */
+void   gmk_alloc_set_epoch(gmk_alloc_t *a, gmk_epoch_t *e);
+/* Block allocator (arena or chunk) whose region holds ptr, or NULL. */
+gmk_block_t *gmk_alloc_block_of(const gmk_alloc_t *a, const void *ptr);
+/* Block-class objects from the arena or any chunk, adding a chunk when
+ * all are dry; and their batch free. Back the block magazines. */
+uint32_t gmk_alloc_block_alloc_n(gmk_alloc_t *a, int bin, void **out, uint32_t n);
+void     gmk_alloc_block_free_n(gmk_alloc_t *a, void *const *ptrs, uint32_t n);
+
+/* Allocate magazines for worker ids [0, n_workers), and give each worker
+ * an equal slice of the bump region; unbound callers keep one more.
+ * Magazines and slices prefer gmk_hal_worker_node of their worker.
+ * Call before anything is bumped. Returns 0 on success. */
+int    gmk_alloc_cache_init(gmk_alloc_t *a, uint32_t n_workers);
+/* Free the magazines (objects still cached stay out). */
+void   gmk_alloc_cache_destroy(gmk_alloc_t *a);
+/* Return every object cached by worker_id to its slab. Owner only. */
+void   gmk_alloc_cache_flush(gmk_alloc_t *a, uint32_t worker_id);
+/* Take/return one object of magazine mag (GMK_MAG_*) for the caller. */
+void  *gmk_alloc_cache_get(gmk_alloc_t *a, uint32_t mag);
+void   gmk_alloc_cache_put(gmk_alloc_t *a, uint32_t mag, void *ptr);
+/* Rewind the shared bump region. Only safe when nobody holds a pointer
+ * into it; worker slices rewind themselves by epoch. */
 void   gmk_bump_reset_all(gmk_alloc_t *a);
 
 #endif /* GMK_ALLOC_H */
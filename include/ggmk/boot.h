@@ -18,10 +18,37 @@
 #include "worker.h"
 
 /* ── Boot configuration ──────────────────────────────────────── */
+/* Tenant memory quota. soft bytes are the tenant's own arena, always
+ * available; the tenant may grow in chunks past it up to hard bytes, and
+ * allocations fail there. soft = 0 shares the kernel allocator. */
+typedef struct {
+    size_t      soft;
+    size_t      hard;         /* <= soft = fixed at soft          */
+} gmk_tenant_quota_t;
+
 typedef struct {
     size_t      arena_size;   /* total arena bytes (default 64MB) */
     uint32_t    n_workers;    /* worker thread count (default 4)  */
     uint32_t    n_tenants;    /* tenant count (default 1)         */
+    uint32_t    batch_size;   /* tasks per worker gather (default
+                                 GMK_WORKER_BATCH_SIZE, max
+                                 GMK_WORKER_BATCH_MAX)            */
+    uint32_t    slab_mode;    /* GMK_SLAB_* (0 = build default)   */
+    bool        slab_intrusive; /* free-list links in the objects */
+    size_t      arena_max;    /* grow in chunks up to this many
+                                 bytes (0 = fixed arena)          */
+    size_t      chunk_size;   /* chunk bytes (default
+                                 GMK_ALLOC_CHUNK_DEFAULT)         */
+    gmk_tenant_quota_t tenant_quota[GMK_MAX_TENANTS];
+    uint32_t    huge_pages;   /* GMK_HAL_HUGE_* (0 = THP advice)  */
+    bool        numa;         /* pin workers and their queues and
+                                 caches round-robin to nodes      */
+    uint64_t    tick_ns;      /* timer thread advances the tick
+                                 this often (0 = manual
+                                 gmk_tick_advance only)           */
+    uint64_t    park_spin_ns; /* idle workers spin this long before
+                                 parking (0 = GMK_PARK_SPIN_NS,
+                                 GMK_PARK_SPIN_OFF = no spin)     */
 } gmk_boot_cfg_t;
 
 #define GMK_DEFAULT_ARENA_SIZE  (64ULL * 1024 * 1024)
@@ -31,6 +58,8 @@ typedef struct {
 /* ── Kernel state ────────────────────────────────────────────── */
 struct gmk_kernel {
     gmk_alloc_t       alloc;
+    gmk_alloc_t      *tenant_alloc[GMK_MAX_TENANTS]; /* NULL = shares alloc */
+    gmk_epoch_t       epoch;      /* reclaims worker bump slices     */
     gmk_trace_t       trace;
     gmk_metrics_t     metrics;
     gmk_sched_t       sched;
@@ -39,7 +68,11 @@ struct gmk_kernel {
     gmk_worker_pool_t pool;
     gmk_boot_cfg_t    cfg;
     _Atomic(bool)      running;
-    _Atomic(uint32_t)  tick;
+    _Atomic(uint64_t)  tick;
+    uint64_t           tick_base_ns; /* gmk_hal_now_ns() at tick 0      */
+    gmk_hal_thread_t   ticker;       /* runs when cfg.tick_ns != 0     */
+    gmk_hal_park_t     ticker_park;
+    _Atomic(bool)      ticker_run;
 };
 
 /* Boot the kernel. modules_arr is an array of modules to register.
@@ -53,7 +86,36 @@ void gmk_halt(gmk_kernel_t *k);
 /* Submit a task to the kernel (from external code). */
 int  gmk_submit(gmk_kernel_t *k, gmk_task_t *task);
 
-/* Advance the kernel tick (for simulation/event-driven mode). */
+/* Submit a task to a specific worker's inbox and wake it. Falls back to
+   the RQ if the inbox is full. */
+int  gmk_submit_to(gmk_kernel_t *k, gmk_task_t *task, uint32_t worker_id);
+
+/* Allocator serving tenant: its own arena when it has a quota, else the
+   kernel allocator. */
+gmk_alloc_t *gmk_tenant_alloc(gmk_kernel_t *k, uint16_t tenant);
+
+/* Advance the kernel tick (for simulation/event-driven mode). Also moves
+   the bump epoch, so worker slices whose batches all finished rewind,
+   and wakes workers whose timers came due. */
 void gmk_tick_advance(gmk_kernel_t *k);
 
+/* Advance the tick to tick in one step (no-op if it is already there).
+   The timer thread uses this to catch up after oversleeping. */
+void gmk_tick_advance_to(gmk_kernel_t *k, uint64_t tick);
+
+/* Run task (meta0 is overwritten with tick) once the kernel tick reaches
+   tick, on worker_id (or any worker if < 0). handle (may be NULL) is for
+   gmk_timer_cancel. */
+int  gmk_submit_at(gmk_kernel_t *k, gmk_task_t *task, uint64_t tick,
+                   int worker_id, gmk_evq_handle_t *handle);
+
+/* Deadline in gmk_hal_now_ns() time: runs on the first tick that starts
+   at or after deadline_ns. Needs the timer thread (cfg.tick_ns); returns
+   GMK_ERR_INVALID without it. */
+int  gmk_submit_at_ns(gmk_kernel_t *k, gmk_task_t *task, uint64_t deadline_ns,
+                      int worker_id, gmk_evq_handle_t *handle);
+
+/* Cancel a pending timer. Returns -1 if it already fired. */
+int  gmk_timer_cancel(gmk_kernel_t *k, gmk_evq_handle_t handle);
+
 #endif /* GMK_BOOT_H */
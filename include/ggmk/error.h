@@ -81,13 +81,29 @@
 /* ── Queue defaults ──────────────────────────────────────────── */
 #define GMK_RQ_DEFAULT_CAP     4096
 #define GMK_LQ_DEFAULT_CAP     1024
-#define GMK_EVQ_DEFAULT_CAP    (64 * 1024)
+#define GMK_EVQ_DEFAULT_CAP    (64 * 1024)  /* split across worker shards */
+#define GMK_EVQ_SHARD_MIN_CAP  4096
+#define GMK_DET_DEFAULT_CAP    8192         /* deterministic lane entries */
 #define GMK_CHAN_DEFAULT_SLOTS  1024
 
 /* ── Yield / scheduling ──────────────────────────────────────── */
 #define GMK_LQ_YIELD_RESERVE_PCT  25   /* 25% of LQ reserved for yields */
 #define GMK_DEFAULT_MAX_YIELDS    16
 #define GMK_OVERFLOW_CAP          4096
+#define GMK_LQ_INBOX_POLL         32   /* owner splices inbox every N LQ pops */
+
+/* ── Worker batching ─────────────────────────────────────────── */
+#define GMK_WORKER_BATCH_SIZE     32   /* default tasks per gather      */
+#define GMK_WORKER_BATCH_MAX      256  /* per-worker batch buffer size  */
+#define GMK_BATCH_HIST_BUCKETS    9    /* batch sizes 1,2,..,256 (pow2) */
+
+/* ── Idle parking ────────────────────────────────────────────── */
+#define GMK_PARK_SPIN_NS          20000ull      /* idle spin before parking   */
+#define GMK_PARK_SPIN_OFF         UINT64_MAX    /* cfg value: park at once    */
+#define GMK_PARK_TIMEOUT_NS       100000000ull  /* parked worker's safety net */
+
+/* ── Work stealing ───────────────────────────────────────────── */
+#define GMK_STEAL_WAKE_MIN        4    /* LQ backlog that wakes a parked sibling */
 
 /* ── Priority pop weights ────────────────────────────────────── */
 #define GMK_WEIGHT_P0  8
@@ -95,11 +111,18 @@
 #define GMK_WEIGHT_P2  2
 #define GMK_WEIGHT_P3  1
 
+/* ── Allocator ───────────────────────────────────────────────── */
+#define GMK_ALLOC_REBALANCE_NS 10000000ull /* idle worker 0 rebalances block pages */
+
 /* ── EVQ ─────────────────────────────────────────────────────── */
 #define GMK_EVQ_DRAIN_LIMIT    256
+#define GMK_EVQ_LEVELS         8    /* x 8 bits covers a 64-bit tick */
+#define GMK_EVQ_SLOT_BITS      8
+#define GMK_EVQ_SLOTS          (1u << GMK_EVQ_SLOT_BITS)
 
 /* ── Channel backpressure ────────────────────────────────────── */
 #define GMK_CHAN_PRIORITY_RESERVE_PCT  10  /* last 10% for P0 only */
+#define GMK_CHAN_DRAIN_CHUNK           32  /* tasks claimed per drain CAS */
 
 /* ── Poison detection ────────────────────────────────────────── */
 #define GMK_POISON_THRESHOLD   16  /* simple threshold for v0.1 */
@@ -127,6 +150,7 @@
 #define GMK_EV_WATCHDOG        0x0020
 #define GMK_EV_WORKER_PARK     0x0021
 #define GMK_EV_WORKER_WAKE     0x0022
+#define GMK_EV_WORKER_STEAL    0x0023
 #define GMK_EV_YIELD_OVERFLOW  0x0030
 #define GMK_EV_YIELD_LIMIT     0x0031
 #define GMK_EV_POISON          0x0032
@@ -147,7 +171,11 @@
 #define GMK_METRIC_CHAN_FULL_COUNT   10
 #define GMK_METRIC_WORKER_PARKS     11
 #define GMK_METRIC_WORKER_WAKES     12
-#define GMK_METRIC_COUNT             16  /* total metric slots */
+#define GMK_METRIC_TASKS_STOLEN     13
+#define GMK_METRIC_ALLOC_GROWS      14  /* chunks past a tenant's soft quota */
+#define GMK_METRIC_ALLOC_IN_USE     15  /* gauge: bytes handed out          */
+#define GMK_METRIC_ALLOC_RESERVED   16  /* gauge: arena + chunk bytes       */
+#define GMK_METRIC_COUNT             20  /* total metric slots */
 
 /* ── Version macro ───────────────────────────────────────────── */
 #define GMK_VERSION(major, minor, patch) \
@@ -10,6 +10,7 @@
 #include "error.h"
 #include "types.h"
 #include "ring_spsc.h"
+#include "ring_spmc.h"
 #include "ring_mpmc.h"
 #include "alloc.h"
 #include "trace.h"
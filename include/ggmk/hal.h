@@ -22,6 +22,14 @@
 int  gmk_hal_thread_create(gmk_hal_thread_t *t, void *(*fn)(void *), void *arg);
 int  gmk_hal_thread_join(gmk_hal_thread_t *t);
 
+/* ── Identity ────────────────────────────────────────────────── */
+/* Bind the calling thread (hosted) or CPU (bare metal) to a worker id.
+ * gmk_hal_self returns it, or UINT32_MAX if the caller never bound one.
+ * With NUMA placement on, a hosted thread is also pinned to the CPUs of
+ * gmk_hal_worker_node(id). */
+void     gmk_hal_self_set(uint32_t id);
+uint32_t gmk_hal_self(void);
+
 /* ── Lock ────────────────────────────────────────────────────── */
 void gmk_hal_lock_init(gmk_hal_lock_t *l);
 void gmk_hal_lock_acquire(gmk_hal_lock_t *l);
@@ -29,15 +37,27 @@ void gmk_hal_lock_release(gmk_hal_lock_t *l);
 void gmk_hal_lock_destroy(gmk_hal_lock_t *l);
 
 /* ── Park (thread sleep/wake) ────────────────────────────────── */
-void gmk_hal_park_init(gmk_hal_park_t *p);
-void gmk_hal_park_wait(gmk_hal_park_t *p, uint64_t timeout_ns);
-void gmk_hal_park_wake(gmk_hal_park_t *p);
-void gmk_hal_park_destroy(gmk_hal_park_t *p);
+/* An eventcount. A waiter takes a key with prepare, re-checks whatever it
+ * is waiting for, then either sleeps with commit or backs out with
+ * cancel. commit returns at once if a wake came after prepare, so a wake
+ * racing the re-check is never lost. wake is a fence and a load when
+ * nobody is prepared, so a sleeper must always prepare before its final
+ * check of the condition it waits on. Timeouts bound the sleep; GMK_HAL_PARK_FOREVER waits for a
+ * wake only. Commits can return early (signals, bare-metal interrupts). */
+#define GMK_HAL_PARK_FOREVER UINT64_MAX
+
+void     gmk_hal_park_init(gmk_hal_park_t *p);
+uint32_t gmk_hal_park_prepare(gmk_hal_park_t *p);
+void     gmk_hal_park_cancel(gmk_hal_park_t *p);
+void     gmk_hal_park_commit(gmk_hal_park_t *p, uint32_t key, uint64_t timeout_ns);
+void     gmk_hal_park_wake(gmk_hal_park_t *p);
+void     gmk_hal_park_destroy(gmk_hal_park_t *p);
 
 /* ── Time ────────────────────────────────────────────────────── */
 uint64_t gmk_hal_now_ns(void);
 
 /* ── Memory ──────────────────────────────────────────────────── */
+/* Zero-filled; rings and slabs rely on that instead of initializing */
 void *gmk_hal_page_alloc(size_t size, size_t align);
 void  gmk_hal_page_free(void *ptr, size_t size);
 void *gmk_hal_calloc(size_t n, size_t size);
@@ -45,4 +65,23 @@ void  gmk_hal_free(void *ptr);
 void *gmk_hal_memset(void *dst, int val, size_t n);
 void *gmk_hal_memcpy(void *dst, const void *src, size_t n);
 
+/* ── Page size and NUMA placement ────────────────────────────── */
+#define GMK_HAL_HUGE_THP   0   /* advise THP on 2 MB+ regions (default) */
+#define GMK_HAL_HUGE_OFF   1   /* base pages only                       */
+#define GMK_HAL_HUGE_TLB   2   /* hugetlbfs pages, THP if none reserved */
+#define GMK_HAL_NODE_ANY   (-1)
+
+/* Process-wide: huge page mode for page_alloc, and whether workers are
+ * spread over NUMA nodes. Set before allocating or binding workers. */
+void     gmk_hal_mem_policy(uint32_t huge, bool numa);
+uint32_t gmk_hal_node_count(void);
+/* Node worker runs on (workers go round-robin over nodes), or
+ * GMK_HAL_NODE_ANY when NUMA placement is off or there is one node. */
+int      gmk_hal_worker_node(uint32_t worker);
+/* Prefer node for page_alloc calls made by this thread. Returns the
+ * previous hint; GMK_HAL_NODE_ANY clears it. */
+int      gmk_hal_mem_node(int node);
+/* Prefer node for the whole pages of an existing range. */
+void     gmk_hal_mem_bind(void *ptr, size_t size, int node);
+
 #endif /* GMK_HAL_H */
@@ -3,6 +3,10 @@
  *
  * Per-tenant + global atomic counters.
  * Unconditional — never gated by trace level or sampling.
+ * ALLOC_IN_USE/ALLOC_RESERVED are gauges: gmk_alloc_publish moves them by
+ * the change since its last call, so the global slot is the sum over
+ * allocators.
+ * Batch histogram: bucket b counts gathers of (2^(b-1), 2^b] tasks.
  */
 #ifndef GMK_METRICS_H
 #define GMK_METRICS_H
@@ -12,6 +16,7 @@
 struct gmk_metrics {
     _Atomic(uint64_t) global[GMK_METRIC_COUNT];
     _Atomic(uint64_t) per_tenant[GMK_MAX_TENANTS][GMK_METRIC_COUNT];
+    _Atomic(uint64_t) batch_hist[GMK_BATCH_HIST_BUCKETS];
     uint32_t          n_tenants;
 };
 
@@ -29,6 +34,12 @@ uint64_t gmk_metric_get(const gmk_metrics_t *m, uint32_t metric_id);
 uint64_t gmk_metric_get_tenant(const gmk_metrics_t *m, uint16_t tenant,
                                uint32_t metric_id);
 
+/* Record one worker gather of n tasks (n > 0) in the batch histogram. */
+void gmk_metric_batch(gmk_metrics_t *m, uint32_t n);
+
+/* Read a batch histogram bucket. */
+uint64_t gmk_metric_batch_get(const gmk_metrics_t *m, uint32_t bucket);
+
 /* Reset all counters to zero. */
 void gmk_metrics_reset(gmk_metrics_t *m);
 
@@ -30,6 +30,7 @@
     atomic_compare_exchange_weak_explicit(p, exp, des, succ, fail)
 #define gmk_atomic_cas_strong(p, exp, des, succ, fail) \
     atomic_compare_exchange_strong_explicit(p, exp, des, succ, fail)
+#define gmk_atomic_fence(order)            atomic_thread_fence(order)
 
 /* ── TSC / monotonic clock ───────────────────────────────────── */
 static inline uint64_t gmk_tsc(void) {
@@ -62,6 +63,16 @@ static inline uint32_t gmk_next_pow2(uint32_t x) {
 #define gmk_likely(x)   __builtin_expect(!!(x), 1)
 #define gmk_unlikely(x) __builtin_expect(!!(x), 0)
 
+/* Spin-wait hint. */
+static inline void gmk_cpu_relax(void) {
+#if defined(__x86_64__)
+    __builtin_ia32_pause();
+#endif
+}
+
+/* Read prefetch into all cache levels. */
+#define gmk_prefetch(p) __builtin_prefetch((const void *)(p), 0, 3)
+
 #define GMK_UNUSED __attribute__((unused))
 
 #endif /* GMK_PLATFORM_H */
@@ -8,24 +8,56 @@
 
 #include "platform.h"
 
-/* Per-slot cell: sequence + data */
+/*
+ * Cell layouts:
+ *   PACKED  seq + data back to back, 8-byte stride. Densest; a task-sized
+ *           cell (56 B) straddles cache lines and neighbours false-share.
+ *   PADDED  data + seq rounded up to a cache-line stride; one cell per line
+ *           for elements up to 60 bytes. Data leads the cell, so each
+ *           element is cache-line aligned.
+ *   SPLIT   separate seq[] and data[] arrays. Data stays dense; sequence
+ *           polling touches only the seq array.
+ */
+#define GMK_RING_PACKED 0
+#define GMK_RING_PADDED 1
+#define GMK_RING_SPLIT  2
+
+/* Layout for rings that carry gmk_task_t (RQ, overflow, inboxes, channels) */
+#ifndef GMK_TASK_RING_LAYOUT
+#define GMK_TASK_RING_LAYOUT GMK_RING_PADDED
+#endif
+
+/* Per-slot cell for PACKED: sequence + data */
 typedef struct {
     _Atomic(uint32_t) seq;
     uint8_t           data[];  /* flexible array member */
 } gmk_mpmc_cell_t;
 
 typedef struct {
+    /* Read-only after init: kept off the head/tail lines */
+    uint32_t cap;         /* must be power of two          */
+    uint32_t mask;        /* cap - 1                       */
+    uint32_t elem_size;   /* bytes per element             */
+    uint32_t layout;      /* GMK_RING_PACKED/PADDED/SPLIT  */
+    uint32_t seq_stride;  /* bytes between sequence words  */
+    uint32_t data_stride; /* bytes between element slots   */
+    uint8_t *seq_base;    /* sequence word of slot 0       */
+    uint8_t *data_base;   /* element data of slot 0        */
+    uint8_t *buf;         /* backing storage               */
+    size_t   buf_bytes;
+
     _Atomic(uint32_t) head GMK_ALIGN(GMK_CACHE_LINE);
     _Atomic(uint32_t) tail GMK_ALIGN(GMK_CACHE_LINE);
-    uint32_t cap;        /* must be power of two */
-    uint32_t mask;       /* cap - 1              */
-    uint32_t elem_size;  /* bytes per element    */
-    uint32_t cell_size;  /* sizeof(seq) + elem_size, aligned */
-    uint8_t *buf;        /* cell storage          */
 } gmk_ring_mpmc_t;
 
-/* Initialize ring. cap must be power of two. Returns 0 on success. */
+/* Bytes of storage a ring of this shape needs (for init_buf). */
+size_t gmk_ring_mpmc_buf_size(uint32_t cap, uint32_t elem_size, uint32_t layout);
+
+/* Initialize ring. cap must be power of two. Returns 0 on success.
+ * gmk_ring_mpmc_init uses the PACKED layout. */
 int  gmk_ring_mpmc_init(gmk_ring_mpmc_t *r, uint32_t cap, uint32_t elem_size);
+int  gmk_ring_mpmc_init_layout(gmk_ring_mpmc_t *r, uint32_t cap,
+                               uint32_t elem_size, uint32_t layout);
 void gmk_ring_mpmc_destroy(gmk_ring_mpmc_t *r);
 
 /* Push one element. Returns 0 on success, -1 if full. */
@@ -34,10 +66,47 @@ int  gmk_ring_mpmc_push(gmk_ring_mpmc_t *r, const void *elem);
 /* Pop one element. Returns 0 on success, -1 if empty. */
 int  gmk_ring_mpmc_pop(gmk_ring_mpmc_t *r, void *elem);
 
+/* Zero-copy producer side: reserve claims the next free cell and returns
+ * its data pointer (NULL if full), storing the cell's position in *pos;
+ * the caller fills it in place and passes pos to commit to publish it.
+ * Consumers cannot pass an uncommitted cell, so keep the window short.
+ * PACKED cells are only 4-byte aligned: fill them with gmk_hal_memcpy.
+ * PADDED and SPLIT cells are aligned for in-place typed access. */
+void *gmk_ring_mpmc_reserve(gmk_ring_mpmc_t *r, uint32_t *pos);
+void  gmk_ring_mpmc_commit(gmk_ring_mpmc_t *r, uint32_t pos);
+
+/* Zero-copy consumer side: peek claims the oldest full cell and returns
+ * its data pointer (NULL if empty); release hands the cell back to
+ * producers. Each peeked cell must be released exactly once. */
+const void *gmk_ring_mpmc_peek(gmk_ring_mpmc_t *r, uint32_t *pos);
+void        gmk_ring_mpmc_release(gmk_ring_mpmc_t *r, uint32_t pos);
+
+/* Push up to n contiguous elements from elems[] with a single CAS on tail.
+ * Returns the number pushed (0 if full); a short count means the ring
+ * filled up, and elems[ret..n) were not pushed. */
+uint32_t gmk_ring_mpmc_push_n(gmk_ring_mpmc_t *r, const void *elems, uint32_t n);
+
+/* Pop up to max elements into out[] with a single CAS on head.
+ * Returns the number popped (0 if empty). */
+uint32_t gmk_ring_mpmc_pop_n(gmk_ring_mpmc_t *r, void *out, uint32_t max);
+
+/* Zero-copy bulk claims: reserve_n claims up to n contiguous free cells
+ * and peek_n up to max full ones, with a single CAS, storing the first
+ * position in *pos and returning the count (0 if full/empty). Cell
+ * pos + i is at gmk_ring_mpmc_slot(r, pos + i); the run may wrap, so
+ * index every cell through slot. commit_n/release_n publish the whole
+ * run; hold it only as long as it takes to fill or read it. */
+uint32_t gmk_ring_mpmc_reserve_n(gmk_ring_mpmc_t *r, uint32_t n, uint32_t *pos);
+void     gmk_ring_mpmc_commit_n(gmk_ring_mpmc_t *r, uint32_t pos, uint32_t n);
+uint32_t gmk_ring_mpmc_peek_n(gmk_ring_mpmc_t *r, uint32_t max, uint32_t *pos);
+void     gmk_ring_mpmc_release_n(gmk_ring_mpmc_t *r, uint32_t pos, uint32_t n);
+void    *gmk_ring_mpmc_slot(const gmk_ring_mpmc_t *r, uint32_t pos);
+
 /* Approximate count. */
 uint32_t gmk_ring_mpmc_count(const gmk_ring_mpmc_t *r);
 
-/* Initialize ring using pre-allocated buffer (no internal malloc). */
+/* Initialize ring using pre-allocated buffer (no internal malloc).
+ * PACKED layout; buf_size must be at least gmk_ring_mpmc_buf_size(). */
 int gmk_ring_mpmc_init_buf(gmk_ring_mpmc_t *r, uint32_t cap,
                             uint32_t elem_size, void *buf, size_t buf_size);
 
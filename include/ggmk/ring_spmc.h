@@ -0,0 +1,47 @@
+/*
+ * GGMK/cpu — SPMC lock-free ring buffer (work-stealing run queue)
+ * Single producer (the owning worker), multiple consumers (owner + thieves).
+ * Every consumer claims from head with CAS, so a thief can take half the
+ * ring with a single CAS. FIFO. Power-of-two capacity, memcpy elements.
+ */
+#ifndef GMK_RING_SPMC_H
+#define GMK_RING_SPMC_H
+
+#include "platform.h"
+
+typedef struct {
+    _Atomic(uint32_t) head GMK_ALIGN(GMK_CACHE_LINE);
+    _Atomic(uint32_t) tail GMK_ALIGN(GMK_CACHE_LINE);
+    uint32_t cap;       /* must be power of two */
+    uint32_t mask;      /* cap - 1              */
+    uint32_t elem_size; /* bytes per element    */
+    uint8_t *buf;       /* element storage      */
+} gmk_ring_spmc_t;
+
+/* Initialize ring. cap must be power of two. Returns 0 on success. */
+int  gmk_ring_spmc_init(gmk_ring_spmc_t *r, uint32_t cap, uint32_t elem_size);
+void gmk_ring_spmc_destroy(gmk_ring_spmc_t *r);
+
+/* Push one element. Owner only. Returns 0 on success, -1 if full. */
+int  gmk_ring_spmc_push(gmk_ring_spmc_t *r, const void *elem);
+
+/* Pop one element. Any thread. Returns 0 on success, -1 if empty. */
+int  gmk_ring_spmc_pop(gmk_ring_spmc_t *r, void *elem);
+
+/* Pop up to max elements into out[] with a single CAS. Any thread.
+ * Returns the number popped. */
+uint32_t gmk_ring_spmc_pop_n(gmk_ring_spmc_t *r, void *out, uint32_t max);
+
+/* Steal up to half of src (at most max elements) into dst.
+ * Caller must be dst's producer. Both rings must share elem_size.
+ * Returns the number of elements moved. */
+uint32_t gmk_ring_spmc_steal(gmk_ring_spmc_t *dst, gmk_ring_spmc_t *src,
+                             uint32_t max);
+
+/* Current count of elements in the ring (approximate under contention). */
+uint32_t gmk_ring_spmc_count(const gmk_ring_spmc_t *r);
+
+/* Is the ring empty? */
+bool gmk_ring_spmc_empty(const gmk_ring_spmc_t *r);
+
+#endif /* GMK_RING_SPMC_H */
@@ -27,6 +27,17 @@ int  gmk_ring_spsc_push(gmk_ring_spsc_t *r, const void *elem);
 /* Pop one element. Returns 0 on success, -1 if empty. */
 int  gmk_ring_spsc_pop(gmk_ring_spsc_t *r, void *elem);
 
+/* Zero-copy producer side: reserve returns the next free slot (NULL if
+ * full) for the caller to fill in place; commit publishes it. At most one
+ * slot may be outstanding between reserve and commit. */
+void *gmk_ring_spsc_reserve(gmk_ring_spsc_t *r);
+void  gmk_ring_spsc_commit(gmk_ring_spsc_t *r);
+
+/* Zero-copy consumer side: peek returns the oldest slot (NULL if empty)
+ * for the caller to read in place; release hands it back to the producer. */
+const void *gmk_ring_spsc_peek(gmk_ring_spsc_t *r);
+void        gmk_ring_spsc_release(gmk_ring_spsc_t *r);
+
 /* Current count of elements in the ring. */
 uint32_t gmk_ring_spsc_count(const gmk_ring_spsc_t *r);
 
@@ -2,8 +2,12 @@
  * GGMK/cpu — Scheduler: RQ, LQ, EVQ, _gmk_enqueue
  *
  * RQ: 4 MPMC sub-queues (one per priority). Weighted pop.
- * LQ: SPSC per worker. Yield watermark at 75%.
- * EVQ: bounded binary min-heap, lock-protected.
+ * LQ: SPMC per worker (owner pushes, owner + thieves pop). Yield watermark at 75%.
+ *     Remote producers write a per-worker MPMC inbox; the owner splices it in.
+ * EVQ: hierarchical timing wheel, lock-protected; O(1) arm and cancel.
+ *      One shard per worker, with a lock-free next-due peek.
+ * DET: deterministic lane for GMK_TF_DETERMINISTIC tasks, run one tick at
+ *      a time in canonical order, one type group per worker, no stealing.
  * Overflow: MPMC ring for yield overflow.
  */
 #ifndef GMK_SCHED_H
@@ -11,6 +15,7 @@
 
 #include "types.h"
 #include "ring_spsc.h"
+#include "ring_spmc.h"
 #include "ring_mpmc.h"
 #include "lock.h"
 
@@ -26,56 +31,246 @@ int  gmk_rq_push(gmk_rq_t *rq, const gmk_task_t *task);
 int  gmk_rq_pop(gmk_rq_t *rq, gmk_task_t *task);
 uint32_t gmk_rq_count(const gmk_rq_t *rq);
 
-/* ── Local Queue (LQ): per-worker SPSC ───────────────────────── */
+/* Bulk push: runs of equal priority go in with one CAS each. Returns the
+ * number pushed from the front of tasks[]; stops at the first full queue. */
+uint32_t gmk_rq_push_n(gmk_rq_t *rq, const gmk_task_t *tasks, uint32_t n);
+
+/* Bulk weighted pop: each priority contributes up to its remaining weight
+ * per round, one CAS per priority. Returns the number popped. */
+uint32_t gmk_rq_pop_n(gmk_rq_t *rq, gmk_task_t *out, uint32_t max);
+
+/* ── Local Queue (LQ): per-worker SPMC, stealable ────────────── */
 typedef struct {
-    gmk_ring_spsc_t ring;
+    gmk_ring_spmc_t ring;             /* owner-private producer side   */
+    gmk_ring_mpmc_t inbox;            /* remote producers (any thread) */
     uint32_t        yield_watermark;  /* normal push limit (75% of cap) */
     uint32_t        cap;
+    uint32_t        pops;             /* owner pop count, paces inbox polls */
 } gmk_lq_t;
 
 int  gmk_lq_init(gmk_lq_t *lq, uint32_t cap);
 void gmk_lq_destroy(gmk_lq_t *lq);
-int  gmk_lq_push(gmk_lq_t *lq, const gmk_task_t *task);        /* normal */
-int  gmk_lq_push_yield(gmk_lq_t *lq, const gmk_task_t *task);  /* yield reserve */
-int  gmk_lq_pop(gmk_lq_t *lq, gmk_task_t *task);
-uint32_t gmk_lq_count(const gmk_lq_t *lq);
+int  gmk_lq_push(gmk_lq_t *lq, const gmk_task_t *task);        /* normal, owner */
+int  gmk_lq_push_yield(gmk_lq_t *lq, const gmk_task_t *task);  /* yield reserve, owner */
+int  gmk_lq_push_remote(gmk_lq_t *lq, const gmk_task_t *task); /* inbox, any thread */
+int  gmk_lq_pop(gmk_lq_t *lq, gmk_task_t *task);               /* owner */
+uint32_t gmk_lq_pop_n(gmk_lq_t *lq, gmk_task_t *out, uint32_t max); /* owner */
+uint32_t gmk_lq_count(const gmk_lq_t *lq);                     /* ring + inbox */
+
+/* Steal half of victim's LQ into thief's LQ, up to thief's yield watermark.
+ * Caller must own thief. Returns the number of tasks moved. */
+uint32_t gmk_lq_steal(gmk_lq_t *thief, gmk_lq_t *victim);
+
+/* ── Event Queue (EVQ): hierarchical timing wheel ────────────── */
+/* GMK_EVQ_LEVELS wheels of GMK_EVQ_SLOTS slots, keyed by the tick in
+ * meta0: level l holds timers whose tick first differs from the wheel's
+ * position in byte l. A slot is cascaded one level down when the position
+ * enters it; a level-0 slot, once due, is staged into per-priority ready
+ * lists. Timers live in a preallocated node pool; lists are linked by
+ * node index, so insert and cancel are O(1). The scheduler keeps one
+ * EVQ shard per worker. */
+typedef uint64_t gmk_evq_handle_t;   /* (gen << 32) | node; 0 = none */
+
+/* Handle generations are 24 bits; the top byte is left to the caller
+ * (the scheduler stores the shard there) and ignored by gmk_evq_cancel. */
+#define GMK_EVQ_GEN_MASK  0x00FFFFFFu
 
-/* ── Event Queue (EVQ): bounded binary min-heap ──────────────── */
 typedef struct {
-    uint64_t      key;   /* (meta0 as tick << 32) | (priority << 16) | seq */
     gmk_task_t    task;
-} gmk_evq_entry_t;
+    uint32_t      next;
+    uint32_t      prev;
+    uint32_t      gen;   /* bumped on free; stale handles miss  */
+    uint32_t      list;  /* owning list, GMK_EVQ_NO_LIST when free */
+} gmk_evq_node_t;    /* 64 bytes */
 
 typedef struct {
-    gmk_evq_entry_t *heap;
-    uint32_t          count;
-    uint32_t          cap;
-    uint32_t          next_seq;
-    gmk_lock_t        lock;
+    uint32_t      head;
+    uint32_t      tail;
+} gmk_evq_list_t;
+
+#define GMK_EVQ_READY     (GMK_EVQ_LEVELS * GMK_EVQ_SLOTS)
+#define GMK_EVQ_LISTS     (GMK_EVQ_READY + GMK_PRIORITY_COUNT)
+#define GMK_EVQ_NO_LIST   UINT32_MAX
+
+typedef struct {
+    gmk_evq_node_t  *nodes;
+    gmk_evq_list_t   lists[GMK_EVQ_LISTS];
+    uint64_t         occupied[GMK_EVQ_LEVELS][GMK_EVQ_SLOTS / 64];
+    uint64_t         now;        /* next tick not yet staged           */
+    uint32_t         count;      /* live timers                        */
+    uint32_t         ready;      /* of which staged                    */
+    uint32_t         cap;
+    uint32_t         fresh;      /* nodes never used (lazy pool)       */
+    uint32_t         free_head;
+    uint32_t         next_seq;
+    _Atomic(uint64_t) next_due;  /* lower bound on the earliest tick  */
+    gmk_lock_t       lock;
 } gmk_evq_t;
 
 int  gmk_evq_init(gmk_evq_t *evq, uint32_t cap);
 void gmk_evq_destroy(gmk_evq_t *evq);
 int  gmk_evq_push(gmk_evq_t *evq, const gmk_task_t *task);
-int  gmk_evq_pop_due(gmk_evq_t *evq, uint32_t current_tick, gmk_task_t *task);
+int  gmk_evq_pop_due(gmk_evq_t *evq, uint64_t current_tick, gmk_task_t *task);
 uint32_t gmk_evq_count(const gmk_evq_t *evq);
 
+/* Push and return a handle for gmk_evq_cancel (handle may be NULL). */
+int  gmk_evq_arm(gmk_evq_t *evq, const gmk_task_t *task,
+                 gmk_evq_handle_t *handle);
+
+/* Remove a pending timer. Returns -1 if it already fired or was cancelled. */
+int  gmk_evq_cancel(gmk_evq_t *evq, gmk_evq_handle_t handle);
+
+/* Pop up to max due timers under one lock, in (tick, priority, seq) order.
+ * Returns the number popped. */
+uint32_t gmk_evq_pop_due_n(gmk_evq_t *evq, uint64_t current_tick,
+                           gmk_task_t *out, uint32_t max);
+
+/* Lock-free peek: nothing is due before the returned tick (UINT64_MAX when
+ * empty). Never late; early only when the next timer is above level 0. */
+static inline uint64_t gmk_evq_next_due(const gmk_evq_t *evq) {
+    return gmk_atomic_load(&evq->next_due, memory_order_acquire);
+}
+
+/* ── Deterministic lane (DET) ────────────────────────────────── */
+/* GMK_TF_DETERMINISTIC tasks bypass the LQs and RQ. Each is released at
+ * a tick: a task pushed by a deterministic handler running in the batch
+ * for tick T is released at T+1, any other push at the lane's tick + 1.
+ * Once the tick reaches the earliest release tick, the next claim
+ * collects every task released then into a batch, sorts it by (type,
+ * priority, order), stamps seq in that order and splits it into one group
+ * per type. Order is the emitter's batch index and emit count, so it does
+ * not depend on which worker ran the emitter; host pushes come after
+ * emissions, in arrival order. Within a type this is the canonical
+ * (tick, priority, type, seq) order.
+ *
+ * Workers claim whole groups: a type runs in order on one worker while
+ * other types run in parallel, so types must not share state. The next
+ * batch opens only after every group has finished (the tick barrier).
+ * Handlers see the batch tick in ctx->tick. Claims, pushes and the
+ * barrier are lock-protected; gmk_det_ready is a lock-free peek. */
+typedef struct {
+    gmk_task_t    task;
+    uint64_t      tick;      /* release tick                            */
+    uint64_t      order;     /* (index << 24) | emit count, or host arrival */
+} gmk_det_entry_t;           /* 64 bytes */
+
+typedef struct {
+    uint32_t      start;     /* first batch index of the type           */
+    uint32_t      len;
+} gmk_det_group_t;
+
+#define GMK_DET_NONE      UINT32_MAX
+
+typedef struct {
+    gmk_det_entry_t  *pending;   /* released later, unsorted            */
+    gmk_det_entry_t  *batch;     /* open batch, sorted                  */
+    gmk_det_entry_t  *scratch;   /* merge sort buffer                   */
+    gmk_det_group_t  *groups;
+    uint32_t         *emitter;   /* per worker: batch index, or NONE    */
+    uint32_t         *emitted;   /* per worker: pushes by that task     */
+    uint32_t          n_pending;
+    uint32_t          n_batch;
+    uint32_t          n_groups;
+    uint32_t          next_group;
+    uint32_t          groups_left;   /* 0 = no batch open               */
+    uint32_t          cap;
+    uint32_t          n_workers;
+    uint32_t          next_seq;
+    uint64_t          host_order;
+    uint64_t          tick;          /* tick of the open (or last) batch */
+    _Atomic(uint64_t) now;           /* lane tick, raised by the kernel  */
+    _Atomic(uint64_t) next_tick;     /* earliest release while idle      */
+    _Atomic(uint32_t) unclaimed;     /* groups of the open batch         */
+    gmk_lock_t        lock;
+} gmk_det_t;
+
+int  gmk_det_init(gmk_det_t *d, uint32_t cap, uint32_t n_workers);
+void gmk_det_destroy(gmk_det_t *d);
+
+/* Queue a task for its release tick. -1 when the lane is full. */
+int  gmk_det_push(gmk_det_t *d, const gmk_task_t *task);
+
+/* Raise the lane tick (never lowers it). */
+void gmk_det_advance(gmk_det_t *d, uint64_t tick);
+
+/* Claim the next group of the open batch, opening the next batch first if
+ * none is open and one is released. *tick gets the batch tick. Returns -1
+ * if there is nothing to claim. Every claimed group ends with one
+ * gmk_det_done. */
+int  gmk_det_claim(gmk_det_t *d, gmk_det_group_t *g, uint64_t *tick);
+void gmk_det_done(gmk_det_t *d);
+
+/* Bracket the dispatch of batch index idx on worker, so the handler's
+ * pushes are ordered by idx. */
+void gmk_det_begin(gmk_det_t *d, uint32_t worker, uint32_t idx);
+void gmk_det_end(gmk_det_t *d, uint32_t worker);
+
+/* Tasks queued or in the open batch. */
+uint32_t gmk_det_count(gmk_det_t *d);
+
+/* Lock-free peek: a group is unclaimed or a batch is ready to open. */
+static inline bool gmk_det_ready(const gmk_det_t *d) {
+    return gmk_atomic_load(&d->unclaimed, memory_order_acquire) > 0 ||
+           gmk_atomic_load(&d->next_tick, memory_order_acquire) <=
+           gmk_atomic_load(&d->now, memory_order_acquire);
+}
+
 /* ── Scheduler aggregate ─────────────────────────────────────── */
 struct gmk_sched {
     gmk_rq_t        rq;
     gmk_lq_t       *lqs;            /* array of LQs, one per worker */
-    gmk_evq_t       evq;
+    gmk_evq_t      *evqs;           /* EVQ shards, one per worker   */
     gmk_ring_mpmc_t overflow;        /* yield overflow bucket        */
+    gmk_det_t        det;            /* deterministic lane           */
     uint32_t         n_workers;
     _Atomic(uint32_t) next_seq;      /* monotonic sequence counter   */
+    _Atomic(uint32_t) evq_spread;    /* shard rotor for unrouted timers */
+    /* Wakes worker_id, or any parked worker if < 0 (NULL = no workers) */
+    void            (*wake)(void *arg, int worker_id);
+    void             *wake_arg;
 };
 
 int  gmk_sched_init(gmk_sched_t *s, uint32_t n_workers);
 void gmk_sched_destroy(gmk_sched_t *s);
 
-/* Core enqueue: assigns seq, routes to LQ (if worker_id >= 0) or RQ. */
+/* Core enqueue: assigns seq, routes to worker's LQ inbox (if worker_id >= 0)
+ * or RQ. GMK_TF_DETERMINISTIC tasks go to the deterministic lane instead,
+ * which stamps its own seq. Calls the wake hook when no running worker
+ * would otherwise see the task: another worker's inbox, or the RQ from a
+ * thread that is not a worker. Safe from any thread. */
 int  _gmk_enqueue(gmk_sched_t *s, gmk_task_t *task, int worker_id);
 
+/* Bulk enqueue: one seq reservation for all n tasks, then a bulk push to
+ * the worker's inbox (if worker_id >= 0) and the RQ for the rest. Returns
+ * the number enqueued from the front of tasks[]. Safe from any thread. */
+uint32_t _gmk_enqueue_n(gmk_sched_t *s, gmk_task_t *tasks, uint32_t n,
+                        int worker_id);
+
+/* Bulk enqueue from task pointers (e.g. cells peeked from another ring):
+ * like _gmk_enqueue_n, but each src[i] is copied once, straight into a
+ * cell claimed with reserve_n on the inbox or on each RQ priority run.
+ * src[] is not modified. Returns the number enqueued from the front of
+ * src[]. Safe from any thread. */
+_Static_assert(GMK_TASK_RING_LAYOUT != GMK_RING_PACKED,
+               "tasks are built in place: task rings need aligned cells");
+
+uint32_t _gmk_enqueue_copy_n(gmk_sched_t *s, const gmk_task_t *const *src,
+                             uint32_t n, int worker_id);
+
+/* Timer enqueue: parks task in worker_id's EVQ shard until the tick in
+ * meta0, so it fires into that worker's LQ; worker_id < 0 rotates across
+ * shards. A full shard spills to the next one with room. handle (may be
+ * NULL) is for _gmk_cancel_at. Safe from any thread. */
+int  _gmk_enqueue_at(gmk_sched_t *s, const gmk_task_t *task, int worker_id,
+                     gmk_evq_handle_t *handle);
+
+/* Cancel a timer from _gmk_enqueue_at. -1 if it already fired. */
+int  _gmk_cancel_at(gmk_sched_t *s, gmk_evq_handle_t handle);
+
+/* Owner-only enqueue: caller must be worker_id's thread. Pushes straight
+ * into the LQ ring, skipping the inbox; falls back to RQ. */
+int  _gmk_enqueue_local(gmk_sched_t *s, gmk_task_t *task, uint32_t worker_id);
+
 /* Yield: increment yield_count, circuit breaker, try LQ → overflow → error. */
 int  _gmk_yield(gmk_sched_t *s, gmk_task_t *task, int worker_id,
                 uint32_t max_yields);
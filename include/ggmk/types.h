@@ -48,7 +48,7 @@ typedef struct gmk_ctx {
     gmk_sched_t    *sched;      /* scheduler (for enqueue/yield)       */
     gmk_kernel_t   *kernel;     /* kernel reference                    */
     uint32_t        worker_id;  /* which worker is executing           */
-    uint32_t        tick;       /* current logical tick                 */
+    uint64_t        tick;       /* current logical tick                 */
 } gmk_ctx_t;
 
 /* ── Handler registration ────────────────────────────────────── */
@@ -1,8 +1,11 @@
 /*
  * GGMK/cpu — Worker thread pool
  *
- * Hosted: N pthreads, park via HAL condvar.
+ * Hosted: N pthreads, park via HAL futex eventcount.
  * Freestanding: N CPUs, park via HAL sti;hlt, wake via HAL LAPIC IPI.
+ * Each iteration gathers a batch (LQ, then a fair share of overflow and RQ),
+ * sorts it by type and dispatches it. Idle workers steal half of a random
+ * sibling's LQ, spin for a while, then park until woken.
  */
 #ifndef GMK_WORKER_H
 #define GMK_WORKER_H
@@ -10,25 +13,37 @@
 #include "types.h"
 #include "sched.h"
 #include "module.h"
+#include "alloc.h"
 #include "hal.h"
 
-typedef struct {
+typedef struct gmk_worker {
     uint32_t        id;
     gmk_hal_thread_t thread;
     gmk_hal_park_t   park;
     gmk_sched_t    *sched;
     gmk_module_reg_t *modules;
     gmk_alloc_t    *alloc;
+    gmk_alloc_t   **tenant_alloc;   /* [GMK_MAX_TENANTS], NULL = alloc */
+    gmk_epoch_t    *epoch;          /* bump epoch, entered per batch */
     gmk_chan_reg_t  *chan;
     gmk_trace_t    *trace;
     gmk_metrics_t  *metrics;
     gmk_kernel_t   *kernel;
+    struct gmk_worker *siblings;    /* pool->workers, for wake-to-steal */
+    uint32_t         n_siblings;
+    uint32_t         steal_rng;     /* xorshift state for victim choice */
+    uint64_t         rebalance_ns;  /* last block rebalance (worker 0) */
+    uint64_t         spin_ns;       /* idle spin before parking, 0 = none */
 
     _Atomic(bool)   running;
     _Atomic(bool)   parked;
 
     _Atomic(uint64_t) tasks_dispatched;
-    _Atomic(uint32_t) tick;
+    _Atomic(uint64_t) tick;
+
+    uint32_t         batch_size;    /* tasks per gather, <= GMK_WORKER_BATCH_MAX */
+    uint16_t         batch_order[GMK_WORKER_BATCH_MAX]; /* type-sorted indices */
+    gmk_task_t       batch[GMK_WORKER_BATCH_MAX];
 } gmk_worker_t;
 
 typedef struct {
@@ -51,7 +66,27 @@ int  gmk_worker_pool_init(gmk_worker_pool_t *pool, uint32_t n_workers,
 int  gmk_worker_pool_start(gmk_worker_pool_t *pool);
 void gmk_worker_pool_stop(gmk_worker_pool_t *pool);
 void gmk_worker_pool_destroy(gmk_worker_pool_t *pool);
+/* Set tasks per gather for every worker (clamped to 1..GMK_WORKER_BATCH_MAX).
+ * Call before gmk_worker_pool_start. */
+void gmk_worker_pool_set_batch(gmk_worker_pool_t *pool, uint32_t batch_size);
+/* Give tasks of tenant t the allocator allocs[t] (GMK_MAX_TENANTS entries,
+ * NULL entries use the pool allocator). Call before gmk_worker_pool_start. */
+void gmk_worker_pool_set_tenant_allocs(gmk_worker_pool_t *pool, gmk_alloc_t **allocs);
+/* Enter e around every dispatched batch. Call before gmk_worker_pool_start. */
+void gmk_worker_pool_set_epoch(gmk_worker_pool_t *pool, gmk_epoch_t *e);
+/* Idle spin before parking: 0 = GMK_PARK_SPIN_NS, GMK_PARK_SPIN_OFF = none.
+ * Call before gmk_worker_pool_start. */
+void gmk_worker_pool_set_park(gmk_worker_pool_t *pool, uint64_t spin_ns);
+
+/* Wake w if it is parked. Call after publishing the work it should see:
+ * a worker that parks concurrently either gets the wake or finds the
+ * work in its last check. */
 void gmk_worker_wake(gmk_worker_t *w);
+/* Wake the first parked worker, if any. Same ordering as gmk_worker_wake. */
+void gmk_worker_wake_one(gmk_worker_pool_t *pool);
+/* Scheduler wake hook (gmk_sched_t.wake): arg is the pool; wakes worker
+ * worker_id, or the first parked worker if worker_id < 0. */
+void gmk_worker_notify(void *arg, int worker_id);
 void gmk_worker_wake_all(gmk_worker_pool_t *pool);
 
 /* Worker loop entry point (bare-metal APs call directly, hosted via HAL thread) */
@@ -4,15 +4,37 @@
  * Arena subdivision:
  *   10% task slab (48-byte objects)
  *    2% trace slab (32-byte objects)
- *   68% block allocator (power-of-two bins)
+ *   68% block allocator (45 size classes, large extents above 64 KB)
  *   20% bump allocator
+ *
+ * Region sizes are rounded down to whole pages. A one-byte-per-page map
+ * records which slab owns each page, so gmk_free needs no size. Block
+ * pages move between bins, so the map only names the block region and
+ * the block's own page table resolves the bin.
  */
 #include "ggmk/alloc.h"
 #include "ggmk/types.h"
+#include "ggmk/hal.h"
+#include "ggmk/metrics.h"
 #include <string.h>
 
+static inline size_t page_floor(size_t n) {
+    return n & ~(size_t)(GMK_ALLOC_PAGE - 1);
+}
+
+/* Tag every page of [base, base + size) with class mag */
+static void page_map_mark(gmk_alloc_t *a, const uint8_t *base, size_t size,
+                          uint32_t mag) {
+    if (size == 0) return;
+    size_t first = (size_t)(base - a->arena.base) >> GMK_ALLOC_PAGE_SHIFT;
+    size_t last  = (size_t)(base + size - 1 - a->arena.base)
+                   >> GMK_ALLOC_PAGE_SHIFT;
+    for (size_t pg = first; pg <= last && pg < a->n_pages; pg++)
+        a->page_map[pg] = (uint8_t)(mag + 1);
+}
+
 int gmk_alloc_init(gmk_alloc_t *a, size_t arena_size) {
-    if (!a || arena_size < 4096) return -1;
+    if (!a || arena_size < GMK_ALLOC_MIN_ARENA) return -1;
 
     memset(a, 0, sizeof(*a));
 
@@ -21,12 +43,15 @@ int gmk_alloc_init(gmk_alloc_t *a, size_t arena_size) {
 
     atomic_init(&a->total_alloc_bytes, 0);
     atomic_init(&a->total_alloc_fails, 0);
+    for (uint32_t i = 0; i < GMK_ALLOC_N_CLASSES; i++)
+        atomic_init(&a->class_fails[i], 0);
 
     uint8_t *base = a->arena.base;
-    size_t task_size  = (arena_size * 10) / 100;
-    size_t trace_size = (arena_size *  2) / 100;
-    size_t bump_size  = (arena_size * 20) / 100;
-    size_t block_size = arena_size - task_size - trace_size - bump_size;
+    size_t task_size  = page_floor((arena_size * 10) / 100);
+    size_t trace_size = page_floor((arena_size *  2) / 100);
+    size_t block_size = page_floor(arena_size - task_size - trace_size
+                                   - (arena_size * 20) / 100);
+    size_t bump_size  = arena_size - task_size - trace_size - block_size;
 
     uint8_t *task_mem  = base;
     uint8_t *trace_mem = task_mem  + task_size;
@@ -42,6 +67,23 @@ int gmk_alloc_init(gmk_alloc_t *a, size_t arena_size) {
     if (gmk_bump_init(&a->bump, bump_mem, bump_size) != 0)
         goto fail;
 
+    a->n_pages  = (arena_size + GMK_ALLOC_PAGE - 1) >> GMK_ALLOC_PAGE_SHIFT;
+    a->page_map = (uint8_t *)gmk_hal_calloc(a->n_pages, 1);
+    if (!a->page_map)
+        goto fail;
+    page_map_mark(a, task_mem, task_size, GMK_MAG_TASK);
+    page_map_mark(a, trace_mem, trace_size, GMK_MAG_TRACE);
+    page_map_mark(a, block_mem, block_size, GMK_MAG_BLOCK);
+
+    a->slab_mode = GMK_SLAB_DEFAULT_MODE;
+    atomic_init(&a->chunk_bytes, 0);
+    atomic_init(&a->chunk_grows, 0);
+    atomic_init(&a->chunk_releases, 0);
+    for (uint32_t i = 0; i < GMK_ALLOC_MAX_CHUNKS; i++) {
+        atomic_init(&a->chunk_base[i], 0);
+        atomic_init(&a->chunk_end[i], 0);
+    }
+    gmk_lock_init(&a->chunk_lock);
     return 0;
 
 fail:
@@ -54,61 +96,467 @@ void gmk_alloc_destroy(gmk_alloc_t *a) {
     gmk_slab_destroy(&a->task_slab);
     gmk_slab_destroy(&a->trace_slab);
     gmk_block_destroy(&a->block);
+    for (uint32_t i = 0; i < GMK_ALLOC_MAX_CHUNKS; i++) {
+        gmk_block_t *c = a->chunks[i];
+        if (!c) continue;
+        uintptr_t base = gmk_atomic_load(&a->chunk_base[i], memory_order_relaxed);
+        uintptr_t end  = gmk_atomic_load(&a->chunk_end[i], memory_order_relaxed);
+        if (base)
+            gmk_hal_page_free((void *)base, (size_t)(end - base));
+        gmk_block_destroy(c);
+        gmk_hal_free(c);
+        a->chunks[i] = NULL;
+    }
+    gmk_lock_destroy(&a->chunk_lock);
     /* bump has no destroy */
+    gmk_alloc_cache_destroy(a);
+    if (a->page_map) {
+        gmk_hal_free(a->page_map);
+        a->page_map = NULL;
+        a->n_pages  = 0;
+    }
     gmk_arena_destroy(&a->arena);
 }
 
+/* ── Elastic chunks ─────────────────────────────────────────── */
+
+static inline size_t page_ceil(size_t n) {
+    return (n + GMK_ALLOC_PAGE - 1) & ~(size_t)(GMK_ALLOC_PAGE - 1);
+}
+
+/* Live chunk i, or NULL. chunk_base is published after the descriptor. */
+static inline gmk_block_t *chunk_at(const gmk_alloc_t *a, uint32_t i) {
+    if (gmk_atomic_load(&a->chunk_base[i], memory_order_acquire) == 0)
+        return NULL;
+    return a->chunks[i];
+}
+
+/*
+ * Add a chunk of at least min bytes unless one was added since the caller
+ * saw seen grows. Returns 0 if the caller should retry, -1 at the ceiling
+ * or when the HAL is out of memory.
+ */
+static int chunk_grow(gmk_alloc_t *a, size_t min, uint64_t seen) {
+    if (a->chunk_size == 0) return -1;
+
+    int rc = -1;
+    gmk_lock_acquire(&a->chunk_lock);
+    if (gmk_atomic_load(&a->chunk_grows, memory_order_relaxed) != seen) {
+        rc = 0;
+        goto out;
+    }
+
+    size_t size = min > a->chunk_size ? page_ceil(min) : a->chunk_size;
+    size_t held = a->arena.size +
+                  (size_t)gmk_atomic_load(&a->chunk_bytes, memory_order_relaxed);
+    if (held + size > a->max_size) goto out;
+
+    uint32_t slot = 0;
+    while (slot < GMK_ALLOC_MAX_CHUNKS &&
+           gmk_atomic_load(&a->chunk_base[slot], memory_order_relaxed) != 0)
+        slot++;
+    if (slot == GMK_ALLOC_MAX_CHUNKS) goto out;
+
+    void *mem = gmk_hal_page_alloc(size, GMK_ALLOC_PAGE);
+    if (!mem) goto out;
+
+    gmk_block_t *c = a->chunks[slot];
+    if (c) {
+        /* Retired descriptor: racing callers only ever saw it empty */
+        if (gmk_block_reattach(c, mem, size) != 0) {
+            gmk_hal_page_free(mem, size);
+            goto out;
+        }
+    } else {
+        c = (gmk_block_t *)gmk_hal_calloc(1, sizeof(*c));
+        if (!c || gmk_block_init_pooled(c, mem, size) != 0) {
+            gmk_hal_free(c);
+            gmk_hal_page_free(mem, size);
+            goto out;
+        }
+        gmk_block_set_mode(c, a->slab_mode);
+        gmk_block_set_intrusive(c, a->slab_intrusive);
+        a->chunks[slot] = c;
+    }
+
+    a->chunk_idle[slot] = 0;
+    gmk_atomic_store(&a->chunk_end[slot], (uintptr_t)mem + size,
+                     memory_order_relaxed);
+    gmk_atomic_store(&a->chunk_base[slot], (uintptr_t)mem, memory_order_release);
+    gmk_atomic_add(&a->chunk_bytes, size, memory_order_relaxed);
+    gmk_atomic_add(&a->chunk_grows, 1, memory_order_relaxed);
+    if (a->metrics)
+        gmk_metric_inc(a->metrics, a->tenant, GMK_METRIC_ALLOC_GROWS, 1);
+    rc = 0;
+out:
+    gmk_lock_release(&a->chunk_lock);
+    return rc;
+}
+
+/* Release chunk i to the HAL if nothing is allocated from it. */
+static bool chunk_release(gmk_alloc_t *a, uint32_t i) {
+    gmk_lock_acquire(&a->chunk_lock);
+    gmk_block_t *c = chunk_at(a, i);
+    bool done = c && gmk_block_retire(c) == 0;
+    if (done) {
+        /* The retired block hands out nothing, so no pointer into the
+         * memory can exist any more */
+        uintptr_t base = gmk_atomic_load(&a->chunk_base[i], memory_order_relaxed);
+        uintptr_t end  = gmk_atomic_load(&a->chunk_end[i], memory_order_relaxed);
+        gmk_atomic_store(&a->chunk_base[i], 0, memory_order_release);
+        gmk_atomic_store(&a->chunk_end[i], 0, memory_order_relaxed);
+        gmk_hal_page_free((void *)base, (size_t)(end - base));
+        gmk_atomic_sub(&a->chunk_bytes, end - base, memory_order_relaxed);
+        gmk_atomic_add(&a->chunk_releases, 1, memory_order_relaxed);
+    }
+    gmk_lock_release(&a->chunk_lock);
+    return done;
+}
+
+int gmk_alloc_set_elastic(gmk_alloc_t *a, size_t chunk_size, size_t max_size) {
+    if (!a) return -1;
+    if (chunk_size == 0) {
+        a->chunk_size = 0;
+        return 0;
+    }
+    chunk_size = page_ceil(chunk_size);
+    if (chunk_size < GMK_ALLOC_MIN_ARENA || max_size < a->arena.size + chunk_size)
+        return -1;
+    a->chunk_size = chunk_size;
+    a->max_size   = max_size;
+    return 0;
+}
+
+gmk_block_t *gmk_alloc_block_of(const gmk_alloc_t *a, const void *ptr) {
+    if (!a || !ptr) return NULL;
+    uintptr_t p = (uintptr_t)ptr;
+    const gmk_block_t *b = &a->block;
+    if (p >= (uintptr_t)b->base && p < (uintptr_t)b->base + b->total_size)
+        return (gmk_block_t *)b;
+
+    for (uint32_t i = 0; i < GMK_ALLOC_MAX_CHUNKS; i++) {
+        uintptr_t base = gmk_atomic_load(&a->chunk_base[i], memory_order_acquire);
+        if (base && p >= base &&
+            p < gmk_atomic_load(&a->chunk_end[i], memory_order_relaxed))
+            return a->chunks[i];
+    }
+    return NULL;
+}
+
+uint32_t gmk_alloc_block_alloc_n(gmk_alloc_t *a, int bin, void **out, uint32_t n) {
+    if (!a) return 0;
+    for (;;) {
+        uint64_t seen = gmk_atomic_load(&a->chunk_grows, memory_order_relaxed);
+        uint32_t got = gmk_block_alloc_n(&a->block, bin, out, n);
+        for (uint32_t i = 0; got == 0 && i < GMK_ALLOC_MAX_CHUNKS; i++) {
+            gmk_block_t *c = chunk_at(a, i);
+            if (c) got = gmk_block_alloc_n(c, bin, out, n);
+        }
+        if (got > 0 || chunk_grow(a, 0, seen) != 0)
+            return got;
+    }
+}
+
+void gmk_alloc_block_free_n(gmk_alloc_t *a, void *const *ptrs, uint32_t n) {
+    if (!a || !ptrs) return;
+
+    /* One block call per run of pointers from the same block */
+    uint32_t i = 0;
+    while (i < n) {
+        gmk_block_t *b = gmk_alloc_block_of(a, ptrs[i]);
+        uint32_t j = i + 1;
+        while (j < n && gmk_alloc_block_of(a, ptrs[j]) == b) j++;
+        if (b) gmk_block_free_n(b, ptrs + i, j - i);
+        i = j;
+    }
+}
+
+/* Large extent from the arena or a chunk, adding a chunk that fits it. */
+static void *large_get(gmk_alloc_t *a, size_t size) {
+    for (;;) {
+        uint64_t seen = gmk_atomic_load(&a->chunk_grows, memory_order_relaxed);
+        void *ptr = gmk_block_large_alloc(&a->block, size);
+        for (uint32_t i = 0; !ptr && i < GMK_ALLOC_MAX_CHUNKS; i++) {
+            gmk_block_t *c = chunk_at(a, i);
+            if (c) ptr = gmk_block_large_alloc(c, size);
+        }
+        if (ptr) return ptr;
+
+        /* Room for the extent plus the chunk's page table */
+        size_t data = page_ceil(size);
+        size_t meta = page_ceil((data >> GMK_ALLOC_PAGE_SHIFT) * sizeof(uint16_t)
+                                + GMK_ALLOC_PAGE);
+        if (chunk_grow(a, data + meta, seen) != 0)
+            return NULL;
+    }
+}
+
+/* Block allocation through the caller's magazine for that bin */
+static void *block_get(gmk_alloc_t *a, uint32_t size) {
+    int bin = gmk_block_bin(size);
+    if (bin < 0) return NULL;
+    void *ptr = gmk_alloc_cache_get(a, GMK_MAG_BLOCK + (uint32_t)bin);
+    if (ptr) gmk_block_account(gmk_alloc_block_of(a, ptr), ptr, size);
+    return ptr;
+}
+
 void *gmk_alloc(gmk_alloc_t *a, uint32_t size) {
     if (!a || size == 0) return NULL;
 
     void *ptr = NULL;
+    int cls = GMK_ALLOC_CLASS_LARGE;   /* last class tried, for fails */
 
-    /* Route: task-sized → slab, small/medium → block, else fail */
+    /* Route: task-sized → slab, small/medium → block, else large extent */
+    if (size <= GMK_BLOCK_MAX_SIZE)
+        cls = GMK_MAG_BLOCK + gmk_block_bin(size);
     if (size <= sizeof(gmk_task_t) && size > 0) {
         /* Try task slab first for task-sized allocations */
         if (size == sizeof(gmk_task_t)) {
-            ptr = gmk_slab_alloc(&a->task_slab);
+            ptr = gmk_alloc_cache_get(a, GMK_MAG_TASK);
         }
         if (!ptr) {
-            ptr = gmk_block_alloc(&a->block, size);
+            ptr = block_get(a, size);
         }
     } else if (size <= GMK_BLOCK_MAX_SIZE) {
-        ptr = gmk_block_alloc(&a->block, size);
+        ptr = block_get(a, size);
+    } else {
+        ptr = large_get(a, size);
     }
 
     if (ptr) {
         gmk_atomic_add(&a->total_alloc_bytes, size, memory_order_relaxed);
+        if (a->metrics)
+            gmk_metric_inc(a->metrics, a->tenant, GMK_METRIC_ALLOC_BYTES, size);
     } else {
         gmk_atomic_add(&a->total_alloc_fails, 1, memory_order_relaxed);
+        gmk_atomic_add(&a->class_fails[cls], 1, memory_order_relaxed);
+        if (a->metrics)
+            gmk_metric_inc(a->metrics, a->tenant, GMK_METRIC_ALLOC_FAILS, 1);
     }
     return ptr;
 }
 
-void gmk_free(gmk_alloc_t *a, void *ptr, uint32_t size) {
-    if (!a || !ptr || size == 0) return;
+int gmk_alloc_class(const gmk_alloc_t *a, const void *ptr) {
+    if (!a || !ptr || !a->page_map) return -1;
 
-    uint8_t *p = (uint8_t *)ptr;
+    /* Arena pages map to their class; chunks hold only block pages */
+    const uint8_t *p = (const uint8_t *)ptr;
+    int cls = GMK_MAG_BLOCK;
+    if (p >= a->arena.base &&
+        (size_t)(p - a->arena.base) >> GMK_ALLOC_PAGE_SHIFT < a->n_pages)
+        cls = (int)a->page_map[(size_t)(p - a->arena.base) >> GMK_ALLOC_PAGE_SHIFT] - 1;
+    if (cls != GMK_MAG_BLOCK) return cls;
 
-    /* Determine which region this pointer belongs to */
-    uint8_t *task_base  = a->task_slab.base;
-    uint8_t *trace_base = a->trace_slab.base;
-    uint8_t *block_base = a->block.base;
+    const gmk_block_t *b = gmk_alloc_block_of(a, ptr);
+    if (!b) return -1;
+    int bin = gmk_block_ptr_bin(b, ptr);
+    if (bin >= 0) return GMK_MAG_BLOCK + bin;
+    return gmk_block_large_size(b, ptr) ? GMK_ALLOC_CLASS_LARGE : -1;
+}
+
+size_t gmk_alloc_usable_size(const gmk_alloc_t *a, const void *ptr) {
+    int cls = gmk_alloc_class(a, ptr);
+    if (cls < 0) return 0;
+    if (cls == GMK_ALLOC_CLASS_LARGE)
+        return gmk_block_large_size(gmk_alloc_block_of(a, ptr), ptr);
+    if (cls == GMK_MAG_TASK)  return a->task_slab.obj_size;
+    if (cls == GMK_MAG_TRACE) return a->trace_slab.obj_size;
+    return gmk_block_bin_size(cls - GMK_MAG_BLOCK);
+}
 
-    if (p >= task_base && p < task_base + a->task_slab.total_size) {
-        gmk_slab_free(&a->task_slab, ptr);
-    } else if (p >= trace_base && p < trace_base + a->trace_slab.total_size) {
-        gmk_slab_free(&a->trace_slab, ptr);
-    } else if (p >= block_base && p < block_base + a->block.total_size) {
-        gmk_block_free(&a->block, ptr, size);
+void gmk_free(gmk_alloc_t *a, void *ptr) {
+    /* Bump allocator has no individual free: its pages map to -1 */
+    int cls = gmk_alloc_class(a, ptr);
+    const uint8_t *p = (const uint8_t *)ptr;
+    if (cls < 0 && a && a->peer &&
+        (p < a->arena.base || p >= a->arena.base + a->arena.size)) {
+        /* Another tenant's object (e.g. a payload handed across) */
+        for (gmk_alloc_t *o = a->peer; o != a; o = o->peer) {
+            cls = gmk_alloc_class(o, ptr);
+            if (cls >= 0) {
+                a = o;
+                break;
+            }
+        }
     }
-    /* Bump allocator has no individual free */
+    if (cls == GMK_ALLOC_CLASS_LARGE)
+        gmk_block_large_free(gmk_alloc_block_of(a, ptr), ptr);
+    else if (cls >= 0)
+        gmk_alloc_cache_put(a, (uint32_t)cls, ptr);
+}
+
+void gmk_alloc_link(gmk_alloc_t *a, gmk_alloc_t *peer) {
+    if (!a || !peer || a == peer || peer->peer) return;
+    peer->peer = a->peer ? a->peer : a;
+    a->peer    = peer;
+}
+
+void gmk_alloc_set_metrics(gmk_alloc_t *a, struct gmk_metrics *m, uint16_t tenant) {
+    if (!a) return;
+    a->metrics = m;
+    a->tenant  = tenant;
+}
+
+void gmk_alloc_set_epoch(gmk_alloc_t *a, gmk_epoch_t *e) {
+    if (a) a->epoch = e;
 }
 
 void *gmk_bump(gmk_alloc_t *a, uint32_t size) {
     if (!a) return NULL;
+
+    /* A worker inside a batch bumps its own slice */
+    gmk_epoch_t *e = a->epoch;
+    uint32_t id = gmk_hal_self();
+    if (e && id < a->n_caches && id < e->n_workers) {
+        uint64_t tick = gmk_atomic_load(&e->active[id], memory_order_relaxed);
+        if (tick != GMK_EPOCH_IDLE)
+            return gmk_bump_local_alloc(&a->caches[id]->bump, tick,
+                                        gmk_atomic_load(&e->safe, memory_order_acquire),
+                                        size);
+    }
     return gmk_bump_alloc(&a->bump, size);
 }
 
+int gmk_alloc_set_slab_mode(gmk_alloc_t *a, uint32_t mode) {
+    if (!a) return -1;
+    if (gmk_slab_set_mode(&a->task_slab, mode) != 0) return -1;
+    gmk_slab_set_mode(&a->trace_slab, mode);
+    gmk_block_set_mode(&a->block, mode);
+    for (uint32_t i = 0; i < GMK_ALLOC_MAX_CHUNKS; i++)
+        if (a->chunks[i]) gmk_block_set_mode(a->chunks[i], mode);
+    a->slab_mode = mode;
+    return 0;
+}
+
+int gmk_alloc_set_slab_intrusive(gmk_alloc_t *a, bool on) {
+    if (!a) return -1;
+    if (gmk_slab_set_intrusive(&a->task_slab, on) != 0 ||
+        gmk_slab_set_intrusive(&a->trace_slab, on) != 0 ||
+        gmk_block_set_intrusive(&a->block, on) != 0)
+        return -1;
+    for (uint32_t i = 0; i < GMK_ALLOC_MAX_CHUNKS; i++)
+        if (a->chunks[i] && gmk_block_set_intrusive(a->chunks[i], on) != 0)
+            return -1;
+    a->slab_intrusive = on;
+    return 0;
+}
+
+uint32_t gmk_alloc_rebalance(gmk_alloc_t *a) {
+    if (!a) return 0;
+    uint32_t moved = gmk_block_rebalance(&a->block);
+
+    for (uint32_t i = 0; i < GMK_ALLOC_MAX_CHUNKS; i++) {
+        gmk_block_t *c = chunk_at(a, i);
+        if (!c) continue;
+        moved += gmk_block_rebalance(c);
+        if (gmk_block_live(c) != 0) {
+            a->chunk_idle[i] = 0;
+        } else if (++a->chunk_idle[i] >= GMK_ALLOC_CHUNK_IDLE_PASSES &&
+                   !chunk_release(a, i)) {
+            a->chunk_idle[i] = 0;
+        }
+    }
+    return moved;
+}
+
+/* ── Snapshot ───────────────────────────────────────────────── */
+
+static void slab_stats(const gmk_slab_t *s, gmk_block_stats_t *out) {
+    out->obj_size   = s->obj_size;
+    out->capacity   = s->capacity;
+    out->used       = gmk_slab_used(s);
+    out->high_water = gmk_atomic_load(&s->high_water, memory_order_relaxed);
+    out->segs       = 1;
+    out->pages      = (uint32_t)(s->total_size >> GMK_ALLOC_PAGE_SHIFT);
+}
+
+static void stats_add(gmk_block_stats_t *d, const gmk_block_stats_t *s) {
+    d->capacity   += s->capacity;
+    d->used       += s->used;
+    d->high_water += s->high_water;
+    d->segs       += s->segs;
+    d->pages      += s->pages;
+    d->allocs     += s->allocs;
+    d->req_bytes  += s->req_bytes;
+    d->spills     += s->spills;
+    d->grows      += s->grows;
+}
+
+static inline uint32_t frag_of(uint64_t served, uint64_t req) {
+    return served && served > req ? (uint32_t)(((served - req) * 1000) / served) : 0;
+}
+
+/* Add block b's bins and extents to out; returns extent bytes served. */
+static uint64_t block_stats_add(const gmk_block_t *b, gmk_alloc_stats_t *out) {
+    gmk_block_stats_t st;
+    for (int bin = 0; bin < GMK_BLOCK_BINS; bin++) {
+        gmk_block_stats(b, bin, &st);
+        out->cls[GMK_MAG_BLOCK + bin].obj_size = st.obj_size;
+        stats_add(&out->cls[GMK_MAG_BLOCK + bin], &st);
+    }
+    gmk_block_large_stats(b, &st);
+    stats_add(&out->cls[GMK_ALLOC_CLASS_LARGE], &st);
+    return gmk_atomic_load(&b->large.served_bytes, memory_order_relaxed);
+}
+
+int gmk_alloc_stats(const gmk_alloc_t *a, gmk_alloc_stats_t *out) {
+    if (!a || !out) return -1;
+
+    memset(out, 0, sizeof(*out));
+    slab_stats(&a->task_slab, &out->cls[GMK_MAG_TASK]);
+    slab_stats(&a->trace_slab, &out->cls[GMK_MAG_TRACE]);
+
+    uint64_t large_served = block_stats_add(&a->block, out);
+    for (uint32_t i = 0; i < GMK_ALLOC_MAX_CHUNKS; i++) {
+        const gmk_block_t *c = chunk_at(a, i);
+        if (!c) continue;
+        large_served += block_stats_add(c, out);
+        out->chunks++;
+    }
+
+    uint64_t served = large_served, req = 0;
+    for (uint32_t i = 0; i < GMK_ALLOC_N_CLASSES; i++) {
+        gmk_block_stats_t *c = &out->cls[i];
+        c->fails = gmk_atomic_load(&a->class_fails[i], memory_order_relaxed);
+        if (i == GMK_ALLOC_CLASS_LARGE) {
+            c->frag_permille = frag_of(large_served, c->req_bytes);
+            out->used_bytes += (uint64_t)c->pages << GMK_ALLOC_PAGE_SHIFT;
+        } else {
+            c->frag_permille = frag_of(c->allocs * c->obj_size, c->req_bytes);
+            out->used_bytes += (uint64_t)c->used * c->obj_size;
+            served += c->allocs * c->obj_size;
+        }
+        req += c->req_bytes;
+    }
+    out->frag_permille = frag_of(served, req);
+
+    out->reserved_bytes = a->arena.size +
+        gmk_atomic_load(&a->chunk_bytes, memory_order_relaxed);
+    out->bump_used      = gmk_bump_used(&a->bump);
+    out->bump_size      = (uint32_t)a->bump.size;
+    out->chunk_grows    = gmk_atomic_load(&a->chunk_grows, memory_order_relaxed);
+    out->chunk_releases = gmk_atomic_load(&a->chunk_releases, memory_order_relaxed);
+    out->alloc_bytes    = gmk_atomic_load(&a->total_alloc_bytes, memory_order_relaxed);
+    out->alloc_fails    = gmk_atomic_load(&a->total_alloc_fails, memory_order_relaxed);
+    out->tenant         = a->tenant;
+    return 0;
+}
+
+void gmk_alloc_publish(gmk_alloc_t *a) {
+    if (!a || !a->metrics) return;
+
+    gmk_alloc_stats_t st;
+    gmk_alloc_stats(a, &st);
+
+    /* Deltas wrap when a gauge goes down; the counters wrap back */
+    gmk_metric_inc(a->metrics, a->tenant, GMK_METRIC_ALLOC_IN_USE,
+                   st.used_bytes - a->pub_used);
+    gmk_metric_inc(a->metrics, a->tenant, GMK_METRIC_ALLOC_RESERVED,
+                   st.reserved_bytes - a->pub_reserved);
+    a->pub_used     = st.used_bytes;
+    a->pub_reserved = st.reserved_bytes;
+}
+
 void gmk_bump_reset_all(gmk_alloc_t *a) {
     if (!a) return;
     gmk_bump_reset(&a->bump);
@@ -117,7 +565,8 @@ void gmk_bump_reset_all(gmk_alloc_t *a) {
 /* ── Payload refcounting ────────────────────────────────────── */
 
 void *gmk_payload_alloc(gmk_alloc_t *a, uint32_t size) {
-    if (!a || size == 0) return NULL;
+    if (!a || size == 0 || size > UINT32_MAX - sizeof(gmk_payload_hdr_t))
+        return NULL;
 
     uint32_t total = (uint32_t)sizeof(gmk_payload_hdr_t) + size;
     void *mem = gmk_alloc(a, total);
@@ -125,7 +574,7 @@ void *gmk_payload_alloc(gmk_alloc_t *a, uint32_t size) {
 
     gmk_payload_hdr_t *hdr = (gmk_payload_hdr_t *)mem;
     atomic_init(&hdr->refcount, 1);
-    hdr->size = size;
+    hdr->_pad = 0;
     return (uint8_t *)mem + sizeof(gmk_payload_hdr_t);
 }
 
@@ -144,7 +593,7 @@ int gmk_payload_release(gmk_alloc_t *a, void *payload) {
                                              memory_order_acq_rel);
     if (old == 1) {
         /* Last reference — free the backing allocation */
-        gmk_free(a, hdr, (uint32_t)sizeof(gmk_payload_hdr_t) + hdr->size);
+        gmk_free(a, hdr);
         return 1;
     }
     return 0;
@@ -7,7 +7,7 @@
 int gmk_arena_init(gmk_arena_t *a, size_t size) {
     if (!a || size == 0) return -1;
 
-    a->base = (uint8_t *)gmk_hal_page_alloc(size, GMK_CACHE_LINE);
+    a->base = (uint8_t *)gmk_hal_page_alloc(size, GMK_ALLOC_PAGE);
     if (!a->base) return -1;
 
     a->size = size;
@@ -1,97 +1,648 @@
 /*
- * GGMK/cpu — Power-of-two bin allocator
- * 12 bins: 32, 64, 128, 256, 512, 1K, 2K, 4K, 8K, 16K, 32K, 64K.
- * Each bin is a slab allocator.
+ * GGMK/cpu — Size-class bin allocator
+ * 45 bins: 32, then four classes per power of two up to 64K
+ * (40, 48, 56, 64, 80, ..., 57344, 65536). Each bin owns up to
+ * GMK_BLOCK_SEGS slabs ("segments"), each on a run of whole pages. A
+ * page table at the start of the region maps every page to its segment,
+ * so frees need no size and pages can move between bins.
  */
 #include "ggmk/alloc.h"
 #include <string.h>
 
+#define CLASS4(g) GMK_BLOCK_CLASS_SIZE(4 * (g) + 1), \
+                  GMK_BLOCK_CLASS_SIZE(4 * (g) + 2), \
+                  GMK_BLOCK_CLASS_SIZE(4 * (g) + 3), \
+                  GMK_BLOCK_CLASS_SIZE(4 * (g) + 4)
+
+static const uint32_t class_size[GMK_BLOCK_BINS] = {
+    GMK_BLOCK_CLASS_SIZE(0),
+    CLASS4(0), CLASS4(1), CLASS4(2), CLASS4(3), CLASS4(4), CLASS4(5),
+    CLASS4(6), CLASS4(7), CLASS4(8), CLASS4(9), CLASS4(10),
+};
+
+_Static_assert(GMK_BLOCK_CLASS_SIZE(GMK_BLOCK_BINS - 1) == GMK_BLOCK_MAX_SIZE,
+               "last size class must be GMK_BLOCK_MAX_SIZE");
+
+/*
+ * Memory share per class. Each class of a power-of-two group carries the
+ * group's old single-bin weight, so the split across groups is unchanged;
+ * class 0 (32B) stands alone and carries four times its old weight.
+ */
+static const uint8_t class_weight[GMK_BLOCK_BINS] = {
+    64,
+    12, 12, 12, 12,   8, 8, 8, 8,   6, 6, 6, 6,   4, 4, 4, 4,
+     2,  2,  2,  2,   2, 2, 2, 2,   2, 2, 2, 2,   2, 2, 2, 2,
+     2,  2,  2,  2,   2, 2, 2, 2,   2, 2, 2, 2,
+};
+
 static int bin_index(uint32_t size) {
     if (size <= GMK_BLOCK_MIN_SIZE) return 0;
     if (size > GMK_BLOCK_MAX_SIZE) return -1;
 
-    /* Find the bin: round up to next power of two, then log2 - 5 */
-    uint32_t rounded = gmk_next_pow2(size);
-    int idx = __builtin_ctz(rounded) - 5; /* 32 = 2^5 → bin 0 */
-    if (idx < 0) idx = 0;
-    if (idx >= GMK_BLOCK_BINS) return -1;
-    return idx;
+    /* size lies in (2^g, 2^(g+1)]; the group is split in four steps of
+     * 2^(g-2). 33..64 → bins 1..4 (g = 5). */
+    uint32_t g = 31u - (uint32_t)__builtin_clz(size - 1);
+    uint32_t step = (size - 1 - (1u << g)) >> (g - 2);
+    return 1 + (int)(g - 5) * 4 + (int)step;
 }
 
-int gmk_block_init(gmk_block_t *b, void *mem, size_t mem_size) {
-    if (!b || !mem || mem_size == 0) return -1;
+static inline uint32_t pages_of(size_t bytes) {
+    return (uint32_t)((bytes + GMK_ALLOC_PAGE - 1) >> GMK_ALLOC_PAGE_SHIFT);
+}
+
+/* ── Segments and the page table ────────────────────────────────── */
+#define PAGE_POOL        0        /* free page, owned by the pool        */
+#define PAGE_LARGE_CONT  0xFFFDu  /* later page of a large extent        */
+#define PAGE_LARGE       0xFFFEu  /* first page of a large extent        */
+#define PAGE_META        0xFFFFu  /* page holding the page table itself  */
+
+_Static_assert(GMK_BLOCK_BINS * GMK_BLOCK_SEGS < PAGE_LARGE_CONT,
+               "segment ids must fit the page table");
+_Static_assert(GMK_BLOCK_SEGS <= 32, "seg_mask is 32 bits");
+
+static inline gmk_slab_t *seg_at(gmk_block_t *b, int bin, uint32_t slot) {
+    return slot == 0 ? &b->bins[bin] : &b->segs[bin][slot - 1];
+}
+
+static inline uint16_t seg_code(int bin, uint32_t slot) {
+    return (uint16_t)((uint32_t)bin * GMK_BLOCK_SEGS + slot + 1);
+}
+
+/* Segment code of the page holding ptr, or 0 if none. */
+static inline uint16_t page_code(const gmk_block_t *b, const void *ptr) {
+    const uint8_t *p = (const uint8_t *)ptr;
+    if (!p || p < b->base) return 0;
+    size_t pg = (size_t)(p - b->base) >> GMK_ALLOC_PAGE_SHIFT;
+    if (pg >= b->n_pages) return 0;
+    uint16_t code = b->page_seg[pg];
+    return code >= PAGE_LARGE_CONT ? 0 : code;
+}
+
+/* Page index of ptr if it starts a large extent, else UINT32_MAX. */
+static inline uint32_t large_first_page(const gmk_block_t *b, const void *ptr) {
+    const uint8_t *p = (const uint8_t *)ptr;
+    if (!p || p < b->base) return UINT32_MAX;
+    size_t off = (size_t)(p - b->base);
+    if (off & (GMK_ALLOC_PAGE - 1)) return UINT32_MAX;
+    size_t pg = off >> GMK_ALLOC_PAGE_SHIFT;
+    if (pg >= b->n_pages || b->page_seg[pg] != PAGE_LARGE) return UINT32_MAX;
+    return (uint32_t)pg;
+}
+
+/* Pages in the large extent starting at first. */
+static inline uint32_t large_pages(const gmk_block_t *b, uint32_t first) {
+    uint32_t n = 1;
+    while (first + n < b->n_pages && b->page_seg[first + n] == PAGE_LARGE_CONT)
+        n++;
+    return n;
+}
+
+static inline gmk_slab_t *code_seg(gmk_block_t *b, uint16_t code) {
+    uint32_t id = (uint32_t)code - 1;
+    return seg_at(b, (int)(id / GMK_BLOCK_SEGS), id % GMK_BLOCK_SEGS);
+}
+
+static void pages_set(gmk_block_t *b, uint32_t first, uint32_t n, uint16_t code) {
+    for (uint32_t i = 0; i < n; i++)
+        b->page_seg[first + i] = code;
+}
+
+static inline uint32_t seg_first_page(const gmk_block_t *b, const gmk_slab_t *s) {
+    return (uint32_t)((size_t)(s->base - b->base) >> GMK_ALLOC_PAGE_SHIFT);
+}
+
+/* A slot with no memory: capacity 0 and an empty free list */
+static void seg_mark_empty(gmk_slab_t *s) {
+    memset(s, 0, sizeof(*s));
+    s->capacity = 0;
+    s->mode     = GMK_SLAB_DEFAULT_MODE;
+    atomic_init(&s->free_head, (uint64_t)UINT32_MAX); /* index -1, tag 0 */
+    gmk_lock_init(&s->lock);
+}
+
+/* Put pages [first, first + n) under slot of bin and publish it. */
+static int seg_attach(gmk_block_t *b, int bin, uint32_t slot,
+                      uint32_t first, uint32_t n) {
+    gmk_slab_t *s = seg_at(b, bin, slot);
+    if (gmk_slab_attach(s, b->base + ((size_t)first << GMK_ALLOC_PAGE_SHIFT),
+                        (size_t)n << GMK_ALLOC_PAGE_SHIFT, class_size[bin]) != 0)
+        return -1;
+    pages_set(b, first, n, seg_code(bin, slot));
+    atomic_fetch_or_explicit(&b->seg_mask[bin], 1u << slot, memory_order_release);
+    return 0;
+}
+
+/* ── Page pool (pool_lock held) ─────────────────────────────────── */
+/*
+ * First run of at least want free pages, else the longest run of at
+ * least min pages. Returns the first page and sets *got, or UINT32_MAX.
+ */
+static uint32_t pool_find(const gmk_block_t *b, uint32_t want, uint32_t min,
+                          uint32_t *got) {
+    uint32_t best = UINT32_MAX, best_len = 0;
+    uint32_t run = 0, run_len = 0;
+
+    for (uint32_t pg = 0; pg <= b->n_pages; pg++) {
+        if (pg < b->n_pages && b->page_seg[pg] == PAGE_POOL) {
+            if (run_len++ == 0) run = pg;
+            if (run_len == want) {
+                *got = want;
+                return run;
+            }
+            continue;
+        }
+        if (run_len > best_len) {
+            best     = run;
+            best_len = run_len;
+        }
+        run_len = 0;
+    }
+    if (best_len < min) return UINT32_MAX;
+    *got = best_len;
+    return best;
+}
+
+/*
+ * Give bin a new segment from the pool. Segments double the bin's current
+ * pages, starting at GMK_BLOCK_SEG_MIN, but never take more than half of
+ * the pool at once. Returns the pages taken, or 0.
+ */
+static uint32_t bin_grow_locked(gmk_block_t *b, int bin) {
+    uint32_t mask = gmk_atomic_load(&b->seg_mask[bin], memory_order_relaxed);
+    uint32_t slot = 0;
+    while (slot < GMK_BLOCK_SEGS && (mask & (1u << slot))) slot++;
+    if (slot == GMK_BLOCK_SEGS) return 0;
+
+    uint32_t cur = 0;
+    for (uint32_t i = 0; i < GMK_BLOCK_SEGS; i++)
+        if (mask & (1u << i))
+            cur += (uint32_t)(seg_at(b, bin, i)->total_size >> GMK_ALLOC_PAGE_SHIFT);
+
+    uint32_t min  = pages_of(class_size[bin] + sizeof(int32_t));
+    uint32_t want = cur > pages_of(GMK_BLOCK_SEG_MIN) ? cur
+                                                      : pages_of(GMK_BLOCK_SEG_MIN);
+    uint32_t cap  = gmk_atomic_load(&b->pool_pages, memory_order_relaxed) / 2;
+    if (want > cap) want = cap;
+    if (want < min) want = min;
+
+    uint32_t got;
+    uint32_t first = pool_find(b, want, min, &got);
+    if (first == UINT32_MAX) return 0;
+    if (seg_attach(b, bin, slot, first, got) != 0) return 0;
+
+    gmk_atomic_sub(&b->pool_pages, got, memory_order_relaxed);
+    gmk_atomic_add(&b->acct[bin].grows, 1, memory_order_relaxed);
+    return got;
+}
+
+/* Return slot of bin to the pool if every object is free. Returns the
+ * pages released, or 0. */
+static uint32_t seg_reclaim_locked(gmk_block_t *b, int bin, uint32_t slot) {
+    gmk_slab_t *s = seg_at(b, bin, slot);
+    if (gmk_slab_drain(s) != 0) return 0;
+
+    atomic_fetch_and_explicit(&b->seg_mask[bin], ~(1u << slot),
+                              memory_order_release);
+    uint32_t n = (uint32_t)(s->total_size >> GMK_ALLOC_PAGE_SHIFT);
+    pages_set(b, seg_first_page(b, s), n, PAGE_POOL);
+    gmk_atomic_add(&b->pool_pages, n, memory_order_relaxed);
+    return n;
+}
+
+/* ── Init / destroy ─────────────────────────────────────────────── */
+/* Point b at mem and write a page table with every page pooled. Returns
+ * the number of table pages, or 0 if mem is too small. */
+static uint32_t region_setup(gmk_block_t *b, void *mem, size_t mem_size) {
+    uint32_t n_pages = (uint32_t)(mem_size >> GMK_ALLOC_PAGE_SHIFT);
+    uint32_t meta = pages_of((size_t)n_pages * sizeof(uint16_t));
+    if (n_pages <= meta) return 0;
 
-    memset(b, 0, sizeof(*b));
     b->base       = (uint8_t *)mem;
     b->total_size = mem_size;
+    b->page_seg   = (uint16_t *)mem;
+    pages_set(b, 0, meta, PAGE_META);
+    pages_set(b, meta, n_pages - meta, PAGE_POOL);
+    b->n_pages    = n_pages;
+    return meta;
+}
 
-    /*
-     * Distribute memory across bins. Smaller bins get more objects
-     * because they're used more frequently.
-     */
-    uint32_t weights[GMK_BLOCK_BINS] = {16, 12, 8, 6, 4, 2, 2, 2, 2, 2, 2, 2};
-    uint32_t total_weight = 0;
-    for (int i = 0; i < GMK_BLOCK_BINS; i++)
-        total_weight += weights[i];
+static int block_init(gmk_block_t *b, void *mem, size_t mem_size, bool homes) {
+    if (!b || !mem || mem_size == 0) return -1;
 
-    uint8_t *ptr = b->base;
-    size_t remaining = mem_size;
+    memset(b, 0, sizeof(*b));
+    uint32_t meta = region_setup(b, mem, mem_size);
+    if (meta == 0) return -1;
 
+    gmk_lock_init(&b->pool_lock);
     for (int i = 0; i < GMK_BLOCK_BINS; i++) {
-        size_t bin_mem = (mem_size * weights[i]) / total_weight;
-        if (i == GMK_BLOCK_BINS - 1) bin_mem = remaining;
-        if (bin_mem > remaining) bin_mem = remaining;
-
-        uint32_t obj_size = GMK_BLOCK_MIN_SIZE << i;
-        uint32_t aligned_obj = (obj_size + 7u) & ~7u;
-
-        /* Check if bin has enough memory for at least 1 object */
-        if (bin_mem < (size_t)(aligned_obj + sizeof(int32_t))) {
-            /* Not enough memory for this bin — mark as empty */
-            memset(&b->bins[i], 0, sizeof(b->bins[i]));
-            b->bins[i].capacity = 0;
-            b->bins[i].free_head = -1;
-            gmk_lock_init(&b->bins[i].lock);
-        } else {
-            if (gmk_slab_init(&b->bins[i], ptr, bin_mem, obj_size) != 0) {
-                /* Treat as empty bin, not a fatal error */
-                memset(&b->bins[i], 0, sizeof(b->bins[i]));
-                b->bins[i].capacity = 0;
-                b->bins[i].free_head = -1;
-                gmk_lock_init(&b->bins[i].lock);
-            }
-        }
+        for (uint32_t slot = 0; slot < GMK_BLOCK_SEGS; slot++)
+            seg_mark_empty(seg_at(b, i, slot));
+        atomic_init(&b->seg_mask[i], 0);
+        atomic_init(&b->acct[i].allocs, 0);
+        atomic_init(&b->acct[i].req_bytes, 0);
+        atomic_init(&b->acct[i].spills, 0);
+        atomic_init(&b->acct[i].grows, 0);
+    }
+    atomic_init(&b->large.allocs, 0);
+    atomic_init(&b->large.req_bytes, 0);
+    atomic_init(&b->large.served_bytes, 0);
+    atomic_init(&b->large.fails, 0);
+    atomic_init(&b->large.live, 0);
+    atomic_init(&b->large.pages, 0);
+    atomic_init(&b->large.peak_pages, 0);
 
-        ptr += bin_mem;
-        remaining -= bin_mem;
+    uint32_t usable = b->n_pages - meta;
+    if (!homes) {
+        atomic_init(&b->pool_pages, usable);
+        return 0;
     }
 
+    /*
+     * Home segments. Every class first gets a floor of one object, smallest
+     * classes first while they fit, so the large classes are not starved
+     * in small regions. GMK_BLOCK_RESERVE_PCT of the rest stays in the
+     * pool; the remainder is split by class_weight.
+     */
+    uint32_t floor_pages[GMK_BLOCK_BINS];
+    uint32_t floor_total = 0, total_weight = 0;
+    for (int i = 0; i < GMK_BLOCK_BINS; i++) {
+        floor_pages[i] = pages_of(class_size[i] + sizeof(int32_t));
+        if (floor_total + floor_pages[i] > usable) floor_pages[i] = 0;
+        floor_total  += floor_pages[i];
+        total_weight += class_weight[i];
+    }
+    uint64_t homed = ((uint64_t)(usable - floor_total) *
+                      (100 - GMK_BLOCK_RESERVE_PCT)) / 100;
+
+    uint32_t start = 0, cum_floor = 0, cum_weight = 0, used = 0;
+    for (int i = 0; i < GMK_BLOCK_BINS; i++) {
+        cum_floor  += floor_pages[i];
+        cum_weight += class_weight[i];
+        uint32_t end = cum_floor + (uint32_t)((homed * cum_weight + total_weight / 2)
+                                              / total_weight);
+        if (end > usable) end = usable;
+        if (end < start) end = start;
+        uint32_t n = end - start;
+
+        /* Too small for one object: the pages stay in the pool */
+        if (n > 0 && n >= floor_pages[i] &&
+            ((size_t)n << GMK_ALLOC_PAGE_SHIFT) >= class_size[i] + sizeof(int32_t) &&
+            seg_attach(b, i, 0, meta + start, n) == 0)
+            used += n;
+
+        start = end;
+    }
+    atomic_init(&b->pool_pages, usable - used);
     return 0;
 }
 
+int gmk_block_init(gmk_block_t *b, void *mem, size_t mem_size) {
+    return block_init(b, mem, mem_size, true);
+}
+
+int gmk_block_init_pooled(gmk_block_t *b, void *mem, size_t mem_size) {
+    return block_init(b, mem, mem_size, false);
+}
+
+int gmk_block_retire(gmk_block_t *b) {
+    if (!b || !b->base) return -1;
+
+    gmk_lock_acquire(&b->pool_lock);
+    int rc = -1;
+    if (gmk_atomic_load(&b->large.live, memory_order_relaxed) != 0)
+        goto out;
+
+    /* Reclaim every segment; any still in use (or LOCKFREE) keeps the
+     * block alive, and the segments already reclaimed simply stay pooled */
+    for (int bin = 0; bin < GMK_BLOCK_BINS; bin++) {
+        uint32_t mask = gmk_atomic_load(&b->seg_mask[bin], memory_order_relaxed);
+        for (uint32_t slot = 0; slot < GMK_BLOCK_SEGS; slot++) {
+            if ((mask & (1u << slot)) && seg_reclaim_locked(b, bin, slot) == 0)
+                goto out;
+        }
+    }
+
+    /* Nothing left: allocators now see zero pages and an empty pool */
+    b->n_pages = 0;
+    gmk_atomic_store(&b->pool_pages, 0, memory_order_relaxed);
+    rc = 0;
+out:
+    gmk_lock_release(&b->pool_lock);
+    return rc;
+}
+
+int gmk_block_reattach(gmk_block_t *b, void *mem, size_t mem_size) {
+    if (!b || !mem || b->n_pages != 0) return -1;
+
+    gmk_lock_acquire(&b->pool_lock);
+    uint32_t meta = region_setup(b, mem, mem_size);
+    if (meta > 0)
+        gmk_atomic_store(&b->pool_pages, b->n_pages - meta, memory_order_relaxed);
+    gmk_lock_release(&b->pool_lock);
+    return meta > 0 ? 0 : -1;
+}
+
+uint32_t gmk_block_live(const gmk_block_t *b) {
+    if (!b) return 0;
+    uint32_t live = gmk_atomic_load(&b->large.live, memory_order_relaxed);
+    for (int bin = 0; bin < GMK_BLOCK_BINS; bin++) {
+        uint32_t mask = gmk_atomic_load(&b->seg_mask[bin], memory_order_acquire);
+        for (uint32_t slot = 0; slot < GMK_BLOCK_SEGS; slot++)
+            if (mask & (1u << slot))
+                live += gmk_slab_used(slot == 0 ? &b->bins[bin]
+                                                : &b->segs[bin][slot - 1]);
+    }
+    return live;
+}
+
 void gmk_block_destroy(gmk_block_t *b) {
-    if (!b) return;
-    for (int i = 0; i < GMK_BLOCK_BINS; i++) {
-        if (b->bins[i].capacity > 0)
-            gmk_slab_destroy(&b->bins[i]);
-        else
-            gmk_lock_destroy(&b->bins[i].lock);
+    if (!b || !b->base) return;
+    for (int i = 0; i < GMK_BLOCK_BINS; i++)
+        for (uint32_t slot = 0; slot < GMK_BLOCK_SEGS; slot++)
+            gmk_slab_destroy(seg_at(b, i, slot));
+    gmk_lock_destroy(&b->pool_lock);
+    b->base     = NULL;
+    b->page_seg = NULL;
+}
+
+/* ── Size classes ───────────────────────────────────────────────── */
+int gmk_block_bin(uint32_t size) {
+    if (size == 0) return -1;
+    return bin_index(size);
+}
+
+uint32_t gmk_block_bin_size(int bin) {
+    if (bin < 0 || bin >= GMK_BLOCK_BINS) return 0;
+    return class_size[bin];
+}
+
+int gmk_block_ptr_bin(const gmk_block_t *b, const void *ptr) {
+    if (!b) return -1;
+    uint16_t code = page_code(b, ptr);
+    if (code == 0) return -1;
+    return (int)(((uint32_t)code - 1) / GMK_BLOCK_SEGS);
+}
+
+void gmk_block_account(gmk_block_t *b, const void *ptr, uint32_t size) {
+    int bin = gmk_block_ptr_bin(b, ptr);
+    if (bin < 0) return;
+    gmk_atomic_add(&b->acct[bin].allocs, 1, memory_order_relaxed);
+    gmk_atomic_add(&b->acct[bin].req_bytes, size, memory_order_relaxed);
+}
+
+/* ── Alloc / free ───────────────────────────────────────────────── */
+/* Take up to n objects from the live segments of bin. */
+static uint32_t bin_pop_n(gmk_block_t *b, int bin, void **out, uint32_t n) {
+    uint32_t mask = gmk_atomic_load(&b->seg_mask[bin], memory_order_acquire);
+    uint32_t got = 0;
+    while (mask && got < n) {
+        uint32_t slot = (uint32_t)__builtin_ctz(mask);
+        mask &= mask - 1;
+        got += gmk_slab_alloc_n(seg_at(b, bin, slot), out + got, n - got);
     }
-    b->base = NULL;
+    return got;
+}
+
+uint32_t gmk_block_alloc_n(gmk_block_t *b, int bin, void **out, uint32_t n) {
+    if (!b || !out || n == 0 || bin < 0 || bin >= GMK_BLOCK_BINS) return 0;
+
+    uint32_t seen = gmk_atomic_load(&b->seg_mask[bin], memory_order_acquire);
+    uint32_t got = bin_pop_n(b, bin, out, n);
+    if (got > 0) return got;
+
+    /* Dry: grow from the pool unless another thread just did */
+    gmk_lock_acquire(&b->pool_lock);
+    if (gmk_atomic_load(&b->seg_mask[bin], memory_order_relaxed) == seen)
+        bin_grow_locked(b, bin);
+    gmk_lock_release(&b->pool_lock);
+
+    got = bin_pop_n(b, bin, out, n);
+    if (got > 0) return got;
+
+    /* Pool dry too: borrow from the next larger classes */
+    for (int s = bin + 1; s <= bin + GMK_BLOCK_SPILL && s < GMK_BLOCK_BINS; s++) {
+        got = bin_pop_n(b, s, out, n);
+        if (got > 0) {
+            gmk_atomic_add(&b->acct[bin].spills, got, memory_order_relaxed);
+            return got;
+        }
+    }
+    return 0;
 }
 
 void *gmk_block_alloc(gmk_block_t *b, uint32_t size) {
     if (!b || size == 0) return NULL;
     int idx = bin_index(size);
     if (idx < 0) return NULL;
-    if (b->bins[idx].capacity == 0) return NULL;
-    return gmk_slab_alloc(&b->bins[idx]);
+
+    void *ptr;
+    if (gmk_block_alloc_n(b, idx, &ptr, 1) == 0) return NULL;
+    gmk_block_account(b, ptr, size);
+    return ptr;
 }
 
 void gmk_block_free(gmk_block_t *b, void *ptr, uint32_t size) {
-    if (!b || !ptr || size == 0) return;
-    int idx = bin_index(size);
-    if (idx < 0) return;
-    if (b->bins[idx].capacity == 0) return;
-    gmk_slab_free(&b->bins[idx], ptr);
+    (void)size;
+    if (!b || !ptr) return;
+    uint16_t code = page_code(b, ptr);
+    if (code == 0) {
+        gmk_block_large_free(b, ptr);
+        return;
+    }
+    gmk_slab_free(code_seg(b, code), ptr);
+}
+
+void gmk_block_free_n(gmk_block_t *b, void *const *ptrs, uint32_t n) {
+    if (!b || !ptrs) return;
+
+    /* One slab call per run of pointers from the same segment */
+    uint32_t i = 0;
+    while (i < n) {
+        uint16_t code = page_code(b, ptrs[i]);
+        if (code == 0) {
+            i++;
+            continue;
+        }
+        uint32_t j = i + 1;
+        while (j < n && page_code(b, ptrs[j]) == code) j++;
+        gmk_slab_free_n(code_seg(b, code), ptrs + i, j - i);
+        i = j;
+    }
+}
+
+/* ── Large extents ──────────────────────────────────────────────── */
+void *gmk_block_large_alloc(gmk_block_t *b, size_t size) {
+    if (!b || !b->base || size == 0) return NULL;
+
+    size_t want = ((size_t)size + GMK_ALLOC_PAGE - 1) >> GMK_ALLOC_PAGE_SHIFT;
+    uint32_t first = UINT32_MAX, got = 0;
+
+    gmk_lock_acquire(&b->pool_lock);
+    if (want <= gmk_atomic_load(&b->pool_pages, memory_order_relaxed))
+        first = pool_find(b, (uint32_t)want, (uint32_t)want, &got);
+    if (first != UINT32_MAX) {
+        b->page_seg[first] = PAGE_LARGE;
+        pages_set(b, first + 1, got - 1, PAGE_LARGE_CONT);
+        gmk_atomic_sub(&b->pool_pages, got, memory_order_relaxed);
+    }
+    gmk_lock_release(&b->pool_lock);
+
+    if (first == UINT32_MAX) {
+        gmk_atomic_add(&b->large.fails, 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    gmk_atomic_add(&b->large.allocs, 1, memory_order_relaxed);
+    gmk_atomic_add(&b->large.req_bytes, size, memory_order_relaxed);
+    gmk_atomic_add(&b->large.served_bytes, (uint64_t)got << GMK_ALLOC_PAGE_SHIFT,
+                   memory_order_relaxed);
+    gmk_atomic_add(&b->large.live, 1, memory_order_relaxed);
+    uint32_t pages = gmk_atomic_add(&b->large.pages, got, memory_order_relaxed) + got;
+    if (pages > gmk_atomic_load(&b->large.peak_pages, memory_order_relaxed))
+        gmk_atomic_store(&b->large.peak_pages, pages, memory_order_relaxed);
+
+    return b->base + ((size_t)first << GMK_ALLOC_PAGE_SHIFT);
+}
+
+void gmk_block_large_free(gmk_block_t *b, void *ptr) {
+    if (!b || !ptr) return;
+
+    gmk_lock_acquire(&b->pool_lock);
+    uint32_t first = large_first_page(b, ptr);
+    uint32_t n = 0;
+    if (first != UINT32_MAX) {
+        n = large_pages(b, first);
+        pages_set(b, first, n, PAGE_POOL);
+        gmk_atomic_add(&b->pool_pages, n, memory_order_relaxed);
+    }
+    gmk_lock_release(&b->pool_lock);
+
+    if (n > 0) {
+        gmk_atomic_sub(&b->large.live, 1, memory_order_relaxed);
+        gmk_atomic_sub(&b->large.pages, n, memory_order_relaxed);
+    }
+}
+
+size_t gmk_block_large_size(const gmk_block_t *b, const void *ptr) {
+    if (!b) return 0;
+    uint32_t first = large_first_page(b, ptr);
+    if (first == UINT32_MAX) return 0;
+    return (size_t)large_pages(b, first) << GMK_ALLOC_PAGE_SHIFT;
+}
+
+void gmk_block_large_stats(const gmk_block_t *b, gmk_block_stats_t *out) {
+    if (!b || !out) return;
+
+    memset(out, 0, sizeof(*out));
+    out->capacity   = gmk_atomic_load(&b->pool_pages, memory_order_relaxed);
+    out->used       = gmk_atomic_load(&b->large.live, memory_order_relaxed);
+    out->pages      = gmk_atomic_load(&b->large.pages, memory_order_relaxed);
+    out->high_water = gmk_atomic_load(&b->large.peak_pages, memory_order_relaxed);
+    out->allocs     = gmk_atomic_load(&b->large.allocs, memory_order_relaxed);
+    out->req_bytes  = gmk_atomic_load(&b->large.req_bytes, memory_order_relaxed);
+    out->fails      = gmk_atomic_load(&b->large.fails, memory_order_relaxed);
+
+    uint64_t served = gmk_atomic_load(&b->large.served_bytes, memory_order_relaxed);
+    out->frag_permille = served && served > out->req_bytes
+        ? (uint32_t)(((served - out->req_bytes) * 1000) / served) : 0;
+}
+
+/* ── Rebalancing ────────────────────────────────────────────────── */
+/*
+ * Demand is the number of objects a bin handed out since the last pass.
+ * A fully free segment goes back to the pool when the bin's other free
+ * objects still cover that demand (so idle bins give up everything they
+ * are not using). A bin whose demand exceeded its free objects gets a
+ * segment ahead of time so its next burst does not hit the slow path.
+ * LOCKFREE segments are never reclaimed (see gmk_slab_drain).
+ */
+uint32_t gmk_block_rebalance(gmk_block_t *b) {
+    if (!b || !b->base) return 0;
+
+    uint64_t demand[GMK_BLOCK_BINS];
+    uint64_t free_objs[GMK_BLOCK_BINS];
+    uint32_t moved = 0;
+
+    gmk_lock_acquire(&b->pool_lock);
+
+    for (int bin = 0; bin < GMK_BLOCK_BINS; bin++) {
+        uint64_t allocs = gmk_atomic_load(&b->acct[bin].allocs, memory_order_relaxed);
+        demand[bin] = allocs - b->rb_allocs[bin];
+        b->rb_allocs[bin] = allocs;
+
+        uint32_t mask = gmk_atomic_load(&b->seg_mask[bin], memory_order_relaxed);
+        free_objs[bin] = 0;
+        for (uint32_t slot = 0; slot < GMK_BLOCK_SEGS; slot++) {
+            if (!(mask & (1u << slot))) continue;
+            gmk_slab_t *s = seg_at(b, bin, slot);
+            uint32_t used = gmk_slab_used(s);
+            if (used < s->capacity) free_objs[bin] += s->capacity - used;
+        }
+
+        /* Newest segments first: they are the smallest and coldest */
+        for (uint32_t slot = GMK_BLOCK_SEGS; slot-- > 0; ) {
+            if (!(mask & (1u << slot))) continue;
+            gmk_slab_t *s = seg_at(b, bin, slot);
+            uint32_t cap = s->capacity;
+            if (gmk_slab_used(s) != 0 || free_objs[bin] < cap + demand[bin])
+                continue;
+            uint32_t n = seg_reclaim_locked(b, bin, slot);
+            if (n > 0) {
+                moved += n;
+                free_objs[bin] -= cap;
+            }
+        }
+    }
+
+    for (int bin = 0; bin < GMK_BLOCK_BINS; bin++) {
+        if (demand[bin] > free_objs[bin])
+            moved += bin_grow_locked(b, bin);
+    }
+
+    gmk_lock_release(&b->pool_lock);
+    return moved;
+}
+
+int gmk_block_set_mode(gmk_block_t *b, uint32_t mode) {
+    if (!b) return -1;
+    for (int i = 0; i < GMK_BLOCK_BINS; i++)
+        for (uint32_t slot = 0; slot < GMK_BLOCK_SEGS; slot++)
+            if (gmk_slab_set_mode(seg_at(b, i, slot), mode) != 0) return -1;
+    return 0;
+}
+
+int gmk_block_set_intrusive(gmk_block_t *b, bool on) {
+    if (!b) return -1;
+    for (int i = 0; i < GMK_BLOCK_BINS; i++)
+        for (uint32_t slot = 0; slot < GMK_BLOCK_SEGS; slot++)
+            if (gmk_slab_set_intrusive(seg_at(b, i, slot), on) != 0) return -1;
+    return 0;
+}
+
+/* ── Stats ──────────────────────────────────────────────────────── */
+int gmk_block_stats(const gmk_block_t *b, int bin, gmk_block_stats_t *out) {
+    if (!b || !out || bin < 0 || bin >= GMK_BLOCK_BINS) return -1;
+
+    memset(out, 0, sizeof(*out));
+    out->obj_size = class_size[bin];
+
+    uint32_t mask = gmk_atomic_load(&b->seg_mask[bin], memory_order_acquire);
+    for (uint32_t slot = 0; slot < GMK_BLOCK_SEGS; slot++) {
+        if (!(mask & (1u << slot))) continue;
+        const gmk_slab_t *s = slot == 0 ? &b->bins[bin] : &b->segs[bin][slot - 1];
+        out->capacity   += s->capacity;
+        out->used       += gmk_slab_used(s);
+        out->high_water += gmk_atomic_load(&s->high_water, memory_order_relaxed);
+        out->pages      += (uint32_t)(s->total_size >> GMK_ALLOC_PAGE_SHIFT);
+        out->segs++;
+    }
+    out->allocs    = gmk_atomic_load(&b->acct[bin].allocs, memory_order_relaxed);
+    out->req_bytes = gmk_atomic_load(&b->acct[bin].req_bytes, memory_order_relaxed);
+    out->spills    = gmk_atomic_load(&b->acct[bin].spills, memory_order_relaxed);
+    out->grows     = gmk_atomic_load(&b->acct[bin].grows, memory_order_relaxed);
+
+    uint64_t served = out->allocs * out->obj_size;
+    out->frag_permille = served && served > out->req_bytes
+        ? (uint32_t)(((served - out->req_bytes) * 1000) / served) : 0;
+    return 0;
 }
@@ -1,8 +1,10 @@
 /*
  * GGMK/cpu — Bump allocator (atomic offset)
  * Fast, lock-free. Reset sets offset to 0.
+ * Worker slices bump a plain offset and rewind by tick epoch.
  */
 #include "ggmk/alloc.h"
+#include "ggmk/hal.h"
 
 int gmk_bump_init(gmk_bump_t *b, void *mem, size_t mem_size) {
     if (!b || !mem || mem_size == 0) return -1;
@@ -43,3 +45,85 @@ void gmk_bump_reset(gmk_bump_t *b) {
 uint32_t gmk_bump_used(const gmk_bump_t *b) {
     return gmk_atomic_load(&b->offset, memory_order_relaxed);
 }
+
+/* ── Tick epochs ────────────────────────────────────────────────── */
+int gmk_epoch_init(gmk_epoch_t *e, uint32_t n_workers) {
+    if (!e || n_workers == 0) return -1;
+    e->active = (_Atomic(uint64_t) *)gmk_hal_calloc(n_workers, sizeof(*e->active));
+    if (!e->active) return -1;
+    for (uint32_t i = 0; i < n_workers; i++)
+        atomic_init(&e->active[i], GMK_EPOCH_IDLE);
+    e->n_workers = n_workers;
+    atomic_init(&e->safe, 0);
+    return 0;
+}
+
+void gmk_epoch_destroy(gmk_epoch_t *e) {
+    if (!e || !e->active) return;
+    gmk_hal_free(e->active);
+    e->active    = NULL;
+    e->n_workers = 0;
+}
+
+uint64_t gmk_epoch_enter(gmk_epoch_t *e, uint32_t worker, _Atomic(uint64_t) *tick) {
+    uint64_t t = gmk_atomic_load(tick, memory_order_acquire);
+    if (!e || worker >= e->n_workers) return t;
+
+    /* Store, then re-read: either gmk_epoch_advance sees us, or we see
+     * its tick and enter that one instead */
+    for (;;) {
+        gmk_atomic_store(&e->active[worker], t, memory_order_seq_cst);
+        uint64_t now = gmk_atomic_load(tick, memory_order_seq_cst);
+        if (now == t) return t;
+        t = now;
+    }
+}
+
+void gmk_epoch_exit(gmk_epoch_t *e, uint32_t worker) {
+    if (!e || worker >= e->n_workers) return;
+    gmk_atomic_store(&e->active[worker], GMK_EPOCH_IDLE, memory_order_release);
+}
+
+uint64_t gmk_epoch_advance(gmk_epoch_t *e, uint64_t tick) {
+    if (!e) return 0;
+    atomic_thread_fence(memory_order_seq_cst);
+
+    uint64_t safe = tick;
+    for (uint32_t i = 0; i < e->n_workers; i++) {
+        uint64_t t = gmk_atomic_load(&e->active[i], memory_order_seq_cst);
+        if (t != GMK_EPOCH_IDLE && t < safe)
+            safe = t;
+    }
+    /* Ticks only move forward; a late caller must not lower it */
+    uint64_t cur = gmk_atomic_load(&e->safe, memory_order_relaxed);
+    while (safe > cur &&
+           !gmk_atomic_cas_weak(&e->safe, &cur, safe,
+                                memory_order_release, memory_order_relaxed))
+        ;
+    return gmk_atomic_load(&e->safe, memory_order_relaxed);
+}
+
+/* ── Worker slices ──────────────────────────────────────────────── */
+void *gmk_bump_local_alloc(gmk_bump_local_t *b, uint64_t tick, uint64_t safe,
+                           uint32_t size) {
+    if (!b || size == 0) return NULL;
+
+    if (b->tick != tick) {
+        if (b->offset != 0 && b->tick < safe) {
+            b->offset = 0;
+            b->resets++;
+        }
+        b->tick = tick;
+    }
+
+    size = (size + 7u) & ~7u;
+    if (size > b->size - b->offset) {
+        b->fails++;
+        return NULL;
+    }
+    void *ptr = b->base + b->offset;
+    b->offset += size;
+    if (b->offset > b->high_water)
+        b->high_water = b->offset;
+    return ptr;
+}
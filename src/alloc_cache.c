@@ -0,0 +1,122 @@
+/*
+ * GGMK/cpu — Per-worker slab magazines
+ *
+ * Each worker owns one bounded LIFO of free objects per slab. Alloc pops
+ * from it and refills half a magazine under one slab lock when empty;
+ * free pushes to it and flushes the older half when full, so a worker
+ * that only frees (remote frees from a producer on another worker) still
+ * returns objects in batches. The worker id comes from gmk_hal_self().
+ */
+#include "ggmk/alloc.h"
+#include "ggmk/hal.h"
+
+/* Shared-pool side of a magazine: a plain slab, or a block bin whose
+ * objects may come from any of its segments (or a spill bin), in the
+ * arena or in any elastic chunk. */
+static uint32_t pool_take(gmk_alloc_t *a, uint32_t mag, void **out, uint32_t n) {
+    if (mag == GMK_MAG_TASK)  return gmk_slab_alloc_n(&a->task_slab, out, n);
+    if (mag == GMK_MAG_TRACE) return gmk_slab_alloc_n(&a->trace_slab, out, n);
+    return gmk_alloc_block_alloc_n(a, (int)(mag - GMK_MAG_BLOCK), out, n);
+}
+
+static void pool_give(gmk_alloc_t *a, uint32_t mag, void *const *ptrs, uint32_t n) {
+    if (mag == GMK_MAG_TASK)       gmk_slab_free_n(&a->task_slab, ptrs, n);
+    else if (mag == GMK_MAG_TRACE) gmk_slab_free_n(&a->trace_slab, ptrs, n);
+    else                           gmk_alloc_block_free_n(a, ptrs, n);
+}
+
+/* Caller's magazine, or NULL when the caller has no cache. */
+static gmk_mag_t *self_mag(gmk_alloc_t *a, uint32_t mag) {
+    uint32_t id = gmk_hal_self();
+    if (id >= a->n_caches) return NULL;
+    return &a->caches[id]->mags[mag];
+}
+
+int gmk_alloc_cache_init(gmk_alloc_t *a, uint32_t n_workers) {
+    if (!a || n_workers == 0) return -1;
+
+    a->caches = (gmk_alloc_cache_t **)gmk_hal_calloc(n_workers,
+                                                     sizeof(gmk_alloc_cache_t *));
+    if (!a->caches) return -1;
+    a->n_caches = n_workers;
+
+    /* Whole pages per worker, so each set lands on its worker's node */
+    for (uint32_t i = 0; i < n_workers; i++) {
+        int prev = gmk_hal_mem_node(gmk_hal_worker_node(i));
+        a->caches[i] = (gmk_alloc_cache_t *)gmk_hal_page_alloc(
+            sizeof(gmk_alloc_cache_t), GMK_ALLOC_PAGE);
+        gmk_hal_mem_node(prev);
+        if (!a->caches[i]) {
+            gmk_alloc_cache_destroy(a);
+            return -1;
+        }
+    }
+
+    /* Bump slices: the shared region keeps the first share and the tail */
+    uint8_t *base  = a->bump.base;
+    size_t   share = (a->bump.size / (n_workers + 1)) & ~(size_t)(GMK_ALLOC_PAGE - 1);
+    if (share > UINT32_MAX) share = UINT32_MAX & ~(size_t)(GMK_ALLOC_PAGE - 1);
+    if (share > 0) {
+        size_t shared = a->bump.size - share * n_workers;
+        gmk_bump_init(&a->bump, base, shared);
+        for (uint32_t i = 0; i < n_workers; i++) {
+            gmk_bump_local_t *b = &a->caches[i]->bump;
+            b->base = base + shared + share * i;
+            b->size = (uint32_t)share;
+            gmk_hal_mem_bind(b->base, share, gmk_hal_worker_node(i));
+        }
+    }
+    return 0;
+}
+
+void gmk_alloc_cache_destroy(gmk_alloc_t *a) {
+    if (!a || !a->caches) return;
+    for (uint32_t i = 0; i < a->n_caches; i++)
+        gmk_hal_page_free(a->caches[i], sizeof(gmk_alloc_cache_t));
+    gmk_hal_free(a->caches);
+    a->caches   = NULL;
+    a->n_caches = 0;
+}
+
+void gmk_alloc_cache_flush(gmk_alloc_t *a, uint32_t worker_id) {
+    if (!a || worker_id >= a->n_caches) return;
+
+    gmk_alloc_cache_t *c = a->caches[worker_id];
+    for (uint32_t i = 0; i < GMK_ALLOC_N_MAGS; i++) {
+        gmk_mag_t *m = &c->mags[i];
+        if (m->count == 0) continue;
+        pool_give(a, i, m->objs, m->count);
+        m->count = 0;
+    }
+}
+
+void *gmk_alloc_cache_get(gmk_alloc_t *a, uint32_t mag) {
+    gmk_mag_t *m = self_mag(a, mag);
+    if (!m) {
+        void *ptr;
+        return pool_take(a, mag, &ptr, 1) ? ptr : NULL;
+    }
+
+    if (m->count == 0) {
+        m->count = pool_take(a, mag, m->objs, GMK_ALLOC_MAG_BATCH);
+        if (m->count == 0) return NULL;
+    }
+    return m->objs[--m->count];
+}
+
+void gmk_alloc_cache_put(gmk_alloc_t *a, uint32_t mag, void *ptr) {
+    gmk_mag_t *m = self_mag(a, mag);
+    if (!m) {
+        pool_give(a, mag, &ptr, 1);
+        return;
+    }
+
+    if (m->count == GMK_ALLOC_MAG_SIZE) {
+        /* Full: return the coldest half, keep the recently freed ones */
+        pool_give(a, mag, m->objs, GMK_ALLOC_MAG_BATCH);
+        gmk_hal_memcpy(m->objs, m->objs + GMK_ALLOC_MAG_BATCH,
+                       (GMK_ALLOC_MAG_SIZE - GMK_ALLOC_MAG_BATCH) * sizeof(void *));
+        m->count -= GMK_ALLOC_MAG_BATCH;
+    }
+    m->objs[m->count++] = ptr;
+}
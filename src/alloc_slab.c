@@ -1,42 +1,236 @@
 /*
  * GGMK/cpu — Fixed-size slab allocator with free list
- * Lock-protected. Index-based free list.
+ * Index-based free list, with the links either in an array after the
+ * objects or in the free objects themselves. LOCKED and SPIN modes
+ * pop/push under a lock;
+ * LOCKFREE mode runs a Treiber stack over the same indices, with an ABA
+ * tag packed above the head index in one 64-bit word.
+ * Objects nobody has freed yet are not on the list: allocation falls back
+ * to bumping the fresh index once the list is empty.
  */
 #include "ggmk/alloc.h"
 #include <stdlib.h>
 #include <string.h>
 
-int gmk_slab_init(gmk_slab_t *s, void *mem, size_t mem_size, uint32_t obj_size) {
-    if (!s || !mem || obj_size == 0) return -1;
+/* ── free_head encoding: tag << 32 | (uint32_t)index ─────────────── */
+static inline uint64_t head_pack(uint32_t tag, int32_t idx) {
+    return ((uint64_t)tag << 32) | (uint32_t)idx;
+}
+
+static inline int32_t head_idx(uint64_t h) {
+    return (int32_t)(uint32_t)h;
+}
+
+static inline uint32_t head_tag(uint64_t h) {
+    return (uint32_t)(h >> 32);
+}
+
+static inline void *obj_at(const gmk_slab_t *s, int32_t idx) {
+    return s->base + (size_t)idx * s->obj_size;
+}
+
+/* Link word of free object idx. In LOCKFREE mode a popper may read the
+ * link of an object another thread just took and is writing; the tag
+ * check then discards the value. */
+static inline _Atomic(int32_t) *link_of(const gmk_slab_t *s, int32_t idx) {
+    if (s->intrusive)
+        return (_Atomic(int32_t) *)obj_at(s, idx);
+    return &s->free_list[idx];
+}
+
+static inline int32_t next_of(const gmk_slab_t *s, int32_t idx) {
+    return gmk_atomic_load(link_of(s, idx), memory_order_relaxed);
+}
+
+static inline void set_next(gmk_slab_t *s, int32_t idx, int32_t next) {
+    gmk_atomic_store(link_of(s, idx), next, memory_order_relaxed);
+}
+
+/* Object index for ptr, or -1 if ptr is not one of ours. */
+static inline int32_t obj_index(const gmk_slab_t *s, const void *ptr) {
+    const uint8_t *p = (const uint8_t *)ptr;
+    if (!p || p < s->base) return -1;
+    uint32_t idx = (uint32_t)((size_t)(p - s->base) / s->obj_size);
+    if (idx >= s->capacity) return -1;
+    return (int32_t)idx;
+}
+
+/* ── Locking (LOCKED / SPIN) ────────────────────────────────────── */
+static inline void slab_lock(gmk_slab_t *s) {
+    if (s->mode == GMK_SLAB_SPIN) {
+        while (atomic_exchange_explicit(&s->spin, true, memory_order_acquire)) {
+            while (gmk_atomic_load(&s->spin, memory_order_relaxed))
+                gmk_cpu_relax();
+        }
+    } else {
+        gmk_lock_acquire(&s->lock);
+    }
+}
+
+static inline void slab_unlock(gmk_slab_t *s) {
+    if (s->mode == GMK_SLAB_SPIN)
+        gmk_atomic_store(&s->spin, false, memory_order_release);
+    else
+        gmk_lock_release(&s->lock);
+}
+
+/* Pop under the lock. Returns -1 if empty. */
+static int32_t pop_locked(gmk_slab_t *s) {
+    uint64_t h = gmk_atomic_load(&s->free_head, memory_order_relaxed);
+    int32_t idx = head_idx(h);
+    if (idx < 0) return -1;
+    gmk_atomic_store(&s->free_head, head_pack(head_tag(h) + 1, next_of(s, idx)),
+                     memory_order_relaxed);
+    return idx;
+}
+
+/* Push the chain first..last (already linked) under the lock. */
+static void push_locked(gmk_slab_t *s, int32_t first, int32_t last) {
+    uint64_t h = gmk_atomic_load(&s->free_head, memory_order_relaxed);
+    set_next(s, last, head_idx(h));
+    gmk_atomic_store(&s->free_head, head_pack(head_tag(h) + 1, first),
+                     memory_order_relaxed);
+}
+
+/* ── Lock-free (Treiber) ────────────────────────────────────────── */
+static int32_t pop_lockfree(gmk_slab_t *s) {
+    uint64_t h = gmk_atomic_load(&s->free_head, memory_order_acquire);
+    for (;;) {
+        int32_t idx = head_idx(h);
+        if (idx < 0) return -1;
+        /* May read a stale next if idx was popped meanwhile; the tag
+         * makes the CAS fail in that case */
+        uint64_t want = head_pack(head_tag(h) + 1, next_of(s, idx));
+        if (gmk_atomic_cas_weak(&s->free_head, &h, want,
+                                 memory_order_acquire, memory_order_acquire))
+            return idx;
+    }
+}
+
+static void push_lockfree(gmk_slab_t *s, int32_t first, int32_t last) {
+    uint64_t h = gmk_atomic_load(&s->free_head, memory_order_relaxed);
+    for (;;) {
+        set_next(s, last, head_idx(h));
+        if (gmk_atomic_cas_weak(&s->free_head, &h,
+                                 head_pack(head_tag(h) + 1, first),
+                                 memory_order_release, memory_order_relaxed))
+            return;
+    }
+}
+
+/* ── Bump (never-allocated objects) ─────────────────────────────── */
+/* Take up to n fresh indices under the lock; returns the first, count in *got. */
+static int32_t fresh_locked(gmk_slab_t *s, uint32_t n, uint32_t *got) {
+    uint32_t f = gmk_atomic_load(&s->fresh, memory_order_relaxed);
+    uint32_t left = f < s->capacity ? s->capacity - f : 0; /* drained: 0 */
+    uint32_t k = left < n ? left : n;
+    *got = k;
+    if (k == 0) return -1;
+    gmk_atomic_store(&s->fresh, f + k, memory_order_relaxed);
+    return (int32_t)f;
+}
+
+static int32_t fresh_lockfree(gmk_slab_t *s, uint32_t n, uint32_t *got) {
+    uint32_t f = gmk_atomic_load(&s->fresh, memory_order_relaxed);
+    for (;;) {
+        uint32_t left = f < s->capacity ? s->capacity - f : 0;
+        uint32_t k = left < n ? left : n;
+        *got = k;
+        if (k == 0) return -1;
+        if (gmk_atomic_cas_weak(&s->fresh, &f, f + k,
+                                 memory_order_relaxed, memory_order_relaxed))
+            return (int32_t)f;
+    }
+}
+
+/* ── Accounting ─────────────────────────────────────────────────── */
+static inline void count_alloc(gmk_slab_t *s, uint32_t n) {
+    uint32_t count = gmk_atomic_add(&s->alloc_count, n, memory_order_relaxed) + n;
+    /* Exact under the lock; best effort in LOCKFREE mode */
+    if (count > gmk_atomic_load(&s->high_water, memory_order_relaxed))
+        gmk_atomic_store(&s->high_water, count, memory_order_relaxed);
+}
 
+/* Lay out objects over mem with an empty free list and every object
+ * fresh. ABA tag starts at tag. Writes nothing into mem. */
+static int slab_carve(gmk_slab_t *s, void *mem, size_t mem_size,
+                      uint32_t obj_size, uint32_t tag) {
     /* Align object size up to 8 bytes */
     obj_size = (obj_size + 7u) & ~7u;
 
     /* Reserve space for free list at the end of the memory region */
-    uint32_t capacity = (uint32_t)(mem_size / (obj_size + sizeof(int32_t)));
+    uint32_t link_bytes = s->intrusive ? 0 : (uint32_t)sizeof(int32_t);
+    uint32_t capacity = (uint32_t)(mem_size / (obj_size + link_bytes));
     if (capacity == 0) return -1;
 
     s->base       = (uint8_t *)mem;
     s->total_size = mem_size;
     s->obj_size   = obj_size;
     s->capacity   = capacity;
-    s->high_water = 0;
-    atomic_init(&s->alloc_count, 0);
 
     /* Free list lives after the slab objects */
-    s->free_list = (int32_t *)(s->base + (size_t)capacity * obj_size);
-    s->free_head = 0;
+    s->free_list = s->intrusive ? NULL
+        : (_Atomic(int32_t) *)(s->base + (size_t)capacity * obj_size);
 
-    /* Initialize free list: each slot points to the next */
-    for (uint32_t i = 0; i < capacity - 1; i++) {
-        s->free_list[i] = (int32_t)(i + 1);
-    }
-    s->free_list[capacity - 1] = -1; /* end of list */
+    /* Free list entries are written as objects are freed */
+    gmk_atomic_store(&s->fresh, 0, memory_order_relaxed);
+    gmk_atomic_store(&s->free_head, head_pack(tag, -1), memory_order_release);
+    return 0;
+}
+
+/* ── API ────────────────────────────────────────────────────────── */
+int gmk_slab_init(gmk_slab_t *s, void *mem, size_t mem_size, uint32_t obj_size) {
+    if (!s || !mem || obj_size == 0) return -1;
+
+    s->intrusive = false;
+    atomic_init(&s->free_head, head_pack(0, -1));
+    atomic_init(&s->fresh, 0);
+    if (slab_carve(s, mem, mem_size, obj_size, 0) != 0) return -1;
+
+    s->mode = GMK_SLAB_DEFAULT_MODE;
+    atomic_init(&s->alloc_count, 0);
+    atomic_init(&s->high_water, 0);
+    atomic_init(&s->spin, false);
 
     gmk_lock_init(&s->lock);
     return 0;
 }
 
+int gmk_slab_attach(gmk_slab_t *s, void *mem, size_t mem_size, uint32_t obj_size) {
+    if (!s || !mem || obj_size == 0) return -1;
+
+    slab_lock(s);
+    uint64_t h = gmk_atomic_load(&s->free_head, memory_order_relaxed);
+    int rc = slab_carve(s, mem, mem_size, obj_size, head_tag(h) + 1);
+    slab_unlock(s);
+    return rc;
+}
+
+int gmk_slab_drain(gmk_slab_t *s) {
+    if (!s || s->mode == GMK_SLAB_LOCKFREE) return -1;
+    if (gmk_slab_used(s) != 0) return -1;
+
+    /* alloc_count trails the pop, so walk the list: it must hold every
+     * object ever handed out for none to be out */
+    slab_lock(s);
+    uint64_t h = gmk_atomic_load(&s->free_head, memory_order_relaxed);
+    uint32_t fresh = gmk_atomic_load(&s->fresh, memory_order_relaxed);
+    uint32_t n = 0;
+    for (int32_t idx = head_idx(h); idx >= 0 && n <= fresh;
+         idx = next_of(s, idx))
+        n++;
+
+    int rc = -1;
+    if (n == fresh) {
+        gmk_atomic_store(&s->free_head, head_pack(head_tag(h) + 1, -1),
+                         memory_order_relaxed);
+        s->capacity = 0;
+        rc = 0;
+    }
+    slab_unlock(s);
+    return rc;
+}
+
 void gmk_slab_destroy(gmk_slab_t *s) {
     if (s) {
         gmk_lock_destroy(&s->lock);
@@ -44,45 +238,118 @@ void gmk_slab_destroy(gmk_slab_t *s) {
     }
 }
 
-void *gmk_slab_alloc(gmk_slab_t *s) {
-    if (!s) return NULL;
+int gmk_slab_set_mode(gmk_slab_t *s, uint32_t mode) {
+    if (!s || mode < GMK_SLAB_LOCKED || mode > GMK_SLAB_LOCKFREE) return -1;
+    s->mode = mode;
+    return 0;
+}
 
-    gmk_lock_acquire(&s->lock);
+int gmk_slab_set_intrusive(gmk_slab_t *s, bool on) {
+    if (!s) return -1;
+    if (s->intrusive == on) return 0;
 
-    if (s->free_head < 0) {
-        gmk_lock_release(&s->lock);
-        return NULL; /* full */
+    slab_lock(s);
+    int rc = 0;
+    uint64_t h = gmk_atomic_load(&s->free_head, memory_order_relaxed);
+    if (!s->base || s->capacity == 0) {
+        s->intrusive = on;  /* takes effect on attach */
+    } else if (gmk_atomic_load(&s->fresh, memory_order_relaxed) != 0 ||
+               head_idx(h) >= 0) {
+        rc = -1;            /* objects were handed out */
+    } else {
+        s->intrusive = on;
+        rc = slab_carve(s, s->base, s->total_size, s->obj_size, head_tag(h) + 1);
     }
+    slab_unlock(s);
+    return rc;
+}
 
-    int32_t idx = s->free_head;
-    s->free_head = s->free_list[idx];
-
-    uint32_t count = gmk_atomic_add(&s->alloc_count, 1, memory_order_relaxed) + 1;
-    if (count > s->high_water)
-        s->high_water = count;
+void *gmk_slab_alloc(gmk_slab_t *s) {
+    if (!s) return NULL;
 
-    gmk_lock_release(&s->lock);
+    int32_t idx;
+    uint32_t one;
+    if (s->mode == GMK_SLAB_LOCKFREE) {
+        idx = pop_lockfree(s);
+        if (idx < 0) idx = fresh_lockfree(s, 1, &one);
+    } else {
+        slab_lock(s);
+        idx = pop_locked(s);
+        if (idx < 0) idx = fresh_locked(s, 1, &one);
+        slab_unlock(s);
+    }
+    if (idx < 0) return NULL; /* full */
 
-    return s->base + (size_t)idx * s->obj_size;
+    count_alloc(s, 1);
+    return obj_at(s, idx);
 }
 
 void gmk_slab_free(gmk_slab_t *s, void *ptr) {
     if (!s || !ptr) return;
 
-    uint8_t *p = (uint8_t *)ptr;
-    if (p < s->base) return;
+    int32_t idx = obj_index(s, ptr);
+    if (idx < 0) return;
+
+    if (s->mode == GMK_SLAB_LOCKFREE) {
+        push_lockfree(s, idx, idx);
+    } else {
+        slab_lock(s);
+        push_locked(s, idx, idx);
+        slab_unlock(s);
+    }
+    gmk_atomic_sub(&s->alloc_count, 1, memory_order_relaxed);
+}
 
-    size_t offset = (size_t)(p - s->base);
-    uint32_t idx = (uint32_t)(offset / s->obj_size);
-    if (idx >= s->capacity) return;
+uint32_t gmk_slab_alloc_n(gmk_slab_t *s, void **out, uint32_t n) {
+    if (!s || !out || n == 0) return 0;
 
-    gmk_lock_acquire(&s->lock);
+    uint32_t got = 0, k = 0;
+    int32_t idx, first;
+    if (s->mode == GMK_SLAB_LOCKFREE) {
+        while (got < n && (idx = pop_lockfree(s)) >= 0)
+            out[got++] = obj_at(s, idx);
+        if (got < n && (first = fresh_lockfree(s, n - got, &k)) >= 0)
+            for (uint32_t i = 0; i < k; i++)
+                out[got++] = obj_at(s, first + (int32_t)i);
+    } else {
+        slab_lock(s);
+        while (got < n && (idx = pop_locked(s)) >= 0)
+            out[got++] = obj_at(s, idx);
+        if (got < n && (first = fresh_locked(s, n - got, &k)) >= 0)
+            for (uint32_t i = 0; i < k; i++)
+                out[got++] = obj_at(s, first + (int32_t)i);
+        slab_unlock(s);
+    }
 
-    s->free_list[idx] = s->free_head;
-    s->free_head = (int32_t)idx;
-    gmk_atomic_sub(&s->alloc_count, 1, memory_order_relaxed);
+    if (got > 0)
+        count_alloc(s, got);
+    return got;
+}
+
+void gmk_slab_free_n(gmk_slab_t *s, void *const *ptrs, uint32_t n) {
+    if (!s || !ptrs || n == 0) return;
 
-    gmk_lock_release(&s->lock);
+    /* Link the objects into a private chain, then publish it at once */
+    int32_t first = -1, last = -1;
+    uint32_t freed = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        int32_t idx = obj_index(s, ptrs[i]);
+        if (idx < 0) continue;
+        if (last < 0) first = idx;
+        else          set_next(s, last, idx);
+        last = idx;
+        freed++;
+    }
+    if (freed == 0) return;
+
+    if (s->mode == GMK_SLAB_LOCKFREE) {
+        push_lockfree(s, first, last);
+    } else {
+        slab_lock(s);
+        push_locked(s, first, last);
+        slab_unlock(s);
+    }
+    gmk_atomic_sub(&s->alloc_count, freed, memory_order_relaxed);
 }
 
 uint32_t gmk_slab_used(const gmk_slab_t *s) {
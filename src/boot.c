@@ -4,6 +4,89 @@
 #include "ggmk/boot.h"
 #include "ggmk/hal.h"
 
+/* ── Tenant arenas ──────────────────────────────────────────── */
+static void tenant_allocs_destroy(gmk_kernel_t *k) {
+    for (uint32_t t = 0; t < GMK_MAX_TENANTS; t++) {
+        if (!k->tenant_alloc[t]) continue;
+        gmk_alloc_destroy(k->tenant_alloc[t]);
+        gmk_hal_free(k->tenant_alloc[t]);
+        k->tenant_alloc[t] = NULL;
+    }
+}
+
+/* One allocator per tenant with a quota, configured like the kernel one
+ * and linked to it so payloads may cross tenants. */
+static int tenant_allocs_init(gmk_kernel_t *k) {
+    for (uint32_t t = 0; t < k->cfg.n_tenants; t++) {
+        const gmk_tenant_quota_t *q = &k->cfg.tenant_quota[t];
+        if (q->soft == 0) continue;
+
+        gmk_alloc_t *a = (gmk_alloc_t *)gmk_hal_calloc(1, sizeof(*a));
+        if (!a) goto fail;
+        if (gmk_alloc_init(a, q->soft) != 0) {
+            gmk_hal_free(a);
+            goto fail;
+        }
+        k->tenant_alloc[t] = a;
+
+        if (gmk_alloc_cache_init(a, k->cfg.n_workers) != 0)
+            goto fail;
+        if (k->cfg.slab_mode != 0 &&
+            gmk_alloc_set_slab_mode(a, k->cfg.slab_mode) != 0)
+            goto fail;
+        if (gmk_alloc_set_slab_intrusive(a, k->cfg.slab_intrusive) != 0)
+            goto fail;
+        if (q->hard > q->soft) {
+            size_t chunk = k->cfg.chunk_size ? k->cfg.chunk_size
+                                             : GMK_ALLOC_CHUNK_DEFAULT;
+            if (chunk > q->hard - q->soft) chunk = q->hard - q->soft;
+            if (gmk_alloc_set_elastic(a, chunk, q->hard) != 0)
+                goto fail;
+        }
+        gmk_alloc_set_metrics(a, &k->metrics, (uint16_t)t);
+        gmk_alloc_set_epoch(a, &k->epoch);
+        gmk_alloc_link(&k->alloc, a);
+    }
+    return 0;
+
+fail:
+    tenant_allocs_destroy(k);
+    return -1;
+}
+
+gmk_alloc_t *gmk_tenant_alloc(gmk_kernel_t *k, uint16_t tenant) {
+    if (!k) return NULL;
+    if (tenant < GMK_MAX_TENANTS && k->tenant_alloc[tenant])
+        return k->tenant_alloc[tenant];
+    return &k->alloc;
+}
+
+/* ── Timer thread ─────────────────────────────────────────────── */
+/* Hosted timer thread: sleeps to each tick boundary and catches up in
+ * one step if it overslept. Bare metal drives ticks from its own timer
+ * interrupt instead (thread creation is a no-op there). */
+static void *ticker_loop(void *arg) {
+    gmk_kernel_t *k = (gmk_kernel_t *)arg;
+    uint64_t period = k->cfg.tick_ns;
+
+    while (gmk_atomic_load(&k->ticker_run, memory_order_acquire)) {
+        uint64_t tick = (gmk_hal_now_ns() - k->tick_base_ns) / period;
+        gmk_tick_advance_to(k, tick);
+
+        /* Eventcount sleep: a gmk_halt that clears ticker_run before
+         * prepare is caught by the re-check, and one after it bumps the
+         * key, so commit returns at once */
+        uint32_t key = gmk_hal_park_prepare(&k->ticker_park);
+        uint64_t next = k->tick_base_ns + (tick + 1) * period;
+        uint64_t now  = gmk_hal_now_ns();
+        if (next <= now || !gmk_atomic_load(&k->ticker_run, memory_order_acquire))
+            gmk_hal_park_cancel(&k->ticker_park);
+        else
+            gmk_hal_park_commit(&k->ticker_park, key, next - now);
+    }
+    return NULL;
+}
+
 int gmk_boot(gmk_kernel_t *k, const gmk_boot_cfg_t *cfg,
              gmk_module_t **modules_arr, uint32_t n_modules) {
     if (!k) return -1;
@@ -11,6 +94,7 @@ int gmk_boot(gmk_kernel_t *k, const gmk_boot_cfg_t *cfg,
     gmk_hal_memset(k, 0, sizeof(*k));
     atomic_init(&k->running, false);
     atomic_init(&k->tick, 0);
+    atomic_init(&k->ticker_run, false);
 
     /* Apply config with defaults */
     if (cfg) {
@@ -19,14 +103,35 @@ int gmk_boot(gmk_kernel_t *k, const gmk_boot_cfg_t *cfg,
         k->cfg.arena_size = GMK_DEFAULT_ARENA_SIZE;
         k->cfg.n_workers  = GMK_DEFAULT_WORKERS;
         k->cfg.n_tenants  = GMK_DEFAULT_TENANTS;
+        k->cfg.batch_size = GMK_WORKER_BATCH_SIZE;
     }
     if (k->cfg.arena_size == 0) k->cfg.arena_size = GMK_DEFAULT_ARENA_SIZE;
     if (k->cfg.n_workers == 0)  k->cfg.n_workers  = GMK_DEFAULT_WORKERS;
     if (k->cfg.n_tenants == 0)  k->cfg.n_tenants  = GMK_DEFAULT_TENANTS;
+    if (k->cfg.batch_size == 0) k->cfg.batch_size = GMK_WORKER_BATCH_SIZE;
+    if (k->cfg.batch_size > GMK_WORKER_BATCH_MAX)
+        k->cfg.batch_size = GMK_WORKER_BATCH_MAX;
 
-    /* 1. Arena + allocator */
+    /* 1. Arena + allocator (page policy first: the arena is mapped here) */
+    gmk_hal_mem_policy(k->cfg.huge_pages, k->cfg.numa);
     if (gmk_alloc_init(&k->alloc, k->cfg.arena_size) != 0)
         goto fail_alloc;
+    if (gmk_alloc_cache_init(&k->alloc, k->cfg.n_workers) != 0)
+        goto fail_trace;
+    if (k->cfg.slab_mode != 0 &&
+        gmk_alloc_set_slab_mode(&k->alloc, k->cfg.slab_mode) != 0)
+        goto fail_trace;
+    if (gmk_alloc_set_slab_intrusive(&k->alloc, k->cfg.slab_intrusive) != 0)
+        goto fail_trace;
+    if (gmk_epoch_init(&k->epoch, k->cfg.n_workers) != 0)
+        goto fail_trace;
+    gmk_alloc_set_epoch(&k->alloc, &k->epoch);
+    if (k->cfg.arena_max > k->cfg.arena_size) {
+        if (k->cfg.chunk_size == 0) k->cfg.chunk_size = GMK_ALLOC_CHUNK_DEFAULT;
+        if (gmk_alloc_set_elastic(&k->alloc, k->cfg.chunk_size,
+                                  k->cfg.arena_max) != 0)
+            goto fail_trace;
+    }
 
     /* 2. Trace */
     if (gmk_trace_init(&k->trace, k->cfg.n_tenants) != 0)
@@ -35,6 +140,11 @@ int gmk_boot(gmk_kernel_t *k, const gmk_boot_cfg_t *cfg,
     /* 3. Metrics */
     if (gmk_metrics_init(&k->metrics, k->cfg.n_tenants) != 0)
         goto fail_metrics;
+    gmk_alloc_set_metrics(&k->alloc, &k->metrics, GMK_ALLOC_SHARED);
+
+    /* 3b. Tenant arenas */
+    if (tenant_allocs_init(k) != 0)
+        goto fail_tenants;
 
     /* 4. Scheduler */
     if (gmk_sched_init(&k->sched, k->cfg.n_workers) != 0)
@@ -76,6 +186,12 @@ int gmk_boot(gmk_kernel_t *k, const gmk_boot_cfg_t *cfg,
                              &k->modules, &k->alloc, &k->chan,
                              &k->trace, &k->metrics, k) != 0)
         goto fail_pool;
+    gmk_worker_pool_set_batch(&k->pool, k->cfg.batch_size);
+    gmk_worker_pool_set_tenant_allocs(&k->pool, k->tenant_alloc);
+    gmk_worker_pool_set_epoch(&k->pool, &k->epoch);
+    gmk_worker_pool_set_park(&k->pool, k->cfg.park_spin_ns);
+    k->sched.wake     = gmk_worker_notify;
+    k->sched.wake_arg = &k->pool;
 
     /* 10. Start workers */
     if (gmk_worker_pool_start(&k->pool) != 0)
@@ -83,6 +199,20 @@ int gmk_boot(gmk_kernel_t *k, const gmk_boot_cfg_t *cfg,
 
     gmk_atomic_store(&k->running, true, memory_order_release);
 
+    /* 11. Timer thread: tick 0 starts now */
+    k->tick_base_ns = gmk_hal_now_ns();
+    if (k->cfg.tick_ns != 0) {
+        gmk_hal_park_init(&k->ticker_park);
+        gmk_atomic_store(&k->ticker_run, true, memory_order_release);
+        if (gmk_hal_thread_create(&k->ticker, ticker_loop, k) != 0) {
+            gmk_atomic_store(&k->ticker_run, false, memory_order_release);
+            gmk_hal_park_destroy(&k->ticker_park);
+            gmk_atomic_store(&k->running, false, memory_order_release);
+            gmk_worker_pool_stop(&k->pool);
+            goto fail_start;
+        }
+    }
+
     /* Trace boot event */
     gmk_trace_write_force(&k->trace, 0, GMK_EV_BOOT, 0,
                           k->cfg.n_workers, (uint32_t)(k->cfg.arena_size >> 20));
@@ -90,6 +220,7 @@ int gmk_boot(gmk_kernel_t *k, const gmk_boot_cfg_t *cfg,
     return 0;
 
 fail_start:
+    k->sched.wake = NULL;
     gmk_worker_pool_destroy(&k->pool);
 fail_pool:
     gmk_module_fini_all(&k->modules, &boot_ctx);
@@ -101,10 +232,13 @@ fail_mod:
 fail_chan:
     gmk_sched_destroy(&k->sched);
 fail_sched:
+    tenant_allocs_destroy(k);
+fail_tenants:
     gmk_metrics_destroy(&k->metrics);
 fail_metrics:
     gmk_trace_destroy(&k->trace);
 fail_trace:
+    gmk_epoch_destroy(&k->epoch);
     gmk_alloc_destroy(&k->alloc);
 fail_alloc:
     return -1;
@@ -118,8 +252,17 @@ void gmk_halt(gmk_kernel_t *k) {
     /* Trace halt event */
     gmk_trace_write_force(&k->trace, 0, GMK_EV_HALT, 0, 0, 0);
 
+    /* 0. Stop the timer thread */
+    if (k->cfg.tick_ns != 0) {
+        gmk_atomic_store(&k->ticker_run, false, memory_order_release);
+        gmk_hal_park_wake(&k->ticker_park);
+        gmk_hal_thread_join(&k->ticker);
+        gmk_hal_park_destroy(&k->ticker_park);
+    }
+
     /* 1. Stop workers */
     gmk_worker_pool_stop(&k->pool);
+    k->sched.wake = NULL;
     gmk_worker_pool_destroy(&k->pool);
 
     /* 2. Finalize modules */
@@ -142,6 +285,8 @@ void gmk_halt(gmk_kernel_t *k) {
     gmk_sched_destroy(&k->sched);
     gmk_metrics_destroy(&k->metrics);
     gmk_trace_destroy(&k->trace);
+    tenant_allocs_destroy(k);
+    gmk_epoch_destroy(&k->epoch);
     gmk_alloc_destroy(&k->alloc);
 }
 
@@ -150,25 +295,107 @@ int gmk_submit(gmk_kernel_t *k, gmk_task_t *task) {
     if (!gmk_atomic_load(&k->running, memory_order_acquire))
         return GMK_FAIL(GMK_ERR_CLOSED);
 
+    /* The scheduler's wake hook rouses a worker if one has to */
     int rc = _gmk_enqueue(&k->sched, task, -1);
-    if (rc == 0) {
+    if (rc == 0)
+        gmk_metric_inc(&k->metrics, task->tenant,
+                      GMK_METRIC_TASKS_ENQUEUED, 1);
+    return rc;
+}
+
+int gmk_submit_to(gmk_kernel_t *k, gmk_task_t *task, uint32_t worker_id) {
+    if (!k || !task) return -1;
+    if (worker_id >= k->pool.n_workers) return GMK_FAIL(GMK_ERR_INVALID);
+    if (!gmk_atomic_load(&k->running, memory_order_acquire))
+        return GMK_FAIL(GMK_ERR_CLOSED);
+
+    int rc = _gmk_enqueue(&k->sched, task, (int)worker_id);
+    if (rc == 0)
         gmk_metric_inc(&k->metrics, task->tenant,
                       GMK_METRIC_TASKS_ENQUEUED, 1);
-        /* Wake a worker */
-        for (uint32_t i = 0; i < k->pool.n_workers; i++) {
-            if (gmk_atomic_load(&k->pool.workers[i].parked,
-                               memory_order_acquire)) {
-                gmk_worker_wake(&k->pool.workers[i]);
-                break;
-            }
-        }
-    }
     return rc;
 }
 
+/* Raise *t to tick; a racing advance may already have gone further. */
+static void tick_raise(_Atomic(uint64_t) *t, uint64_t tick) {
+    uint64_t cur = gmk_atomic_load(t, memory_order_relaxed);
+    while (cur < tick &&
+           !gmk_atomic_cas_weak(t, &cur, tick, memory_order_release,
+                                memory_order_relaxed))
+        ;
+}
+
+static void tick_publish(gmk_kernel_t *k, uint64_t tick) {
+    for (uint32_t i = 0; i < k->pool.n_workers; i++)
+        tick_raise(&k->pool.workers[i].tick, tick);
+    gmk_epoch_advance(&k->epoch, tick);
+    gmk_det_advance(&k->sched.det, tick);
+
+    /* A released deterministic batch needs one worker to open it */
+    if (gmk_det_ready(&k->sched.det))
+        gmk_worker_wake_one(&k->pool);
+
+    /* Wake only the parked owners whose EVQ shard just came due */
+    for (uint32_t i = 0; i < k->pool.n_workers; i++) {
+        if (gmk_evq_next_due(&k->sched.evqs[i]) <= tick)
+            gmk_worker_wake(&k->pool.workers[i]);
+    }
+}
+
 void gmk_tick_advance(gmk_kernel_t *k) {
     if (!k) return;
-    uint32_t tick = gmk_atomic_add(&k->tick, 1, memory_order_release) + 1;
-    for (uint32_t i = 0; i < k->pool.n_workers; i++)
-        gmk_atomic_store(&k->pool.workers[i].tick, tick, memory_order_release);
+    uint64_t tick = gmk_atomic_add(&k->tick, 1, memory_order_release) + 1;
+    tick_publish(k, tick);
+}
+
+void gmk_tick_advance_to(gmk_kernel_t *k, uint64_t tick) {
+    if (!k) return;
+    uint64_t cur = gmk_atomic_load(&k->tick, memory_order_relaxed);
+    do {
+        if (cur >= tick) return;
+    } while (!gmk_atomic_cas_weak(&k->tick, &cur, tick, memory_order_release,
+                                  memory_order_relaxed));
+    tick_publish(k, tick);
+}
+
+/* ── Timers ───────────────────────────────────────────────────── */
+int gmk_submit_at(gmk_kernel_t *k, gmk_task_t *task, uint64_t tick,
+                  int worker_id, gmk_evq_handle_t *handle) {
+    if (!k || !task) return -1;
+    if (worker_id >= (int)k->pool.n_workers) return GMK_FAIL(GMK_ERR_INVALID);
+    if (!gmk_atomic_load(&k->running, memory_order_acquire))
+        return GMK_FAIL(GMK_ERR_CLOSED);
+
+    task->meta0 = tick;
+    if (_gmk_enqueue_at(&k->sched, task, worker_id, handle) != 0)
+        return GMK_FAIL(GMK_ERR_FULL);
+    gmk_metric_inc(&k->metrics, task->tenant, GMK_METRIC_TASKS_ENQUEUED, 1);
+
+    /* Already due: no tick advance is coming to wake the owner, which
+     * may not be worker_id if its shard was full */
+    uint64_t now = gmk_atomic_load(&k->tick, memory_order_acquire);
+    if (tick <= now) {
+        for (uint32_t i = 0; i < k->pool.n_workers; i++)
+            if (gmk_evq_next_due(&k->sched.evqs[i]) <= now)
+                gmk_worker_wake(&k->pool.workers[i]);
+    }
+    return 0;
+}
+
+int gmk_submit_at_ns(gmk_kernel_t *k, gmk_task_t *task, uint64_t deadline_ns,
+                     int worker_id, gmk_evq_handle_t *handle) {
+    if (!k || !task) return -1;
+    uint64_t period = k->cfg.tick_ns;
+    if (period == 0) return GMK_FAIL(GMK_ERR_INVALID);
+
+    /* Tick t starts at tick_base_ns + t * period */
+    uint64_t tick = 0;
+    if (deadline_ns > k->tick_base_ns)
+        tick = (deadline_ns - k->tick_base_ns + period - 1) / period;
+    return gmk_submit_at(k, task, tick, worker_id, handle);
+}
+
+int gmk_timer_cancel(gmk_kernel_t *k, gmk_evq_handle_t handle) {
+    if (!k) return -1;
+    return _gmk_cancel_at(&k->sched, handle);
 }
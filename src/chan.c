@@ -56,8 +56,8 @@ int gmk_chan_reg_init(gmk_chan_reg_t *cr, gmk_sched_t *sched,
     atomic_init(&cr->channels[1].emit_count, 0);
     atomic_init(&cr->channels[1].drop_count, 0);
     init_chan_lock(&cr->channels[1]);
-    if (gmk_ring_mpmc_init(&cr->channels[1].ring, GMK_CHAN_DEFAULT_SLOTS,
-                           sizeof(gmk_task_t)) != 0) {
+    if (gmk_ring_mpmc_init_layout(&cr->channels[1].ring, GMK_CHAN_DEFAULT_SLOTS,
+                                  sizeof(gmk_task_t), GMK_TASK_RING_LAYOUT) != 0) {
         return -1;
     }
     cr->channels[1].ring_cap = GMK_CHAN_DEFAULT_SLOTS;
@@ -111,7 +111,8 @@ int gmk_chan_open(gmk_chan_reg_t *cr, const char *name, uint32_t mode,
     atomic_init(&ch->drop_count, 0);
     init_chan_lock(ch);
 
-    if (gmk_ring_mpmc_init(&ch->ring, slots, sizeof(gmk_task_t)) != 0)
+    if (gmk_ring_mpmc_init_layout(&ch->ring, slots, sizeof(gmk_task_t),
+                                  GMK_TASK_RING_LAYOUT) != 0)
         return GMK_FAIL(GMK_ERR_NOMEM);
 
     cr->n_channels++;
@@ -124,7 +125,7 @@ int gmk_chan_open(gmk_chan_reg_t *cr, const char *name, uint32_t mode,
 
 /* ── Dead letter ────────────────────────────────────────────────── */
 
-static void route_to_dead_letter(gmk_chan_reg_t *cr, gmk_task_t *task) {
+static void route_to_dead_letter(gmk_chan_reg_t *cr, const gmk_task_t *task) {
     if (chan_is_open(&cr->channels[GMK_CHAN_SYS_DROPPED])) {
         gmk_ring_mpmc_push(&cr->channels[GMK_CHAN_SYS_DROPPED].ring, task);
     }
@@ -179,8 +180,10 @@ int gmk_chan_emit(gmk_chan_reg_t *cr, uint32_t chan_id, gmk_task_t *task) {
         }
     }
 
-    /* Buffer in ring */
-    if (gmk_ring_mpmc_push(&ch->ring, task) != 0) {
+    /* Buffer in ring: the task is written once, straight into the cell */
+    uint32_t pos;
+    gmk_task_t *cell = (gmk_task_t *)gmk_ring_mpmc_reserve(&ch->ring, &pos);
+    if (!cell) {
         if (cr->trace)
             gmk_trace_write(cr->trace, task->tenant, GMK_EV_CHAN_FULL,
                            task->type, chan_id, 0);
@@ -188,6 +191,8 @@ int gmk_chan_emit(gmk_chan_reg_t *cr, uint32_t chan_id, gmk_task_t *task) {
             gmk_metric_inc(cr->metrics, task->tenant, GMK_METRIC_CHAN_FULL_COUNT, 1);
         return GMK_CHAN_FULL;
     }
+    *cell = *task;
+    gmk_ring_mpmc_commit(&ch->ring, pos);
 
     gmk_atomic_add(&ch->emit_count, 1, memory_order_relaxed);
     if (cr->metrics)
@@ -275,64 +280,80 @@ int gmk_chan_drain(gmk_chan_reg_t *cr, uint32_t chan_id, uint32_t limit) {
     if (n_subs == 0) return 0;
     if (limit == 0) limit = UINT32_MAX;
 
+    /* Active subscriber count is fixed by the snapshot */
+    uint32_t n_active = 0;
+    for (uint32_t i = 0; i < n_subs; i++) {
+        if (subs_snap[i].active) n_active++;
+    }
+
     uint32_t drained = 0;
-    gmk_task_t task;
+    const gmk_task_t *chunk[GMK_CHAN_DRAIN_CHUNK];
+
+    while (drained < limit) {
+        uint32_t want = limit - drained;
+        if (want > GMK_CHAN_DRAIN_CHUNK) want = GMK_CHAN_DRAIN_CHUNK;
+
+        /* One CAS claims the chunk in place; each destination takes it
+         * with one CAS per ring and a single copy per task */
+        uint32_t pos, got = gmk_ring_mpmc_peek_n(&ch->ring, want, &pos);
+        if (got == 0) break;
+        for (uint32_t j = 0; j < got; j++)
+            chunk[j] = (const gmk_task_t *)gmk_ring_mpmc_slot(&ch->ring, pos + j);
 
-    while (drained < limit && gmk_ring_mpmc_pop(&ch->ring, &task) == 0) {
         if (ch->mode == GMK_CHAN_P2P) {
             /* P2P: route to the single subscriber */
             if (subs_snap[0].active) {
-                if (_gmk_enqueue(cr->sched, &task, subs_snap[0].worker_id) != 0) {
-                    route_to_dead_letter(cr, &task);
+                uint32_t ok = _gmk_enqueue_copy_n(cr->sched, chunk, got,
+                                                  subs_snap[0].worker_id);
+                for (uint32_t j = ok; j < got; j++) {
+                    route_to_dead_letter(cr, chunk[j]);
                     gmk_atomic_add(&ch->drop_count, 1, memory_order_relaxed);
                 }
             }
         } else {
-            /* Fan-out: copy task header to each subscriber.
-             * If the task has a refcounted payload, retain for each
+            /* Fan-out: copy task headers to each subscriber.
+             * If a task has a refcounted payload, retain for each
              * additional subscriber so the payload lives until all
-             * handlers complete. */
-            bool has_rc = (task.flags & GMK_TF_PAYLOAD_RC) && task.payload_ptr;
-
-            /* Count active subscribers */
-            uint32_t n_active = 0;
-            for (uint32_t i = 0; i < n_subs; i++) {
-                if (subs_snap[i].active) n_active++;
-            }
-
-            /* Retain payload (n_active - 1) times for the extra copies.
-             * The original refcount (1) covers the first subscriber. */
-            if (has_rc && n_active > 1) {
-                for (uint32_t r = 0; r < n_active - 1; r++)
-                    gmk_payload_retain((void *)(uintptr_t)task.payload_ptr);
+             * handlers complete. The original refcount (1) covers the
+             * first subscriber. */
+            if (n_active > 1) {
+                for (uint32_t j = 0; j < got; j++) {
+                    if (!((chunk[j]->flags & GMK_TF_PAYLOAD_RC) &&
+                          chunk[j]->payload_ptr))
+                        continue;
+                    for (uint32_t r = 0; r < n_active - 1; r++)
+                        gmk_payload_retain((void *)(uintptr_t)chunk[j]->payload_ptr);
+                }
             }
 
             for (uint32_t i = 0; i < n_subs; i++) {
                 if (!subs_snap[i].active) continue;
 
-                gmk_task_t copy = task;
-                int rc = _gmk_enqueue(cr->sched, &copy, subs_snap[i].worker_id);
-                if (rc != 0) {
+                uint32_t ok = _gmk_enqueue_copy_n(cr->sched, chunk, got,
+                                                  subs_snap[i].worker_id);
+                for (uint32_t j = ok; j < got; j++) {
+                    const gmk_task_t *copy = chunk[j];
                     if (ch->guarantee == GMK_CHAN_LOSSY) {
                         gmk_atomic_add(&ch->drop_count, 1, memory_order_relaxed);
                         if (cr->trace)
-                            gmk_trace_write(cr->trace, task.tenant,
-                                           GMK_EV_CHAN_DROP, task.type,
+                            gmk_trace_write(cr->trace, copy->tenant,
+                                           GMK_EV_CHAN_DROP, copy->type,
                                            chan_id, i);
                         if (cr->metrics)
-                            gmk_metric_inc(cr->metrics, task.tenant,
+                            gmk_metric_inc(cr->metrics, copy->tenant,
                                           GMK_METRIC_CHAN_DROPS, 1);
                     } else {
                         /* Lossless: route to dead letter */
-                        route_to_dead_letter(cr, &copy);
+                        route_to_dead_letter(cr, copy);
                     }
                     /* Release the ref for this failed/dead-lettered copy */
-                    if (has_rc)
-                        gmk_payload_release(cr->alloc, (void *)(uintptr_t)copy.payload_ptr);
+                    if ((copy->flags & GMK_TF_PAYLOAD_RC) && copy->payload_ptr)
+                        gmk_payload_release(cr->alloc, (void *)(uintptr_t)copy->payload_ptr);
                 }
             }
         }
-        drained++;
+        gmk_ring_mpmc_release_n(&ch->ring, pos, got);
+        drained += got;
     }
 
     if (drained > 0 && cr->trace)
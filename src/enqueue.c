@@ -2,23 +2,192 @@
  * GGMK/cpu — _gmk_enqueue + _gmk_yield + gmk_yield/gmk_yield_at
  *
  * Single enqueue core: assigns monotonic seq, routes to LQ or RQ.
- * All scheduling paths funnel through _gmk_enqueue.
+ * All scheduling paths funnel through _gmk_enqueue. Worker-targeted tasks
+ * go to the worker's inbox, since the caller may not be that worker;
+ * _gmk_enqueue_local is the owner's shortcut into its own LQ ring.
+ * _gmk_enqueue_at parks a task in a worker's EVQ shard; when it fires it
+ * comes back through _gmk_enqueue_local (or the owner's inbox).
+ * GMK_TF_DETERMINISTIC tasks leave every path for the deterministic lane,
+ * which assigns their seq itself.
  */
 #include "ggmk/sched.h"
+#include "ggmk/hal.h"
+
+/* A worker that queues onto the RQ or its own LQ runs the task itself
+ * on a later pass; anyone else has to wake the worker that will. */
+static void enqueue_wake(gmk_sched_t *s, int worker_id) {
+    if (!s->wake) return;
+    uint32_t self = gmk_hal_self();
+    if (worker_id >= 0 && (uint32_t)worker_id < s->n_workers) {
+        if ((uint32_t)worker_id != self)
+            s->wake(s->wake_arg, worker_id);
+    } else if (self >= s->n_workers) {
+        s->wake(s->wake_arg, -1);
+    }
+}
 
 int _gmk_enqueue(gmk_sched_t *s, gmk_task_t *task, int worker_id) {
     if (!s || !task) return -1;
 
+    if (task->flags & GMK_TF_DETERMINISTIC)
+        return gmk_det_push(&s->det, task);
+
     /* Assign monotonic sequence number */
     task->seq = gmk_atomic_add(&s->next_seq, 1, memory_order_relaxed);
 
-    /* Route: if worker_id specified, try LQ first */
+    /* Route: if worker_id specified, try the worker's inbox first */
     if (worker_id >= 0 && (uint32_t)worker_id < s->n_workers) {
-        if (gmk_lq_push(&s->lqs[worker_id], task) == 0)
+        if (gmk_lq_push_remote(&s->lqs[worker_id], task) == 0) {
+            enqueue_wake(s, worker_id);
             return 0;
+        }
     }
 
     /* Fall back to RQ */
+    if (gmk_rq_push(&s->rq, task) != 0)
+        return -1;
+    enqueue_wake(s, -1);
+    return 0;
+}
+
+static bool any_deterministic(const gmk_task_t *tasks, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++)
+        if (tasks[i].flags & GMK_TF_DETERMINISTIC) return true;
+    return false;
+}
+
+uint32_t _gmk_enqueue_n(gmk_sched_t *s, gmk_task_t *tasks, uint32_t n,
+                        int worker_id) {
+    if (!s || !tasks || n == 0) return 0;
+
+    /* Deterministic tasks in the batch: one at a time, each on its path */
+    if (any_deterministic(tasks, n)) {
+        uint32_t done = 0;
+        while (done < n && _gmk_enqueue(s, &tasks[done], worker_id) == 0)
+            done++;
+        return done;
+    }
+
+    uint32_t seq = gmk_atomic_add(&s->next_seq, n, memory_order_relaxed);
+    for (uint32_t i = 0; i < n; i++)
+        tasks[i].seq = seq + i;
+
+    uint32_t done = 0;
+    if (worker_id >= 0 && (uint32_t)worker_id < s->n_workers) {
+        done = gmk_ring_mpmc_push_n(&s->lqs[worker_id].inbox, tasks, n);
+        if (done > 0) enqueue_wake(s, worker_id);
+    }
+
+    if (done < n) {
+        uint32_t rq = gmk_rq_push_n(&s->rq, tasks + done, n - done);
+        if (rq > 0) enqueue_wake(s, -1);
+        done += rq;
+    }
+    return done;
+}
+
+/* Copy src[0..n) into a run of r's cells claimed with one CAS, stamping
+ * seq, seq + 1, ... Returns the number copied. */
+static uint32_t copy_into(gmk_ring_mpmc_t *r, const gmk_task_t *const *src,
+                          uint32_t n, uint32_t seq) {
+    uint32_t pos, k = gmk_ring_mpmc_reserve_n(r, n, &pos);
+    for (uint32_t i = 0; i < k; i++) {
+        gmk_task_t *t = (gmk_task_t *)gmk_ring_mpmc_slot(r, pos + i);
+        *t = *src[i];
+        t->seq = seq + i;
+    }
+    gmk_ring_mpmc_commit_n(r, pos, k);
+    return k;
+}
+
+static inline uint32_t task_prio(const gmk_task_t *t) {
+    uint32_t prio = GMK_PRIORITY(t->flags);
+    return prio >= GMK_PRIORITY_COUNT ? GMK_PRIO_LOW : prio;
+}
+
+uint32_t _gmk_enqueue_copy_n(gmk_sched_t *s, const gmk_task_t *const *src,
+                             uint32_t n, int worker_id) {
+    if (!s || !src || n == 0) return 0;
+
+    /* Deterministic tasks in the batch: one at a time, each on its path */
+    bool det = false;
+    for (uint32_t i = 0; i < n && !det; i++)
+        det = src[i]->flags & GMK_TF_DETERMINISTIC;
+    if (det) {
+        uint32_t done = 0;
+        for (; done < n; done++) {
+            gmk_task_t copy = *src[done];
+            if (_gmk_enqueue(s, &copy, worker_id) != 0) break;
+        }
+        return done;
+    }
+
+    uint32_t seq = gmk_atomic_add(&s->next_seq, n, memory_order_relaxed);
+
+    uint32_t done = 0;
+    if (worker_id >= 0 && (uint32_t)worker_id < s->n_workers) {
+        done = copy_into(&s->lqs[worker_id].inbox, src, n, seq);
+        if (done > 0) enqueue_wake(s, worker_id);
+    }
+
+    /* The rest goes to the RQ, one claim per run of equal priority */
+    uint32_t before = done;
+    while (done < n) {
+        uint32_t prio = task_prio(src[done]);
+        uint32_t run = 1;
+        while (done + run < n && task_prio(src[done + run]) == prio)
+            run++;
+
+        uint32_t got = copy_into(&s->rq.queues[prio], src + done, run, seq + done);
+        done += got;
+        if (got < run) break; /* that priority's queue is full */
+    }
+    if (done > before) enqueue_wake(s, -1);
+    return done;
+}
+
+/* The shard index rides in the handle's top byte */
+#define AT_SHARD_SHIFT 56
+
+int _gmk_enqueue_at(gmk_sched_t *s, const gmk_task_t *task, int worker_id,
+                    gmk_evq_handle_t *handle) {
+    if (!s || !task) return -1;
+
+    uint32_t first;
+    if (worker_id >= 0 && (uint32_t)worker_id < s->n_workers)
+        first = (uint32_t)worker_id;
+    else
+        first = gmk_atomic_add(&s->evq_spread, 1, memory_order_relaxed) % s->n_workers;
+
+    for (uint32_t k = 0; k < s->n_workers; k++) {
+        uint32_t shard = (first + k) % s->n_workers;
+        gmk_evq_handle_t h;
+        if (gmk_evq_arm(&s->evqs[shard], task, &h) == 0) {
+            if (handle) *handle = h | ((uint64_t)shard << AT_SHARD_SHIFT);
+            return 0;
+        }
+    }
+    return -1; /* every shard full */
+}
+
+int _gmk_cancel_at(gmk_sched_t *s, gmk_evq_handle_t handle) {
+    if (!s) return -1;
+    uint32_t shard = (uint32_t)(handle >> AT_SHARD_SHIFT);
+    if (shard >= s->n_workers) return -1;
+    return gmk_evq_cancel(&s->evqs[shard], handle);
+}
+
+int _gmk_enqueue_local(gmk_sched_t *s, gmk_task_t *task, uint32_t worker_id) {
+    if (!s || !task || worker_id >= s->n_workers) return -1;
+
+    if (task->flags & GMK_TF_DETERMINISTIC)
+        return gmk_det_push(&s->det, task);
+
+    task->seq = gmk_atomic_add(&s->next_seq, 1, memory_order_relaxed);
+
+    if (gmk_lq_push(&s->lqs[worker_id], task) == 0)
+        return 0;
+
     return gmk_rq_push(&s->rq, task);
 }
 
@@ -35,6 +204,10 @@ int _gmk_yield(gmk_sched_t *s, gmk_task_t *task, int worker_id,
         return GMK_FAIL(GMK_ERR_YIELD_LIMIT);
     }
 
+    /* Deterministic tasks resume in the next tick's batch */
+    if (task->flags & GMK_TF_DETERMINISTIC)
+        return gmk_det_push(&s->det, task) == 0 ? 0 : GMK_FAIL(GMK_ERR_YIELD_OVERFLOW);
+
     /* Try LQ yield reserve first */
     if (worker_id >= 0 && (uint32_t)worker_id < s->n_workers) {
         if (gmk_lq_push_yield(&s->lqs[worker_id], task) == 0)
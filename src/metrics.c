@@ -18,6 +18,9 @@ int gmk_metrics_init(gmk_metrics_t *m, uint32_t n_tenants) {
         for (uint32_t i = 0; i < GMK_METRIC_COUNT; i++)
             atomic_init(&m->per_tenant[t][i], 0);
 
+    for (uint32_t b = 0; b < GMK_BATCH_HIST_BUCKETS; b++)
+        atomic_init(&m->batch_hist[b], 0);
+
     return 0;
 }
 
@@ -50,6 +53,21 @@ uint64_t gmk_metric_get_tenant(const gmk_metrics_t *m, uint16_t tenant,
                            memory_order_relaxed);
 }
 
+void gmk_metric_batch(gmk_metrics_t *m, uint32_t n) {
+    if (!m || n == 0) return;
+
+    /* ceil(log2(n)), clamped to the last bucket */
+    uint32_t b = (n == 1) ? 0 : 32 - (uint32_t)__builtin_clz(n - 1);
+    if (b >= GMK_BATCH_HIST_BUCKETS) b = GMK_BATCH_HIST_BUCKETS - 1;
+
+    gmk_atomic_add(&m->batch_hist[b], 1, memory_order_relaxed);
+}
+
+uint64_t gmk_metric_batch_get(const gmk_metrics_t *m, uint32_t bucket) {
+    if (!m || bucket >= GMK_BATCH_HIST_BUCKETS) return 0;
+    return gmk_atomic_load(&m->batch_hist[bucket], memory_order_relaxed);
+}
+
 void gmk_metrics_reset(gmk_metrics_t *m) {
     if (!m) return;
     for (uint32_t i = 0; i < GMK_METRIC_COUNT; i++)
@@ -57,4 +75,6 @@ void gmk_metrics_reset(gmk_metrics_t *m) {
     for (uint32_t t = 0; t < m->n_tenants; t++)
         for (uint32_t i = 0; i < GMK_METRIC_COUNT; i++)
             gmk_atomic_store(&m->per_tenant[t][i], 0, memory_order_relaxed);
+    for (uint32_t b = 0; b < GMK_BATCH_HIST_BUCKETS; b++)
+        gmk_atomic_store(&m->batch_hist[b], 0, memory_order_relaxed);
 }
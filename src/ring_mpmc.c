@@ -2,85 +2,136 @@
  * GGMK/cpu — MPMC ring buffer implementation (Vyukov bounded queue)
  * Each slot has a sequence number. Producers and consumers use CAS on
  * head/tail, checking the slot's sequence to ensure correctness.
+ * Slot access goes through seq_at()/data_at() so one code path serves
+ * every cell layout.
+ *
+ * Sequence words are stored relative to their slot index (seq - idx), so
+ * the initial state (seq == idx) is all zeroes: a freshly mapped buffer
+ * is already a valid empty ring and init touches none of its pages.
  */
 #include "ggmk/ring_mpmc.h"
 #include "ggmk/hal.h"
 
-static inline uint32_t cell_stride(uint32_t elem_size) {
-    /* cell = 4 bytes (seq) + elem_size, rounded up to 8-byte alignment */
-    uint32_t raw = sizeof(_Atomic(uint32_t)) + elem_size;
+#define SEQ_BYTES ((uint32_t)sizeof(_Atomic(uint32_t)))
+
+static inline uint32_t cell_stride(uint32_t elem_size, uint32_t layout) {
+    uint32_t raw = SEQ_BYTES + elem_size;
+    if (layout == GMK_RING_PADDED)
+        return (raw + GMK_CACHE_LINE - 1) & ~(uint32_t)(GMK_CACHE_LINE - 1);
+    /* PACKED: 4 bytes (seq) + elem_size, rounded up to 8-byte alignment */
     return (raw + 7u) & ~7u;
 }
 
-static inline gmk_mpmc_cell_t *cell_at(const gmk_ring_mpmc_t *r, uint32_t idx) {
-    return (gmk_mpmc_cell_t *)(r->buf + (size_t)idx * r->cell_size);
+/* SPLIT keeps the seq array in whole cache lines ahead of the data */
+static inline size_t split_seq_bytes(uint32_t cap) {
+    size_t raw = (size_t)cap * SEQ_BYTES;
+    return (raw + GMK_CACHE_LINE - 1) & ~(size_t)(GMK_CACHE_LINE - 1);
 }
 
-int gmk_ring_mpmc_init(gmk_ring_mpmc_t *r, uint32_t cap, uint32_t elem_size) {
-    if (!r || !gmk_is_power_of_two(cap) || elem_size == 0)
-        return -1;
+static inline _Atomic(uint32_t) *seq_at(const gmk_ring_mpmc_t *r, uint32_t idx) {
+    return (_Atomic(uint32_t) *)(r->seq_base + (size_t)idx * r->seq_stride);
+}
+
+/* Sequence of the slot that position pos maps to */
+static inline uint32_t seq_load(const gmk_ring_mpmc_t *r, uint32_t pos,
+                                memory_order mo) {
+    uint32_t idx = pos & r->mask;
+    return gmk_atomic_load(seq_at(r, idx), mo) + idx;
+}
+
+static inline void seq_store(const gmk_ring_mpmc_t *r, uint32_t pos,
+                             uint32_t seq, memory_order mo) {
+    uint32_t idx = pos & r->mask;
+    gmk_atomic_store(seq_at(r, idx), seq - idx, mo);
+}
+
+static inline uint8_t *data_at(const gmk_ring_mpmc_t *r, uint32_t idx) {
+    return r->data_base + (size_t)idx * r->data_stride;
+}
+
+size_t gmk_ring_mpmc_buf_size(uint32_t cap, uint32_t elem_size, uint32_t layout) {
+    if (layout == GMK_RING_SPLIT)
+        return split_seq_bytes(cap) + (size_t)cap * elem_size;
+    return (size_t)cap * cell_stride(elem_size, layout);
+}
 
+/* Carve buf (zeroed by the caller) into seq/data views. */
+static void ring_setup(gmk_ring_mpmc_t *r, uint32_t cap, uint32_t elem_size,
+                       uint32_t layout, uint8_t *buf, size_t buf_bytes) {
     r->cap       = cap;
     r->mask      = cap - 1;
     r->elem_size = elem_size;
-    r->cell_size = cell_stride(elem_size);
-
-    size_t buf_bytes = (size_t)cap * r->cell_size;
-    r->buf = (uint8_t *)gmk_hal_page_alloc(buf_bytes, GMK_CACHE_LINE);
-    if (!r->buf) return -1;
+    r->layout    = layout;
+    r->buf       = buf;
+    r->buf_bytes = buf_bytes;
 
-    /* Initialize per-slot sequence numbers */
-    for (uint32_t i = 0; i < cap; i++) {
-        gmk_mpmc_cell_t *c = cell_at(r, i);
-        atomic_init(&c->seq, i);
+    if (layout == GMK_RING_SPLIT) {
+        r->seq_stride  = SEQ_BYTES;
+        r->data_stride = elem_size;
+        r->seq_base    = buf;
+        r->data_base   = buf + split_seq_bytes(cap);
+    } else if (layout == GMK_RING_PADDED) {
+        /* Data first, so elements keep the buffer's line alignment */
+        r->seq_stride  = cell_stride(elem_size, layout);
+        r->data_stride = r->seq_stride;
+        r->seq_base    = buf + ((elem_size + SEQ_BYTES - 1) & ~(SEQ_BYTES - 1));
+        r->data_base   = buf;
+    } else {
+        r->seq_stride  = cell_stride(elem_size, layout);
+        r->data_stride = r->seq_stride;
+        r->seq_base    = buf;
+        r->data_base   = buf + offsetof(gmk_mpmc_cell_t, data);
     }
 
     atomic_init(&r->head, 0);
     atomic_init(&r->tail, 0);
+}
+
+int gmk_ring_mpmc_init_layout(gmk_ring_mpmc_t *r, uint32_t cap,
+                              uint32_t elem_size, uint32_t layout) {
+    if (!r || !gmk_is_power_of_two(cap) || elem_size == 0 ||
+        layout > GMK_RING_SPLIT)
+        return -1;
+
+    size_t buf_bytes = gmk_ring_mpmc_buf_size(cap, elem_size, layout);
+    uint8_t *buf = (uint8_t *)gmk_hal_page_alloc(buf_bytes, GMK_CACHE_LINE);
+    if (!buf) return -1;
+
+    ring_setup(r, cap, elem_size, layout, buf, buf_bytes);
     return 0;
 }
 
+int gmk_ring_mpmc_init(gmk_ring_mpmc_t *r, uint32_t cap, uint32_t elem_size) {
+    return gmk_ring_mpmc_init_layout(r, cap, elem_size, GMK_RING_PACKED);
+}
+
 int gmk_ring_mpmc_init_buf(gmk_ring_mpmc_t *r, uint32_t cap,
                             uint32_t elem_size, void *buf, size_t buf_size) {
     if (!r || !gmk_is_power_of_two(cap) || elem_size == 0 || !buf)
         return -1;
 
-    r->cap       = cap;
-    r->mask      = cap - 1;
-    r->elem_size = elem_size;
-    r->cell_size = cell_stride(elem_size);
-
-    if (buf_size < (size_t)cap * r->cell_size)
+    size_t need = gmk_ring_mpmc_buf_size(cap, elem_size, GMK_RING_PACKED);
+    if (buf_size < need)
         return -1;
 
-    r->buf = (uint8_t *)buf;
-    gmk_hal_memset(r->buf, 0, (size_t)cap * r->cell_size);
-
-    for (uint32_t i = 0; i < cap; i++) {
-        gmk_mpmc_cell_t *c = cell_at(r, i);
-        atomic_init(&c->seq, i);
-    }
-
-    atomic_init(&r->head, 0);
-    atomic_init(&r->tail, 0);
+    gmk_hal_memset(buf, 0, need);
+    ring_setup(r, cap, elem_size, GMK_RING_PACKED, (uint8_t *)buf, need);
     return 0;
 }
 
 void gmk_ring_mpmc_destroy(gmk_ring_mpmc_t *r) {
     if (r && r->buf) {
-        gmk_hal_page_free(r->buf, (size_t)r->cap * r->cell_size);
+        gmk_hal_page_free(r->buf, r->buf_bytes);
         r->buf = NULL;
     }
 }
 
-int gmk_ring_mpmc_push(gmk_ring_mpmc_t *r, const void *elem) {
+void *gmk_ring_mpmc_reserve(gmk_ring_mpmc_t *r, uint32_t *pos) {
     uint32_t tail;
-    gmk_mpmc_cell_t *c;
 
     tail = gmk_atomic_load(&r->tail, memory_order_relaxed);
     for (;;) {
-        c = cell_at(r, tail & r->mask);
-        uint32_t seq = gmk_atomic_load(&c->seq, memory_order_acquire);
+        uint32_t seq = seq_load(r, tail, memory_order_acquire);
         int32_t diff = (int32_t)seq - (int32_t)tail;
 
         if (diff == 0) {
@@ -91,27 +142,27 @@ int gmk_ring_mpmc_push(gmk_ring_mpmc_t *r, const void *elem) {
                 break;
         } else if (diff < 0) {
             /* Queue is full */
-            return -1;
+            return NULL;
         } else {
             /* Another producer claimed this slot, reload tail */
             tail = gmk_atomic_load(&r->tail, memory_order_relaxed);
         }
     }
 
-    /* Write data and publish */
-    gmk_hal_memcpy(c->data, elem, r->elem_size);
-    gmk_atomic_store(&c->seq, tail + 1, memory_order_release);
-    return 0;
+    *pos = tail;
+    return data_at(r, tail & r->mask);
 }
 
-int gmk_ring_mpmc_pop(gmk_ring_mpmc_t *r, void *elem) {
+void gmk_ring_mpmc_commit(gmk_ring_mpmc_t *r, uint32_t pos) {
+    seq_store(r, pos, pos + 1, memory_order_release);
+}
+
+const void *gmk_ring_mpmc_peek(gmk_ring_mpmc_t *r, uint32_t *pos) {
     uint32_t head;
-    gmk_mpmc_cell_t *c;
 
     head = gmk_atomic_load(&r->head, memory_order_relaxed);
     for (;;) {
-        c = cell_at(r, head & r->mask);
-        uint32_t seq = gmk_atomic_load(&c->seq, memory_order_acquire);
+        uint32_t seq = seq_load(r, head, memory_order_acquire);
         int32_t diff = (int32_t)seq - (int32_t)(head + 1);
 
         if (diff == 0) {
@@ -122,19 +173,146 @@ int gmk_ring_mpmc_pop(gmk_ring_mpmc_t *r, void *elem) {
                 break;
         } else if (diff < 0) {
             /* Queue is empty */
-            return -1;
+            return NULL;
         } else {
             /* Another consumer claimed this slot, reload head */
             head = gmk_atomic_load(&r->head, memory_order_relaxed);
         }
     }
 
-    /* Read data and release slot */
-    gmk_hal_memcpy(elem, c->data, r->elem_size);
-    gmk_atomic_store(&c->seq, head + r->cap, memory_order_release);
+    *pos = head;
+    return data_at(r, head & r->mask);
+}
+
+void gmk_ring_mpmc_release(gmk_ring_mpmc_t *r, uint32_t pos) {
+    seq_store(r, pos, pos + r->cap, memory_order_release);
+}
+
+int gmk_ring_mpmc_push(gmk_ring_mpmc_t *r, const void *elem) {
+    uint32_t pos;
+    void *slot = gmk_ring_mpmc_reserve(r, &pos);
+    if (!slot) return -1;
+
+    gmk_hal_memcpy(slot, elem, r->elem_size);
+    gmk_ring_mpmc_commit(r, pos);
+    return 0;
+}
+
+int gmk_ring_mpmc_pop(gmk_ring_mpmc_t *r, void *elem) {
+    uint32_t pos;
+    const void *slot = gmk_ring_mpmc_peek(r, &pos);
+    if (!slot) return -1;
+
+    gmk_hal_memcpy(elem, slot, r->elem_size);
+    gmk_ring_mpmc_release(r, pos);
     return 0;
 }
 
+/*
+ * Bulk variants: scan forward from tail/head while the cells are in the
+ * expected state, claim the whole run with one CAS, then fill/drain and
+ * publish each cell's sequence (in place for reserve_n/peek_n, by copy
+ * for push_n/pop_n). A successful CAS means no other thread
+ * moved the index since the scan, so every scanned cell is ours.
+ */
+uint32_t gmk_ring_mpmc_reserve_n(gmk_ring_mpmc_t *r, uint32_t n, uint32_t *pos) {
+    uint32_t tail, k;
+
+    if (n == 0) return 0;
+
+    tail = gmk_atomic_load(&r->tail, memory_order_relaxed);
+    for (;;) {
+        for (k = 0; k < n; k++) {
+            uint32_t seq = seq_load(r, tail + k, memory_order_acquire);
+            if (seq != tail + k) break;
+        }
+
+        if (k == 0) {
+            uint32_t seq = seq_load(r, tail, memory_order_acquire);
+            if ((int32_t)seq - (int32_t)tail < 0)
+                return 0; /* full */
+            tail = gmk_atomic_load(&r->tail, memory_order_relaxed);
+            continue;
+        }
+
+        if (gmk_atomic_cas_weak(&r->tail, &tail, tail + k,
+                                 memory_order_relaxed,
+                                 memory_order_relaxed))
+            break;
+    }
+
+    *pos = tail;
+    return k;
+}
+
+void gmk_ring_mpmc_commit_n(gmk_ring_mpmc_t *r, uint32_t pos, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++)
+        seq_store(r, pos + i, pos + i + 1, memory_order_release);
+}
+
+uint32_t gmk_ring_mpmc_peek_n(gmk_ring_mpmc_t *r, uint32_t max, uint32_t *pos) {
+    uint32_t head, k;
+
+    if (max == 0) return 0;
+
+    head = gmk_atomic_load(&r->head, memory_order_relaxed);
+    for (;;) {
+        for (k = 0; k < max; k++) {
+            uint32_t seq = seq_load(r, head + k, memory_order_acquire);
+            if (seq != head + k + 1) break;
+        }
+
+        if (k == 0) {
+            uint32_t seq = seq_load(r, head, memory_order_acquire);
+            if ((int32_t)seq - (int32_t)(head + 1) < 0)
+                return 0; /* empty */
+            head = gmk_atomic_load(&r->head, memory_order_relaxed);
+            continue;
+        }
+
+        if (gmk_atomic_cas_weak(&r->head, &head, head + k,
+                                 memory_order_relaxed,
+                                 memory_order_relaxed))
+            break;
+    }
+
+    *pos = head;
+    return k;
+}
+
+void gmk_ring_mpmc_release_n(gmk_ring_mpmc_t *r, uint32_t pos, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++)
+        seq_store(r, pos + i, pos + i + r->cap, memory_order_release);
+}
+
+void *gmk_ring_mpmc_slot(const gmk_ring_mpmc_t *r, uint32_t pos) {
+    return data_at(r, pos & r->mask);
+}
+
+uint32_t gmk_ring_mpmc_push_n(gmk_ring_mpmc_t *r, const void *elems, uint32_t n) {
+    const uint8_t *src = (const uint8_t *)elems;
+    uint32_t pos, k = gmk_ring_mpmc_reserve_n(r, n, &pos);
+
+    for (uint32_t i = 0; i < k; i++) {
+        gmk_hal_memcpy(data_at(r, (pos + i) & r->mask),
+                       src + (size_t)i * r->elem_size, r->elem_size);
+        seq_store(r, pos + i, pos + i + 1, memory_order_release);
+    }
+    return k;
+}
+
+uint32_t gmk_ring_mpmc_pop_n(gmk_ring_mpmc_t *r, void *out, uint32_t max) {
+    uint8_t *dst = (uint8_t *)out;
+    uint32_t pos, k = gmk_ring_mpmc_peek_n(r, max, &pos);
+
+    for (uint32_t i = 0; i < k; i++) {
+        gmk_hal_memcpy(dst + (size_t)i * r->elem_size,
+                       data_at(r, (pos + i) & r->mask), r->elem_size);
+        seq_store(r, pos + i, pos + i + r->cap, memory_order_release);
+    }
+    return k;
+}
+
 uint32_t gmk_ring_mpmc_count(const gmk_ring_mpmc_t *r) {
     uint32_t tail = gmk_atomic_load(&r->tail, memory_order_acquire);
     uint32_t head = gmk_atomic_load(&r->head, memory_order_acquire);
@@ -0,0 +1,147 @@
+/*
+ * GGMK/cpu — SPMC ring buffer implementation
+ *
+ * The producer publishes with a release store to tail. Consumers read the
+ * slot first and then claim it with a CAS on head; a failed CAS discards
+ * the copy. The producer never overwrites a slot until head has moved past
+ * it, so any slot a consumer successfully claims was read intact.
+ */
+#include "ggmk/ring_spmc.h"
+#include "ggmk/hal.h"
+
+int gmk_ring_spmc_init(gmk_ring_spmc_t *r, uint32_t cap, uint32_t elem_size) {
+    if (!r || !gmk_is_power_of_two(cap) || elem_size == 0)
+        return -1;
+
+    r->cap       = cap;
+    r->mask      = cap - 1;
+    r->elem_size = elem_size;
+    r->buf       = (uint8_t *)gmk_hal_page_alloc((size_t)cap * elem_size,
+                                                   GMK_CACHE_LINE);
+    if (!r->buf) return -1;
+
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+    return 0;
+}
+
+void gmk_ring_spmc_destroy(gmk_ring_spmc_t *r) {
+    if (r && r->buf) {
+        gmk_hal_page_free(r->buf, (size_t)r->cap * r->elem_size);
+        r->buf = NULL;
+    }
+}
+
+int gmk_ring_spmc_push(gmk_ring_spmc_t *r, const void *elem) {
+    uint32_t tail = gmk_atomic_load(&r->tail, memory_order_relaxed);
+    uint32_t head = gmk_atomic_load(&r->head, memory_order_acquire);
+
+    if (tail - head >= r->cap)
+        return -1; /* full */
+
+    uint32_t idx = tail & r->mask;
+    gmk_hal_memcpy(r->buf + (size_t)idx * r->elem_size, elem, r->elem_size);
+
+    gmk_atomic_store(&r->tail, tail + 1, memory_order_release);
+    return 0;
+}
+
+int gmk_ring_spmc_pop(gmk_ring_spmc_t *r, void *elem) {
+    uint32_t head = gmk_atomic_load(&r->head, memory_order_acquire);
+
+    for (;;) {
+        uint32_t tail = gmk_atomic_load(&r->tail, memory_order_acquire);
+        if (head == tail)
+            return -1; /* empty */
+
+        uint32_t idx = head & r->mask;
+        gmk_hal_memcpy(elem, r->buf + (size_t)idx * r->elem_size, r->elem_size);
+
+        if (gmk_atomic_cas_weak(&r->head, &head, head + 1,
+                                memory_order_acq_rel, memory_order_acquire))
+            return 0;
+        /* CAS failure reloaded head; retry */
+    }
+}
+
+uint32_t gmk_ring_spmc_pop_n(gmk_ring_spmc_t *r, void *out, uint32_t max) {
+    uint8_t *dst = (uint8_t *)out;
+    uint32_t esz = r->elem_size;
+    uint32_t head = gmk_atomic_load(&r->head, memory_order_acquire);
+
+    for (;;) {
+        uint32_t tail = gmk_atomic_load(&r->tail, memory_order_acquire);
+        uint32_t n = tail - head;
+        if (n > r->cap) {
+            head = gmk_atomic_load(&r->head, memory_order_acquire);
+            continue; /* stale head; retry */
+        }
+        if (n > max) n = max;
+        if (n == 0) return 0;
+
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t idx = (head + i) & r->mask;
+            gmk_hal_memcpy(dst + (size_t)i * esz,
+                           r->buf + (size_t)idx * esz, esz);
+        }
+
+        if (gmk_atomic_cas_weak(&r->head, &head, head + n,
+                                memory_order_acq_rel, memory_order_acquire))
+            return n;
+        /* CAS failure reloaded head; retry */
+    }
+}
+
+uint32_t gmk_ring_spmc_steal(gmk_ring_spmc_t *dst, gmk_ring_spmc_t *src,
+                             uint32_t max) {
+    if (!dst || !src || dst == src || dst->elem_size != src->elem_size)
+        return 0;
+
+    /* Room in dst. We are its only producer, so tail is stable. */
+    uint32_t dtail = gmk_atomic_load(&dst->tail, memory_order_relaxed);
+    uint32_t dhead = gmk_atomic_load(&dst->head, memory_order_acquire);
+    uint32_t room  = dst->cap - (dtail - dhead);
+    if (max > room) max = room;
+    if (max == 0) return 0;
+
+    uint32_t esz = src->elem_size;
+
+    for (;;) {
+        uint32_t head = gmk_atomic_load(&src->head, memory_order_acquire);
+        uint32_t tail = gmk_atomic_load(&src->tail, memory_order_acquire);
+        uint32_t n = tail - head;
+        if (n > src->cap)
+            continue;  /* head/tail read inconsistently; retry */
+        n = n - n / 2; /* take the larger half */
+        if (n == 0)
+            return 0;
+        if (n > max)
+            n = max;
+
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t si = (head + i) & src->mask;
+            uint32_t di = (dtail + i) & dst->mask;
+            gmk_hal_memcpy(dst->buf + (size_t)di * esz,
+                           src->buf + (size_t)si * esz, esz);
+        }
+
+        if (gmk_atomic_cas_strong(&src->head, &head, head + n,
+                                  memory_order_acq_rel, memory_order_acquire)) {
+            gmk_atomic_store(&dst->tail, dtail + n, memory_order_release);
+            return n;
+        }
+        /* Lost the race with another consumer; re-read and retry */
+    }
+}
+
+uint32_t gmk_ring_spmc_count(const gmk_ring_spmc_t *r) {
+    /* head first: head can only grow towards tail, so tail - head >= 0 */
+    uint32_t head = gmk_atomic_load(&r->head, memory_order_acquire);
+    uint32_t tail = gmk_atomic_load(&r->tail, memory_order_acquire);
+    uint32_t n = tail - head;
+    return n > r->cap ? r->cap : n;
+}
+
+bool gmk_ring_spmc_empty(const gmk_ring_spmc_t *r) {
+    return gmk_ring_spmc_count(r) == 0;
+}
@@ -42,31 +42,51 @@ void gmk_ring_spsc_destroy(gmk_ring_spsc_t *r) {
     }
 }
 
-int gmk_ring_spsc_push(gmk_ring_spsc_t *r, const void *elem) {
+void *gmk_ring_spsc_reserve(gmk_ring_spsc_t *r) {
     uint32_t tail = gmk_atomic_load(&r->tail, memory_order_relaxed);
     uint32_t head = gmk_atomic_load(&r->head, memory_order_acquire);
 
     if (tail - head >= r->cap)
-        return -1; /* full */
+        return NULL; /* full */
 
-    uint32_t idx = tail & r->mask;
-    gmk_hal_memcpy(r->buf + (size_t)idx * r->elem_size, elem, r->elem_size);
+    return r->buf + (size_t)(tail & r->mask) * r->elem_size;
+}
 
+void gmk_ring_spsc_commit(gmk_ring_spsc_t *r) {
+    uint32_t tail = gmk_atomic_load(&r->tail, memory_order_relaxed);
     gmk_atomic_store(&r->tail, tail + 1, memory_order_release);
-    return 0;
 }
 
-int gmk_ring_spsc_pop(gmk_ring_spsc_t *r, void *elem) {
+const void *gmk_ring_spsc_peek(gmk_ring_spsc_t *r) {
     uint32_t head = gmk_atomic_load(&r->head, memory_order_relaxed);
     uint32_t tail = gmk_atomic_load(&r->tail, memory_order_acquire);
 
     if (head == tail)
-        return -1; /* empty */
+        return NULL; /* empty */
 
-    uint32_t idx = head & r->mask;
-    gmk_hal_memcpy(elem, r->buf + (size_t)idx * r->elem_size, r->elem_size);
+    return r->buf + (size_t)(head & r->mask) * r->elem_size;
+}
 
+void gmk_ring_spsc_release(gmk_ring_spsc_t *r) {
+    uint32_t head = gmk_atomic_load(&r->head, memory_order_relaxed);
     gmk_atomic_store(&r->head, head + 1, memory_order_release);
+}
+
+int gmk_ring_spsc_push(gmk_ring_spsc_t *r, const void *elem) {
+    void *slot = gmk_ring_spsc_reserve(r);
+    if (!slot) return -1;
+
+    gmk_hal_memcpy(slot, elem, r->elem_size);
+    gmk_ring_spsc_commit(r);
+    return 0;
+}
+
+int gmk_ring_spsc_pop(gmk_ring_spsc_t *r, void *elem) {
+    const void *slot = gmk_ring_spsc_peek(r);
+    if (!slot) return -1;
+
+    gmk_hal_memcpy(elem, slot, r->elem_size);
+    gmk_ring_spsc_release(r);
     return 0;
 }
 
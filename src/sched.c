@@ -23,7 +23,11 @@ int gmk_sched_init(gmk_sched_t *s, uint32_t n_workers) {
         return -1;
     }
     for (uint32_t i = 0; i < n_workers; i++) {
-        if (gmk_lq_init(&s->lqs[i], GMK_LQ_DEFAULT_CAP) != 0) {
+        /* Ring buffers on the owning worker's node */
+        int prev = gmk_hal_mem_node(gmk_hal_worker_node(i));
+        int rc = gmk_lq_init(&s->lqs[i], GMK_LQ_DEFAULT_CAP);
+        gmk_hal_mem_node(prev);
+        if (rc != 0) {
             for (uint32_t j = 0; j < i; j++)
                 gmk_lq_destroy(&s->lqs[j]);
             gmk_hal_free(s->lqs);
@@ -32,19 +36,53 @@ int gmk_sched_init(gmk_sched_t *s, uint32_t n_workers) {
         }
     }
 
-    /* Initialize EVQ */
-    if (gmk_evq_init(&s->evq, GMK_EVQ_DEFAULT_CAP) != 0) {
+    /* Initialize EVQ shards: the default capacity split across workers */
+    uint32_t evq_cap = GMK_EVQ_DEFAULT_CAP / n_workers;
+    if (evq_cap < GMK_EVQ_SHARD_MIN_CAP) evq_cap = GMK_EVQ_SHARD_MIN_CAP;
+    s->evqs = (gmk_evq_t *)gmk_hal_calloc(n_workers, sizeof(gmk_evq_t));
+    if (!s->evqs) {
         for (uint32_t i = 0; i < n_workers; i++)
             gmk_lq_destroy(&s->lqs[i]);
         gmk_hal_free(s->lqs);
         gmk_rq_destroy(&s->rq);
         return -1;
     }
+    for (uint32_t i = 0; i < n_workers; i++) {
+        int prev = gmk_hal_mem_node(gmk_hal_worker_node(i));
+        int rc = gmk_evq_init(&s->evqs[i], evq_cap);
+        gmk_hal_mem_node(prev);
+        if (rc != 0) {
+            for (uint32_t j = 0; j < i; j++)
+                gmk_evq_destroy(&s->evqs[j]);
+            gmk_hal_free(s->evqs);
+            for (uint32_t j = 0; j < n_workers; j++)
+                gmk_lq_destroy(&s->lqs[j]);
+            gmk_hal_free(s->lqs);
+            gmk_rq_destroy(&s->rq);
+            return -1;
+        }
+    }
+    atomic_init(&s->evq_spread, 0);
 
     /* Initialize overflow bucket */
-    if (gmk_ring_mpmc_init(&s->overflow, GMK_OVERFLOW_CAP,
-                           sizeof(gmk_task_t)) != 0) {
-        gmk_evq_destroy(&s->evq);
+    if (gmk_ring_mpmc_init_layout(&s->overflow, GMK_OVERFLOW_CAP,
+                                  sizeof(gmk_task_t), GMK_TASK_RING_LAYOUT) != 0) {
+        for (uint32_t i = 0; i < n_workers; i++)
+            gmk_evq_destroy(&s->evqs[i]);
+        gmk_hal_free(s->evqs);
+        for (uint32_t i = 0; i < n_workers; i++)
+            gmk_lq_destroy(&s->lqs[i]);
+        gmk_hal_free(s->lqs);
+        gmk_rq_destroy(&s->rq);
+        return -1;
+    }
+
+    /* Initialize the deterministic lane */
+    if (gmk_det_init(&s->det, GMK_DET_DEFAULT_CAP, n_workers) != 0) {
+        gmk_ring_mpmc_destroy(&s->overflow);
+        for (uint32_t i = 0; i < n_workers; i++)
+            gmk_evq_destroy(&s->evqs[i]);
+        gmk_hal_free(s->evqs);
         for (uint32_t i = 0; i < n_workers; i++)
             gmk_lq_destroy(&s->lqs[i]);
         gmk_hal_free(s->lqs);
@@ -64,6 +102,12 @@ void gmk_sched_destroy(gmk_sched_t *s) {
         gmk_hal_free(s->lqs);
         s->lqs = NULL;
     }
-    gmk_evq_destroy(&s->evq);
+    if (s->evqs) {
+        for (uint32_t i = 0; i < s->n_workers; i++)
+            gmk_evq_destroy(&s->evqs[i]);
+        gmk_hal_free(s->evqs);
+        s->evqs = NULL;
+    }
     gmk_ring_mpmc_destroy(&s->overflow);
+    gmk_det_destroy(&s->det);
 }
@@ -0,0 +1,213 @@
+/*
+ * GGMK/cpu — Deterministic lane: canonical per-tick batches
+ *
+ * Pushes land unsorted in `pending` with a release tick and an order key.
+ * Opening a batch moves every task of the earliest release tick into
+ * `batch`, merge-sorts it by (type, priority, order) and stamps seq from
+ * the lane's own counter, so seq never depends on unrelated traffic. Runs
+ * of one type become groups; workers claim groups under the lock and the
+ * last gmk_det_done closes the batch. Nothing opens while a batch is
+ * running, which is the barrier between ticks: next_tick reads UINT64_MAX
+ * until then, so gmk_det_ready stays false for idle pollers.
+ */
+#include "ggmk/sched.h"
+#include "ggmk/hal.h"
+
+_Static_assert(sizeof(gmk_det_entry_t) == 64, "gmk_det_entry_t must be 64 bytes");
+
+#define HOST_ORDER  (1ull << 63)   /* host pushes sort after emissions */
+#define EMIT_BITS   24
+
+int gmk_det_init(gmk_det_t *d, uint32_t cap, uint32_t n_workers) {
+    if (!d || cap == 0 || n_workers == 0) return -1;
+
+    gmk_hal_memset(d, 0, sizeof(*d));
+    d->pending = (gmk_det_entry_t *)gmk_hal_calloc(cap, sizeof(gmk_det_entry_t));
+    d->batch   = (gmk_det_entry_t *)gmk_hal_calloc(cap, sizeof(gmk_det_entry_t));
+    d->scratch = (gmk_det_entry_t *)gmk_hal_calloc(cap, sizeof(gmk_det_entry_t));
+    d->groups  = (gmk_det_group_t *)gmk_hal_calloc(cap, sizeof(gmk_det_group_t));
+    d->emitter = (uint32_t *)gmk_hal_calloc(n_workers, sizeof(uint32_t));
+    d->emitted = (uint32_t *)gmk_hal_calloc(n_workers, sizeof(uint32_t));
+    if (!d->pending || !d->batch || !d->scratch || !d->groups ||
+        !d->emitter || !d->emitted) {
+        gmk_det_destroy(d);
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < n_workers; i++)
+        d->emitter[i] = GMK_DET_NONE;
+    d->cap = cap;
+    d->n_workers = n_workers;
+    atomic_init(&d->now, 0);
+    atomic_init(&d->next_tick, UINT64_MAX);
+    atomic_init(&d->unclaimed, 0);
+    gmk_lock_init(&d->lock);
+    return 0;
+}
+
+void gmk_det_destroy(gmk_det_t *d) {
+    if (!d) return;
+    gmk_hal_free(d->pending);
+    gmk_hal_free(d->batch);
+    gmk_hal_free(d->scratch);
+    gmk_hal_free(d->groups);
+    gmk_hal_free(d->emitter);
+    gmk_hal_free(d->emitted);
+    if (d->cap) gmk_lock_destroy(&d->lock);
+    d->pending = d->batch = d->scratch = NULL;
+    d->groups = NULL;
+    d->emitter = d->emitted = NULL;
+    d->cap = 0;
+}
+
+int gmk_det_push(gmk_det_t *d, const gmk_task_t *task) {
+    if (!d || !task) return -1;
+    uint32_t self = gmk_hal_self();
+
+    gmk_lock_acquire(&d->lock);
+    if (d->n_pending >= d->cap) {
+        gmk_lock_release(&d->lock);
+        return -1;
+    }
+
+    gmk_det_entry_t *e = &d->pending[d->n_pending++];
+    e->task = *task;
+    if (self < d->n_workers && d->emitter[self] != GMK_DET_NONE) {
+        e->tick  = d->tick + 1;
+        e->order = ((uint64_t)d->emitter[self] << EMIT_BITS) | d->emitted[self]++;
+    } else {
+        e->tick  = gmk_atomic_load(&d->now, memory_order_relaxed) + 1;
+        e->order = HOST_ORDER | d->host_order++;
+    }
+
+    /* While a batch runs next_tick stays UINT64_MAX (see gmk_det_done) */
+    if (d->groups_left == 0 &&
+        e->tick < gmk_atomic_load(&d->next_tick, memory_order_relaxed))
+        gmk_atomic_store(&d->next_tick, e->tick, memory_order_release);
+    gmk_lock_release(&d->lock);
+    return 0;
+}
+
+void gmk_det_advance(gmk_det_t *d, uint64_t tick) {
+    if (!d) return;
+    uint64_t cur = gmk_atomic_load(&d->now, memory_order_relaxed);
+    while (cur < tick &&
+           !gmk_atomic_cas_weak(&d->now, &cur, tick, memory_order_release,
+                                memory_order_relaxed))
+        ;
+}
+
+/* ── Batches ──────────────────────────────────────────────────── */
+static inline bool det_before(const gmk_det_entry_t *a, const gmk_det_entry_t *b) {
+    if (a->task.type != b->task.type) return a->task.type < b->task.type;
+    uint32_t pa = GMK_PRIORITY(a->task.flags), pb = GMK_PRIORITY(b->task.flags);
+    if (pa != pb) return pa < pb;
+    return a->order < b->order;
+}
+
+/* Bottom-up merge sort of batch[0..n) through scratch. The two buffers
+ * swap roles each pass; they are swapped back in d if the result ends up
+ * in scratch. */
+static void det_sort(gmk_det_t *d, uint32_t n) {
+    gmk_det_entry_t *src = d->batch, *dst = d->scratch;
+    for (uint32_t width = 1; width < n; width *= 2) {
+        for (uint32_t lo = 0; lo < n; lo += 2 * width) {
+            uint32_t mid = lo + width < n ? lo + width : n;
+            uint32_t hi  = lo + 2 * width < n ? lo + 2 * width : n;
+            uint32_t i = lo, j = mid, k = lo;
+            while (i < mid && j < hi)
+                dst[k++] = det_before(&src[j], &src[i]) ? src[j++] : src[i++];
+            while (i < mid) dst[k++] = src[i++];
+            while (j < hi)  dst[k++] = src[j++];
+        }
+        gmk_det_entry_t *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    d->batch = src;
+    d->scratch = dst;
+}
+
+static uint64_t det_earliest(const gmk_det_t *d) {
+    uint64_t t = UINT64_MAX;
+    for (uint32_t i = 0; i < d->n_pending; i++)
+        if (d->pending[i].tick < t) t = d->pending[i].tick;
+    return t;
+}
+
+/* Lock held, no batch open, something released by now. */
+static void det_open(gmk_det_t *d, uint64_t tick) {
+    uint32_t n = 0, keep = 0;
+    for (uint32_t i = 0; i < d->n_pending; i++) {
+        if (d->pending[i].tick == tick) d->batch[n++] = d->pending[i];
+        else                            d->pending[keep++] = d->pending[i];
+    }
+    d->n_pending = keep;
+    det_sort(d, n);
+
+    uint32_t groups = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        d->batch[i].task.seq = d->next_seq++;
+        if (i == 0 || d->batch[i].task.type != d->batch[i - 1].task.type)
+            d->groups[groups++] = (gmk_det_group_t){ i, 0 };
+        d->groups[groups - 1].len++;
+    }
+
+    d->tick = tick;
+    d->n_batch = n;
+    d->n_groups = groups;
+    d->next_group = 0;
+    d->groups_left = groups;
+    gmk_atomic_store(&d->next_tick, UINT64_MAX, memory_order_release);
+    gmk_atomic_store(&d->unclaimed, groups, memory_order_release);
+}
+
+int gmk_det_claim(gmk_det_t *d, gmk_det_group_t *g, uint64_t *tick) {
+    if (!d || !g || !gmk_det_ready(d)) return -1;
+
+    gmk_lock_acquire(&d->lock);
+    uint64_t next = gmk_atomic_load(&d->next_tick, memory_order_relaxed);
+    if (d->groups_left == 0 &&
+        next <= gmk_atomic_load(&d->now, memory_order_acquire))
+        det_open(d, next);
+
+    if (d->groups_left == 0 || d->next_group >= d->n_groups) {
+        gmk_lock_release(&d->lock);
+        return -1;
+    }
+    *g = d->groups[d->next_group++];
+    if (tick) *tick = d->tick;
+    gmk_atomic_store(&d->unclaimed, d->n_groups - d->next_group,
+                     memory_order_release);
+    gmk_lock_release(&d->lock);
+    return 0;
+}
+
+void gmk_det_done(gmk_det_t *d) {
+    if (!d) return;
+    gmk_lock_acquire(&d->lock);
+    if (d->groups_left > 0 && --d->groups_left == 0) {
+        d->n_batch = 0;
+        gmk_atomic_store(&d->next_tick, det_earliest(d), memory_order_release);
+    }
+    gmk_lock_release(&d->lock);
+}
+
+void gmk_det_begin(gmk_det_t *d, uint32_t worker, uint32_t idx) {
+    if (!d || worker >= d->n_workers) return;
+    d->emitter[worker] = idx;
+    d->emitted[worker] = 0;
+}
+
+void gmk_det_end(gmk_det_t *d, uint32_t worker) {
+    if (!d || worker >= d->n_workers) return;
+    d->emitter[worker] = GMK_DET_NONE;
+}
+
+uint32_t gmk_det_count(gmk_det_t *d) {
+    if (!d) return 0;
+    gmk_lock_acquire(&d->lock);
+    uint32_t n = d->n_pending + d->n_batch;
+    gmk_lock_release(&d->lock);
+    return n;
+}
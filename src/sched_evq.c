@@ -1,125 +1,361 @@
 /*
- * GGMK/cpu — Event Queue: bounded binary min-heap
+ * GGMK/cpu — Event Queue: hierarchical timing wheel
  *
- * Ordered by key = (tick << 32) | (priority << 16) | seq.
- * Lock-protected (heap ops aren't trivially lock-free).
- * Drain limit per check: GMK_EVQ_DRAIN_LIMIT.
+ * Eight 256-slot wheels cover a 64-bit tick. `now` is the next tick not
+ * yet staged; a timer sits on the level of the highest byte in which its
+ * tick differs from now, in the slot named by that byte. When now enters
+ * a slot on level l, the slot is cascaded: its timers are re-placed on
+ * lower levels. Level-0 slots hold a single tick; the earliest occupied
+ * one that is due is staged into four per-priority ready lists, which
+ * pop in (priority, seq) order before the next tick is staged.
+ *
+ * Per-level occupancy bitmaps let the position jump straight to the next
+ * occupied slot, so idle stretches cost no per-tick work. Lists are
+ * FIFO and cascades preserve order, so equal (tick, priority) timers
+ * keep push order. Timers pushed for a tick already staged are due at
+ * once. Lock-protected; drain limit per check: GMK_EVQ_DRAIN_LIMIT.
+ * next_due is republished under the lock after every change, so idle
+ * pollers can skip the lock until something is due. Tick UINT64_MAX is
+ * reserved: a timer armed for it never fires.
  */
 #include "ggmk/sched.h"
 #include "ggmk/hal.h"
 
-static inline uint64_t evq_key(const gmk_task_t *t, uint32_t seq) {
-    uint32_t tick = (uint32_t)t->meta0;  /* meta0 used as tick for EVQ */
-    uint32_t prio = GMK_PRIORITY(t->flags);
-    return ((uint64_t)tick << 32) | ((uint64_t)prio << 16) | (uint64_t)seq;
-}
-
-static void heap_sift_up(gmk_evq_entry_t *heap, uint32_t idx) {
-    while (idx > 0) {
-        uint32_t parent = (idx - 1) / 2;
-        if (heap[idx].key < heap[parent].key) {
-            gmk_evq_entry_t tmp = heap[idx];
-            heap[idx] = heap[parent];
-            heap[parent] = tmp;
-            idx = parent;
-        } else {
-            break;
+_Static_assert(sizeof(gmk_evq_node_t) == 64, "gmk_evq_node_t must be 64 bytes");
+
+#define SLOT_MASK  (GMK_EVQ_SLOTS - 1)
+#define NIL        UINT32_MAX
+
+static inline uint64_t node_tick(const gmk_evq_node_t *n) {
+    return n->task.meta0;  /* meta0 used as tick for EVQ */
+}
+
+/* ── Index-linked lists ───────────────────────────────────────── */
+static void list_append(gmk_evq_t *evq, uint32_t list, uint32_t idx) {
+    gmk_evq_list_t *l = &evq->lists[list];
+    gmk_evq_node_t *n = &evq->nodes[idx];
+    n->list = list;
+    n->next = NIL;
+    n->prev = l->tail;
+    if (l->tail != NIL) evq->nodes[l->tail].next = idx;
+    else                l->head = idx;
+    l->tail = idx;
+}
+
+static void list_unlink(gmk_evq_t *evq, uint32_t idx) {
+    gmk_evq_node_t *n = &evq->nodes[idx];
+    gmk_evq_list_t *l = &evq->lists[n->list];
+    if (n->prev != NIL) evq->nodes[n->prev].next = n->next;
+    else                l->head = n->next;
+    if (n->next != NIL) evq->nodes[n->next].prev = n->prev;
+    else                l->tail = n->prev;
+    n->list = GMK_EVQ_NO_LIST;
+}
+
+/* Detach a whole list; returns its old head. */
+static uint32_t list_take(gmk_evq_t *evq, uint32_t list) {
+    gmk_evq_list_t *l = &evq->lists[list];
+    uint32_t head = l->head;
+    l->head = l->tail = NIL;
+    return head;
+}
+
+/* ── Occupancy bitmaps ────────────────────────────────────────── */
+static inline void slot_mark(gmk_evq_t *evq, uint32_t level, uint32_t slot) {
+    evq->occupied[level][slot / 64] |= 1ull << (slot % 64);
+}
+
+static inline void slot_clear(gmk_evq_t *evq, uint32_t level, uint32_t slot) {
+    evq->occupied[level][slot / 64] &= ~(1ull << (slot % 64));
+}
+
+/* First occupied slot >= from on a level, or -1. */
+static int slot_next(const uint64_t *bits, uint32_t from) {
+    for (uint32_t w = from / 64; w < GMK_EVQ_SLOTS / 64; w++) {
+        uint64_t m = bits[w];
+        if (w == from / 64) m &= ~0ull << (from % 64);
+        if (m) return (int)(w * 64 + (uint32_t)__builtin_ctzll(m));
+    }
+    return -1;
+}
+
+/* ── Node pool: bump through fresh nodes, then the free list ──── */
+static uint32_t node_get(gmk_evq_t *evq) {
+    uint32_t idx;
+    if (evq->free_head != NIL) {
+        idx = evq->free_head;
+        evq->free_head = evq->nodes[idx].next;
+    } else if (evq->fresh < evq->cap) {
+        idx = evq->fresh++;
+        evq->nodes[idx].gen = 1;
+    } else {
+        return NIL;
+    }
+    return idx;
+}
+
+static void node_put(gmk_evq_t *evq, uint32_t idx) {
+    gmk_evq_node_t *n = &evq->nodes[idx];
+    n->gen = (n->gen + 1) & GMK_EVQ_GEN_MASK;
+    if (n->gen == 0) n->gen = 1;
+    n->list = GMK_EVQ_NO_LIST;
+    n->next = evq->free_head;
+    evq->free_head = idx;
+}
+
+/* ── Wheel ────────────────────────────────────────────────────── */
+static void wheel_place(gmk_evq_t *evq, uint32_t idx) {
+    gmk_evq_node_t *n = &evq->nodes[idx];
+    uint64_t tick = node_tick(n);
+
+    if (tick < evq->now) {
+        list_append(evq, GMK_EVQ_READY + GMK_PRIORITY(n->task.flags), idx);
+        evq->ready++;
+        return;
+    }
+
+    uint64_t diff  = tick ^ evq->now;
+    uint32_t level = diff ? (63u - (uint32_t)__builtin_clzll(diff)) / GMK_EVQ_SLOT_BITS : 0;
+    uint32_t slot  = (uint32_t)(tick >> (level * GMK_EVQ_SLOT_BITS)) & SLOT_MASK;
+    list_append(evq, level * GMK_EVQ_SLOTS + slot, idx);
+    slot_mark(evq, level, slot);
+}
+
+/* now just entered a new level-0 block: cascade every level whose slot
+ * boundary it crossed, top down so timers move one step at a time. */
+static void wheel_cascade(gmk_evq_t *evq) {
+    uint64_t now = evq->now;
+    if (now == 0 || (now & SLOT_MASK) != 0) return;
+
+    uint32_t top = (uint32_t)__builtin_ctzll(now) / GMK_EVQ_SLOT_BITS;
+    if (top >= GMK_EVQ_LEVELS) top = GMK_EVQ_LEVELS - 1;
+
+    for (uint32_t level = top; level >= 1; level--) {
+        uint32_t slot = (uint32_t)(now >> (level * GMK_EVQ_SLOT_BITS)) & SLOT_MASK;
+        uint32_t idx = list_take(evq, level * GMK_EVQ_SLOTS + slot);
+        slot_clear(evq, level, slot);
+        while (idx != NIL) {
+            uint32_t next = evq->nodes[idx].next;
+            wheel_place(evq, idx);
+            idx = next;
+        }
+    }
+}
+
+/* Level 0 is empty from now to the block end. Every level below the
+ * first occupied slot above is empty too, so nothing is due before that
+ * slot's first tick. UINT64_MAX if the wheel is empty. */
+static uint64_t wheel_jump(const gmk_evq_t *evq, uint64_t now) {
+    for (uint32_t level = 1; level < GMK_EVQ_LEVELS; level++) {
+        uint32_t shift = level * GMK_EVQ_SLOT_BITS;
+        uint32_t from  = ((uint32_t)(now >> shift) & SLOT_MASK) + 1;
+        int j = slot_next(evq->occupied[level], from);
+        if (j >= 0) {
+            /* Keep the bytes above this level (none on the top one) */
+            uint32_t above = shift + GMK_EVQ_SLOT_BITS;
+            uint64_t keep  = above >= 64 ? 0 : now & ~((1ull << above) - 1);
+            return keep | ((uint64_t)j << shift);
         }
     }
+    return UINT64_MAX;
 }
 
-static void heap_sift_down(gmk_evq_entry_t *heap, uint32_t count, uint32_t idx) {
-    for (;;) {
-        uint32_t smallest = idx;
-        uint32_t left  = 2 * idx + 1;
-        uint32_t right = 2 * idx + 2;
-
-        if (left < count && heap[left].key < heap[smallest].key)
-            smallest = left;
-        if (right < count && heap[right].key < heap[smallest].key)
-            smallest = right;
-
-        if (smallest != idx) {
-            gmk_evq_entry_t tmp = heap[idx];
-            heap[idx] = heap[smallest];
-            heap[smallest] = tmp;
-            idx = smallest;
-        } else {
-            break;
+/* Move now to the earliest occupied tick <= limit and stage its slot into
+ * the ready lists. Returns false if no timer is due by limit. */
+static bool wheel_advance(gmk_evq_t *evq, uint64_t limit) {
+    while (evq->now <= limit) {
+        uint64_t now = evq->now;
+        int s = slot_next(evq->occupied[0], (uint32_t)now & SLOT_MASK);
+
+        if (s >= 0) {
+            uint64_t tick = (now & ~(uint64_t)SLOT_MASK) | (uint32_t)s;
+            if (tick > limit) {
+                evq->now = limit + 1;  /* same block: no cascade */
+                return false;
+            }
+            uint32_t idx = list_take(evq, (uint32_t)s);
+            slot_clear(evq, 0, (uint32_t)s);
+            evq->now = tick + 1;
+            while (idx != NIL) {
+                uint32_t next = evq->nodes[idx].next;
+                wheel_place(evq, idx);  /* tick < now: lands on ready */
+                idx = next;
+            }
+            wheel_cascade(evq);
+            return true;
         }
+
+        uint64_t next = wheel_jump(evq, now);
+        /* Slots crossed on the way are empty, so cascading at a
+         * boundary short of next moves nothing */
+        evq->now = next > limit ? limit + 1 : next;
+        wheel_cascade(evq);
     }
+    return false;
+}
+
+/* Lower bound on the earliest pending tick, for next_due. Exact unless
+ * the next timer sits above level 0, where it is the slot's first tick. */
+static uint64_t wheel_next_tick(const gmk_evq_t *evq) {
+    if (evq->count == 0) return UINT64_MAX;
+
+    if (evq->ready > 0) {
+        uint64_t min = UINT64_MAX;
+        for (uint32_t p = 0; p < GMK_PRIORITY_COUNT; p++) {
+            uint32_t idx = evq->lists[GMK_EVQ_READY + p].head;
+            if (idx != NIL && node_tick(&evq->nodes[idx]) < min)
+                min = node_tick(&evq->nodes[idx]);
+        }
+        return min;
+    }
+
+    uint64_t now = evq->now;  /* wheel timers are >= now */
+    int s = slot_next(evq->occupied[0], (uint32_t)now & SLOT_MASK);
+    if (s >= 0) return (now & ~(uint64_t)SLOT_MASK) | (uint32_t)s;
+    return wheel_jump(evq, now);
+}
+
+static inline void publish_next_due(gmk_evq_t *evq) {
+    gmk_atomic_store(&evq->next_due, wheel_next_tick(evq), memory_order_release);
+}
+
+/* Pop the head of the best ready list that is due by current_tick. */
+static uint32_t ready_pop(gmk_evq_t *evq, uint64_t current_tick) {
+    for (uint32_t p = 0; p < GMK_PRIORITY_COUNT; p++) {
+        uint32_t idx = evq->lists[GMK_EVQ_READY + p].head;
+        if (idx == NIL || node_tick(&evq->nodes[idx]) > current_tick)
+            continue;
+        list_unlink(evq, idx);
+        evq->ready--;
+        return idx;
+    }
+    return NIL;
 }
 
 int gmk_evq_init(gmk_evq_t *evq, uint32_t cap) {
-    if (!evq || cap == 0) return -1;
+    if (!evq || cap == 0 || cap == NIL) return -1;
 
-    evq->heap = (gmk_evq_entry_t *)gmk_hal_calloc(cap, sizeof(gmk_evq_entry_t));
-    if (!evq->heap) return -1;
+    /* Nodes are handed out in order from `fresh`, so the zeroed pool
+     * needs no setup pass */
+    evq->nodes = (gmk_evq_node_t *)gmk_hal_calloc(cap, sizeof(gmk_evq_node_t));
+    if (!evq->nodes) return -1;
 
-    evq->count    = 0;
-    evq->cap      = cap;
-    evq->next_seq = 0;
+    for (uint32_t i = 0; i < GMK_EVQ_LISTS; i++)
+        evq->lists[i].head = evq->lists[i].tail = NIL;
+    for (uint32_t l = 0; l < GMK_EVQ_LEVELS; l++)
+        for (uint32_t w = 0; w < GMK_EVQ_SLOTS / 64; w++)
+            evq->occupied[l][w] = 0;
+
+    evq->now       = 0;
+    evq->count     = 0;
+    evq->ready     = 0;
+    evq->cap       = cap;
+    evq->fresh     = 0;
+    evq->free_head = NIL;
+    evq->next_seq  = 0;
+    atomic_init(&evq->next_due, UINT64_MAX);
     gmk_lock_init(&evq->lock);
     return 0;
 }
 
 void gmk_evq_destroy(gmk_evq_t *evq) {
     if (!evq) return;
-    gmk_hal_free(evq->heap);
-    evq->heap = NULL;
+    gmk_hal_free(evq->nodes);
+    evq->nodes = NULL;
     gmk_lock_destroy(&evq->lock);
 }
 
-int gmk_evq_push(gmk_evq_t *evq, const gmk_task_t *task) {
+int gmk_evq_arm(gmk_evq_t *evq, const gmk_task_t *task,
+                gmk_evq_handle_t *handle) {
     if (!evq || !task) return -1;
 
     gmk_lock_acquire(&evq->lock);
 
-    if (evq->count >= evq->cap) {
+    uint32_t idx = node_get(evq);
+    if (idx == NIL) {
         gmk_lock_release(&evq->lock);
         return -1; /* full */
     }
 
-    uint32_t seq = evq->next_seq++;
-    uint32_t idx = evq->count++;
-    evq->heap[idx].key  = evq_key(task, seq);
-    evq->heap[idx].task = *task;
-    evq->heap[idx].task.seq = seq;
-
-    heap_sift_up(evq->heap, idx);
+    gmk_evq_node_t *n = &evq->nodes[idx];
+    n->task = *task;
+    n->task.seq = evq->next_seq++;
+    wheel_place(evq, idx);
+    evq->count++;
+    if (node_tick(n) < gmk_atomic_load(&evq->next_due, memory_order_relaxed))
+        gmk_atomic_store(&evq->next_due, node_tick(n), memory_order_release);
+    if (handle) *handle = ((uint64_t)n->gen << 32) | idx;
 
     gmk_lock_release(&evq->lock);
     return 0;
 }
 
-int gmk_evq_pop_due(gmk_evq_t *evq, uint32_t current_tick, gmk_task_t *task) {
-    if (!evq || !task) return -1;
+int gmk_evq_push(gmk_evq_t *evq, const gmk_task_t *task) {
+    return gmk_evq_arm(evq, task, NULL);
+}
+
+int gmk_evq_cancel(gmk_evq_t *evq, gmk_evq_handle_t handle) {
+    if (!evq) return -1;
+    uint32_t idx = (uint32_t)handle;
+    uint32_t gen = (uint32_t)(handle >> 32) & GMK_EVQ_GEN_MASK;
 
     gmk_lock_acquire(&evq->lock);
 
-    if (evq->count == 0) {
+    if (idx >= evq->fresh || gen == 0 || evq->nodes[idx].gen != gen ||
+        evq->nodes[idx].list == GMK_EVQ_NO_LIST) {
         gmk_lock_release(&evq->lock);
-        return -1;
+        return -1; /* fired, cancelled, or never armed */
     }
 
-    /* Check if the minimum element is due */
-    uint32_t entry_tick = (uint32_t)(evq->heap[0].key >> 32);
-    if (entry_tick > current_tick) {
-        gmk_lock_release(&evq->lock);
-        return -1; /* not due yet */
+    uint32_t list = evq->nodes[idx].list;
+    list_unlink(evq, idx);
+    if (list >= GMK_EVQ_READY) {
+        evq->ready--;
+    } else if (evq->lists[list].head == NIL) {
+        slot_clear(evq, list / GMK_EVQ_SLOTS, list % GMK_EVQ_SLOTS);
     }
+    node_put(evq, idx);
+    evq->count--;
+    publish_next_due(evq);
 
-    *task = evq->heap[0].task;
+    gmk_lock_release(&evq->lock);
+    return 0;
+}
 
-    /* Remove root: move last element to root and sift down */
-    evq->count--;
-    if (evq->count > 0) {
-        evq->heap[0] = evq->heap[evq->count];
-        heap_sift_down(evq->heap, evq->count, 0);
+uint32_t gmk_evq_pop_due_n(gmk_evq_t *evq, uint64_t current_tick,
+                           gmk_task_t *out, uint32_t max) {
+    if (!evq || !out || max == 0) return 0;
+    if (current_tick == UINT64_MAX) current_tick--;  /* reserved */
+
+    gmk_lock_acquire(&evq->lock);
+
+    uint32_t n = 0;
+    while (n < max && evq->count > 0) {
+        uint32_t idx = ready_pop(evq, current_tick);
+        if (idx == NIL) {
+            /* Stage the next tick only once this one is drained, so
+             * priority never reorders across ticks */
+            if (evq->ready > 0 || !wheel_advance(evq, current_tick))
+                break;
+            continue;
+        }
+        out[n++] = evq->nodes[idx].task;
+        node_put(evq, idx);
+        evq->count--;
     }
 
+    /* An empty wheel can skip ahead without walking the slots */
+    if (evq->count == 0 && evq->now <= current_tick)
+        evq->now = current_tick + 1;
+    publish_next_due(evq);
+
     gmk_lock_release(&evq->lock);
-    return 0;
+    return n;
+}
+
+int gmk_evq_pop_due(gmk_evq_t *evq, uint64_t current_tick, gmk_task_t *task) {
+    if (!task) return -1;
+    return gmk_evq_pop_due_n(evq, current_tick, task, 1) == 1 ? 0 : -1;
 }
 
 uint32_t gmk_evq_count(const gmk_evq_t *evq) {
@@ -1,7 +1,11 @@
 /*
- * GGMK/cpu — Local Queue: SPSC per worker with yield watermark
+ * GGMK/cpu — Local Queue: SPMC per worker with yield watermark
  *
  * Normal push fails past 75% fill. Yield push uses full capacity.
+ * Only the owning worker pushes to the ring; idle siblings steal half at
+ * a time. Other threads target a worker through its MPMC inbox, which
+ * the owner splices into the ring when the ring runs dry and every
+ * GMK_LQ_INBOX_POLL pops, so remote work is never starved by yields.
  */
 #include "ggmk/sched.h"
 
@@ -9,38 +13,115 @@ int gmk_lq_init(gmk_lq_t *lq, uint32_t cap) {
     if (!lq) return -1;
     lq->cap = cap;
     lq->yield_watermark = cap - (cap * GMK_LQ_YIELD_RESERVE_PCT / 100);
+    lq->pops = 0;
 
-    return gmk_ring_spsc_init(&lq->ring, cap, sizeof(gmk_task_t));
+    if (gmk_ring_spmc_init(&lq->ring, cap, sizeof(gmk_task_t)) != 0)
+        return -1;
+    if (gmk_ring_mpmc_init_layout(&lq->inbox, cap, sizeof(gmk_task_t),
+                                  GMK_TASK_RING_LAYOUT) != 0) {
+        gmk_ring_spmc_destroy(&lq->ring);
+        return -1;
+    }
+    return 0;
 }
 
 void gmk_lq_destroy(gmk_lq_t *lq) {
     if (!lq) return;
-    gmk_ring_spsc_destroy(&lq->ring);
+    gmk_ring_spmc_destroy(&lq->ring);
+    gmk_ring_mpmc_destroy(&lq->inbox);
 }
 
 int gmk_lq_push(gmk_lq_t *lq, const gmk_task_t *task) {
     if (!lq || !task) return -1;
 
     /* Normal push: respect yield watermark */
-    if (gmk_ring_spsc_count(&lq->ring) >= lq->yield_watermark)
+    if (gmk_ring_spmc_count(&lq->ring) >= lq->yield_watermark)
         return -1;
 
-    return gmk_ring_spsc_push(&lq->ring, task);
+    return gmk_ring_spmc_push(&lq->ring, task);
 }
 
 int gmk_lq_push_yield(gmk_lq_t *lq, const gmk_task_t *task) {
     if (!lq || !task) return -1;
 
     /* Yield push: use full capacity */
-    return gmk_ring_spsc_push(&lq->ring, task);
+    return gmk_ring_spmc_push(&lq->ring, task);
+}
+
+int gmk_lq_push_remote(gmk_lq_t *lq, const gmk_task_t *task) {
+    if (!lq || !task) return -1;
+    return gmk_ring_mpmc_push(&lq->inbox, task);
+}
+
+/* Move up to max inbox tasks into dst's ring, stopping at dst's
+ * watermark. Caller must own dst. */
+static uint32_t lq_splice(gmk_lq_t *dst, gmk_lq_t *src, uint32_t max) {
+    uint32_t have = gmk_ring_spmc_count(&dst->ring);
+    if (have >= dst->yield_watermark) return 0;
+    uint32_t room = dst->yield_watermark - have;
+    if (max > room) max = room;
+
+    /* Copy straight from the inbox cell into the ring: one copy per task */
+    uint32_t moved = 0, pos;
+    const gmk_task_t *t;
+    while (moved < max && (t = gmk_ring_mpmc_peek(&src->inbox, &pos)) != NULL) {
+        gmk_ring_spmc_push(&dst->ring, t);
+        gmk_ring_mpmc_release(&src->inbox, pos);
+        moved++;
+    }
+    return moved;
 }
 
 int gmk_lq_pop(gmk_lq_t *lq, gmk_task_t *task) {
     if (!lq || !task) return -1;
-    return gmk_ring_spsc_pop(&lq->ring, task);
+
+    if (gmk_ring_spmc_pop(&lq->ring, task) == 0) {
+        if (++lq->pops % GMK_LQ_INBOX_POLL == 0)
+            lq_splice(lq, lq, GMK_LQ_INBOX_POLL);
+        return 0;
+    }
+
+    /* Ring dry: splice the inbox in bulk, then retry */
+    if (lq_splice(lq, lq, UINT32_MAX) == 0)
+        return -1;
+    return gmk_ring_spmc_pop(&lq->ring, task);
+}
+
+uint32_t gmk_lq_pop_n(gmk_lq_t *lq, gmk_task_t *out, uint32_t max) {
+    if (!lq || !out || max == 0) return 0;
+
+    /* Pull pending inbox work in first so one CAS covers both sources */
+    uint32_t have = gmk_ring_spmc_count(&lq->ring);
+    if (have < max)
+        lq_splice(lq, lq, max - have);
+
+    uint32_t n = gmk_ring_spmc_pop_n(&lq->ring, out, max);
+
+    /* Same inbox pacing as gmk_lq_pop when the ring stays busy */
+    uint32_t before = lq->pops;
+    lq->pops += n;
+    if (before / GMK_LQ_INBOX_POLL != lq->pops / GMK_LQ_INBOX_POLL)
+        lq_splice(lq, lq, GMK_LQ_INBOX_POLL);
+    return n;
 }
 
 uint32_t gmk_lq_count(const gmk_lq_t *lq) {
     if (!lq) return 0;
-    return gmk_ring_spsc_count(&lq->ring);
+    return gmk_ring_spmc_count(&lq->ring) + gmk_ring_mpmc_count(&lq->inbox);
+}
+
+uint32_t gmk_lq_steal(gmk_lq_t *thief, gmk_lq_t *victim) {
+    if (!thief || !victim || thief == victim) return 0;
+
+    /* Stolen tasks are normal pushes: leave the yield reserve untouched */
+    uint32_t have = gmk_ring_spmc_count(&thief->ring);
+    if (have >= thief->yield_watermark) return 0;
+
+    uint32_t got = gmk_ring_spmc_steal(&thief->ring, &victim->ring,
+                                       thief->yield_watermark - have);
+    if (got > 0) return got;
+
+    /* Victim's ring is empty but its owner may be busy: take half its inbox */
+    uint32_t pending = gmk_ring_mpmc_count(&victim->inbox);
+    return lq_splice(thief, victim, pending - pending / 2);
 }
@@ -3,17 +3,28 @@
  *
  * Weights: P0=8, P1=4, P2=2, P3=1.
  * Each weight-batch pops that many tasks before moving to the next priority.
+ * Bulk variants move each priority's share with a single ring CAS.
  */
 #include "ggmk/sched.h"
 #include <string.h>
 
+static const uint32_t weights[GMK_PRIORITY_COUNT] = {
+    GMK_WEIGHT_P0, GMK_WEIGHT_P1, GMK_WEIGHT_P2, GMK_WEIGHT_P3
+};
+
+static uint32_t rq_prio(const gmk_task_t *task) {
+    uint32_t prio = GMK_PRIORITY(task->flags);
+    return prio >= GMK_PRIORITY_COUNT ? GMK_PRIO_LOW : prio;
+}
+
 int gmk_rq_init(gmk_rq_t *rq, uint32_t cap_per_queue) {
     if (!rq) return -1;
     memset(rq, 0, sizeof(*rq));
 
     for (int i = 0; i < GMK_PRIORITY_COUNT; i++) {
-        if (gmk_ring_mpmc_init(&rq->queues[i], cap_per_queue,
-                               sizeof(gmk_task_t)) != 0) {
+        if (gmk_ring_mpmc_init_layout(&rq->queues[i], cap_per_queue,
+                                      sizeof(gmk_task_t),
+                                      GMK_TASK_RING_LAYOUT) != 0) {
             for (int j = 0; j < i; j++)
                 gmk_ring_mpmc_destroy(&rq->queues[j]);
             return -1;
@@ -31,18 +42,60 @@ void gmk_rq_destroy(gmk_rq_t *rq) {
 
 int gmk_rq_push(gmk_rq_t *rq, const gmk_task_t *task) {
     if (!rq || !task) return -1;
-    uint32_t prio = GMK_PRIORITY(task->flags);
-    if (prio >= GMK_PRIORITY_COUNT) prio = GMK_PRIO_LOW;
-    return gmk_ring_mpmc_push(&rq->queues[prio], task);
+    return gmk_ring_mpmc_push(&rq->queues[rq_prio(task)], task);
+}
+
+uint32_t gmk_rq_push_n(gmk_rq_t *rq, const gmk_task_t *tasks, uint32_t n) {
+    if (!rq || !tasks) return 0;
+
+    uint32_t done = 0;
+    while (done < n) {
+        /* Extend the run while priority stays the same */
+        uint32_t prio = rq_prio(&tasks[done]);
+        uint32_t run = 1;
+        while (done + run < n && rq_prio(&tasks[done + run]) == prio)
+            run++;
+
+        uint32_t got = gmk_ring_mpmc_push_n(&rq->queues[prio],
+                                            &tasks[done], run);
+        done += got;
+        if (got < run) break; /* that priority's queue is full */
+    }
+    return done;
+}
+
+uint32_t gmk_rq_pop_n(gmk_rq_t *rq, gmk_task_t *out, uint32_t max) {
+    if (!rq || !out) return 0;
+
+    uint32_t n = 0;
+    bool reset = false;
+    while (n < max) {
+        uint32_t round = 0;
+        for (int prio = 0; prio < GMK_PRIORITY_COUNT && n < max; prio++) {
+            if (rq->pop_counters[prio] >= weights[prio]) continue;
+            uint32_t want = weights[prio] - rq->pop_counters[prio];
+            if (want > max - n) want = max - n;
+            uint32_t got = gmk_ring_mpmc_pop_n(&rq->queues[prio], out + n, want);
+            rq->pop_counters[prio] += got;
+            n += got;
+            round += got;
+        }
+        if (n == max) break;
+
+        /* Budgets spent or queues empty: start a new weight round.
+         * An empty round on fresh budgets means every queue is empty. */
+        if (round == 0 && reset) break;
+        for (int prio = 0; prio < GMK_PRIORITY_COUNT; prio++)
+            rq->pop_counters[prio] = 0;
+        reset = true;
+    }
+    return n;
 }
 
 int gmk_rq_pop(gmk_rq_t *rq, gmk_task_t *task) {
     if (!rq || !task) return -1;
 
     /* Weighted pop: try priorities in order with their weights */
-    static const uint32_t weights[GMK_PRIORITY_COUNT] = {
-        GMK_WEIGHT_P0, GMK_WEIGHT_P1, GMK_WEIGHT_P2, GMK_WEIGHT_P3
-    };
 
     for (int prio = 0; prio < GMK_PRIORITY_COUNT; prio++) {
         if (rq->pop_counters[prio] < weights[prio]) {
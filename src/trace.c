@@ -39,6 +39,7 @@ static inline uint32_t ev_level(uint32_t ev_type) {
     case GMK_EV_CHAN_CLOSE:
     case GMK_EV_WORKER_PARK:
     case GMK_EV_WORKER_WAKE:
+    case GMK_EV_WORKER_STEAL:
     case GMK_EV_BOOT:
     case GMK_EV_HALT:
         return GMK_TRACE_INFO;
@@ -82,21 +83,22 @@ static void trace_emit(gmk_trace_t *t, uint16_t tenant, uint32_t ev_type,
                        uint16_t task_type, uint32_t arg0, uint32_t arg1) {
     if (tenant >= t->n_tenants) return;
 
-    gmk_trace_ev_t ev = {
-        .tsc     = gmk_tsc(),
-        .ev_type = ev_type,
-        .tenant  = tenant,
-        .type    = task_type,
-        .arg0    = arg0,
-        .arg1    = arg1,
-        ._pad    = 0,
-    };
-
-    if (gmk_ring_spsc_push(&t->rings[tenant], &ev) == 0) {
-        gmk_atomic_add(&t->total_events, 1, memory_order_relaxed);
-    } else {
+    /* Build the event directly in the ring slot */
+    gmk_trace_ev_t *ev = (gmk_trace_ev_t *)gmk_ring_spsc_reserve(&t->rings[tenant]);
+    if (!ev) {
         gmk_atomic_add(&t->dropped_events, 1, memory_order_relaxed);
+        return;
     }
+
+    ev->tsc     = gmk_tsc();
+    ev->ev_type = ev_type;
+    ev->tenant  = tenant;
+    ev->type    = task_type;
+    ev->arg0    = arg0;
+    ev->arg1    = arg1;
+    ev->_pad    = 0;
+    gmk_ring_spsc_commit(&t->rings[tenant]);
+    gmk_atomic_add(&t->total_events, 1, memory_order_relaxed);
 }
 
 void gmk_trace_write(gmk_trace_t *t, uint16_t tenant, uint32_t ev_type,
@@ -1,5 +1,5 @@
 /*
- * GGMK/cpu — Worker thread loop (gather-dispatch-park)
+ * GGMK/cpu — Worker thread loop (gather-sort-dispatch-steal-park)
  */
 #include "ggmk/worker.h"
 #include "ggmk/alloc.h"
@@ -7,17 +7,26 @@
 #include "ggmk/metrics.h"
 #include "ggmk/hal.h"
 
-static void worker_dispatch_task(gmk_worker_t *w, gmk_task_t *task) {
+/* Allocator for the task's tenant */
+static inline gmk_alloc_t *worker_alloc(const gmk_worker_t *w, uint16_t tenant) {
+    if (w->tenant_alloc && tenant < GMK_MAX_TENANTS && w->tenant_alloc[tenant])
+        return w->tenant_alloc[tenant];
+    return w->alloc;
+}
+
+static void worker_dispatch_task(gmk_worker_t *w, gmk_task_t *task,
+                                 uint64_t tick) {
+    gmk_alloc_t *alloc = worker_alloc(w, task->tenant);
     gmk_ctx_t ctx = {
         .task      = task,
-        .alloc     = w->alloc,
+        .alloc     = alloc,
         .chan       = w->chan,
         .trace     = w->trace,
         .metrics   = w->metrics,
         .sched     = w->sched,
         .kernel    = w->kernel,
         .worker_id = w->id,
-        .tick      = gmk_atomic_load(&w->tick, memory_order_relaxed),
+        .tick      = tick,
     };
 
     if (w->metrics)
@@ -30,7 +39,7 @@ static void worker_dispatch_task(gmk_worker_t *w, gmk_task_t *task) {
         gmk_atomic_add(&w->tasks_dispatched, 1, memory_order_relaxed);
         /* Release refcounted payload — handler is done with it */
         if ((task->flags & GMK_TF_PAYLOAD_RC) && task->payload_ptr)
-            gmk_payload_release(w->alloc, (void *)(uintptr_t)task->payload_ptr);
+            gmk_payload_release(alloc, (void *)(uintptr_t)task->payload_ptr);
     } else if (rc == GMK_RETRY) {
         /* Re-enqueue for retry — keep payload ref alive */
         _gmk_enqueue(w->sched, task, -1);
@@ -41,77 +50,317 @@ static void worker_dispatch_task(gmk_worker_t *w, gmk_task_t *task) {
         /* Failure — release refcounted payload */
         gmk_module_record_fail(w->modules, task->type);
         if ((task->flags & GMK_TF_PAYLOAD_RC) && task->payload_ptr)
-            gmk_payload_release(w->alloc, (void *)(uintptr_t)task->payload_ptr);
+            gmk_payload_release(alloc, (void *)(uintptr_t)task->payload_ptr);
         if (w->metrics)
             gmk_metric_inc(w->metrics, task->tenant,
                           GMK_METRIC_TASKS_FAILED, 1);
     }
 }
 
-void *gmk_worker_loop(void *arg) {
-    gmk_worker_t *w = (gmk_worker_t *)arg;
-    gmk_task_t task;
+static uint32_t worker_rng_next(gmk_worker_t *w) {
+    uint32_t x = w->steal_rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    w->steal_rng = x;
+    return x;
+}
 
-    while (gmk_atomic_load(&w->running, memory_order_acquire)) {
-        bool got_work = false;
+/* Steal half of a random sibling's LQ into ours. Scans every victim
+ * once, starting at a random offset, so a single hot LQ is always found. */
+static bool worker_steal(gmk_worker_t *w) {
+    gmk_sched_t *s = w->sched;
+    uint32_t n = s->n_workers;
+    if (n < 2 || w->id >= n) return false;
 
-        /* 1. Pop from own LQ */
-        if (gmk_lq_pop(&w->sched->lqs[w->id], &task) == 0) {
-            got_work = true;
+    uint32_t start = worker_rng_next(w) % n;
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t v = (start + i) % n;
+        if (v == w->id) continue;
+
+        uint32_t got = gmk_lq_steal(&s->lqs[w->id], &s->lqs[v]);
+        if (got > 0) {
             if (w->metrics)
-                gmk_metric_inc(w->metrics, task.tenant,
-                              GMK_METRIC_TASKS_DEQUEUED, 1);
-            worker_dispatch_task(w, &task);
+                gmk_metric_inc(w->metrics, 0, GMK_METRIC_TASKS_STOLEN, got);
+            if (w->trace)
+                gmk_trace_write(w->trace, 0, GMK_EV_WORKER_STEAL,
+                               0, v, got);
+            return true;
         }
+    }
+    return false;
+}
 
-        /* 2. Pop from overflow bucket */
-        if (!got_work && gmk_ring_mpmc_pop(&w->sched->overflow, &task) == 0) {
-            got_work = true;
-            if (w->metrics)
-                gmk_metric_inc(w->metrics, task.tenant,
-                              GMK_METRIC_TASKS_DEQUEUED, 1);
-            worker_dispatch_task(w, &task);
+/* Our LQ has a backlog: nudge one parked sibling so it can steal. */
+static void worker_wake_thief(gmk_worker_t *w) {
+    gmk_atomic_fence(memory_order_seq_cst);   /* see gmk_worker_wake */
+    for (uint32_t i = 0; i < w->n_siblings; i++) {
+        gmk_worker_t *sib = &w->siblings[i];
+        if (sib == w) continue;
+        if (gmk_atomic_load(&sib->parked, memory_order_acquire)) {
+            gmk_hal_park_wake(&sib->park);
+            return;
         }
+    }
+}
 
-        /* 3. Pop from RQ */
-        if (!got_work && gmk_rq_pop(&w->sched->rq, &task) == 0) {
-            got_work = true;
-            if (w->metrics)
-                gmk_metric_inc(w->metrics, task.tenant,
-                              GMK_METRIC_TASKS_DEQUEUED, 1);
-            worker_dispatch_task(w, &task);
+/* Fair share of a shared queue: leave work for the other workers. */
+static uint32_t worker_share(const gmk_worker_t *w, uint32_t queued,
+                             uint32_t room) {
+    uint32_t share = queued / w->sched->n_workers + 1;
+    return share < room ? share : room;
+}
+
+/* Gather up to batch_size tasks: own LQ first, topped up with a fair
+ * share of the overflow bucket and the RQ. Each source is one bulk pop. */
+static uint32_t worker_gather(gmk_worker_t *w) {
+    gmk_sched_t *s = w->sched;
+    uint32_t max = w->batch_size;
+    uint32_t n = gmk_lq_pop_n(&s->lqs[w->id], w->batch, max);
+
+    if (n < max)
+        n += gmk_ring_mpmc_pop_n(&s->overflow, &w->batch[n],
+                                 worker_share(w, gmk_ring_mpmc_count(&s->overflow),
+                                              max - n));
+    if (n < max)
+        n += gmk_rq_pop_n(&s->rq, &w->batch[n],
+                          worker_share(w, gmk_rq_count(&s->rq), max - n));
+    return n;
+}
+
+/* Stable insertion sort of batch indices by type. Batches are small and
+ * usually hold few distinct types, so this is near-linear in practice. */
+static void worker_sort_batch(gmk_worker_t *w, uint32_t n) {
+    uint16_t *order = w->batch_order;
+    for (uint32_t i = 0; i < n; i++)
+        order[i] = (uint16_t)i;
+
+    for (uint32_t i = 1; i < n; i++) {
+        uint16_t cur = order[i];
+        uint32_t key = w->batch[cur].type;
+        uint32_t j = i;
+        while (j > 0 && w->batch[order[j - 1]].type > key) {
+            order[j] = order[j - 1];
+            j--;
         }
+        order[j] = cur;
+    }
+}
 
-        /* 4. Check EVQ for due events */
-        if (!got_work) {
-            uint32_t tick = gmk_atomic_load(&w->tick, memory_order_relaxed);
-            uint32_t evq_drained = 0;
-            while (evq_drained < GMK_EVQ_DRAIN_LIMIT &&
-                   gmk_evq_pop_due(&w->sched->evq, tick, &task) == 0) {
-                got_work = true;
-                evq_drained++;
-                _gmk_enqueue(w->sched, &task, (int)w->id);
+#define WORKER_PREFETCH_DIST 4
+
+static void worker_prefetch(gmk_worker_t *w, uint32_t i, uint32_t n) {
+    if (i >= n) return;
+    uint64_t p = w->batch[w->batch_order[i]].payload_ptr;
+    if (p) gmk_prefetch((const void *)(uintptr_t)p);
+}
+
+/* Dispatch a gathered batch grouped by type, prefetching payloads ahead. */
+static void worker_dispatch_batch(gmk_worker_t *w, uint32_t n) {
+    worker_sort_batch(w, n);
+
+    uint64_t tick = gmk_atomic_load(&w->tick, memory_order_relaxed);
+    for (uint32_t i = 0; i < WORKER_PREFETCH_DIST; i++)
+        worker_prefetch(w, i, n);
+
+    for (uint32_t i = 0; i < n; i++) {
+        worker_prefetch(w, i + WORKER_PREFETCH_DIST, n);
+
+        gmk_task_t *task = &w->batch[w->batch_order[i]];
+        if (w->metrics)
+            gmk_metric_inc(w->metrics, task->tenant,
+                          GMK_METRIC_TASKS_DEQUEUED, 1);
+        worker_dispatch_task(w, task, tick);
+    }
+}
+
+/* Run one group of the deterministic lane: a single type's tasks for the
+ * batch tick, in canonical order. Leftover groups wake a parked sibling,
+ * which claims one and passes the wake on. */
+static bool worker_det(gmk_worker_t *w) {
+    gmk_det_t *d = &w->sched->det;
+    gmk_det_group_t g;
+    uint64_t tick;
+    if (gmk_det_claim(d, &g, &tick) != 0) return false;
+    if (gmk_atomic_load(&d->unclaimed, memory_order_acquire) > 0)
+        worker_wake_thief(w);
+
+    gmk_epoch_enter(w->epoch, w->id, &w->tick);
+    for (uint32_t i = g.start; i < g.start + g.len; i++) {
+        gmk_task_t task = d->batch[i].task;
+        if (w->metrics)
+            gmk_metric_inc(w->metrics, task.tenant,
+                          GMK_METRIC_TASKS_DEQUEUED, 1);
+        gmk_det_begin(d, w->id, i);
+        worker_dispatch_task(w, &task, tick);
+        gmk_det_end(d, w->id);
+    }
+    gmk_epoch_exit(w->epoch, w->id);
+
+    gmk_det_done(d);
+    return true;
+}
+
+/* Worker 0 moves block pages between bins while idle, at most once per
+ * GMK_ALLOC_REBALANCE_NS, and refreshes the allocator gauges. */
+static void worker_rebalance(gmk_worker_t *w) {
+    if (w->id != 0 || !w->alloc) return;
+    uint64_t now = gmk_hal_now_ns();
+    if (now - w->rebalance_ns < GMK_ALLOC_REBALANCE_NS) return;
+    w->rebalance_ns = now;
+    gmk_alloc_rebalance(w->alloc);
+    gmk_alloc_publish(w->alloc);
+    for (uint32_t t = 0; w->tenant_alloc && t < GMK_MAX_TENANTS; t++) {
+        if (!w->tenant_alloc[t]) continue;
+        gmk_alloc_rebalance(w->tenant_alloc[t]);
+        gmk_alloc_publish(w->tenant_alloc[t]);
+    }
+}
+
+/* Expire due timers, up to GMK_EVQ_DRAIN_LIMIT, a batch per lock hold
+ * (the batch buffer is free between dispatches). Own shard first, into
+ * our LQ; then siblings' shards that are a full tick late (their owner is
+ * busy), into the owner's inbox. The next_due peek skips the lock on
+ * shards with nothing due. */
+static uint32_t worker_expire(gmk_worker_t *w) {
+    gmk_sched_t *s = w->sched;
+    uint64_t tick = gmk_atomic_load(&w->tick, memory_order_relaxed);
+    uint32_t drained = 0;
+
+    for (uint32_t k = 0; k < s->n_workers && drained < GMK_EVQ_DRAIN_LIMIT; k++) {
+        uint32_t owner = (w->id + k) % s->n_workers;
+        gmk_evq_t *evq = &s->evqs[owner];
+        uint64_t due = gmk_evq_next_due(evq);
+        if (due > tick || (owner != w->id && due == tick))
+            continue;
+
+        while (drained < GMK_EVQ_DRAIN_LIMIT) {
+            uint32_t want = GMK_EVQ_DRAIN_LIMIT - drained;
+            if (want > GMK_WORKER_BATCH_MAX) want = GMK_WORKER_BATCH_MAX;
+            uint32_t got = gmk_evq_pop_due_n(evq, tick, w->batch, want);
+            if (got == 0) break;
+            drained += got;
+            if (owner == w->id) {
+                for (uint32_t i = 0; i < got; i++)
+                    _gmk_enqueue_local(s, &w->batch[i], w->id);
+            } else {
+                _gmk_enqueue_n(s, w->batch, got, (int)owner);
             }
         }
+    }
+    return drained;
+}
 
-        /* 5. Park if no work */
-        if (!got_work) {
-            gmk_atomic_store(&w->parked, true, memory_order_release);
-            if (w->metrics)
-                gmk_metric_inc(w->metrics, 0, GMK_METRIC_WORKER_PARKS, 1);
-            if (w->trace)
-                gmk_trace_write(w->trace, 0, GMK_EV_WORKER_PARK,
-                               0, w->id, 0);
+/* Would the next iteration find work? Own LQ, the shared queues, the
+ * deterministic lane and due timers; sibling LQs only via wake_thief. */
+static bool worker_has_work(gmk_worker_t *w) {
+    gmk_sched_t *s = w->sched;
+    if (gmk_lq_count(&s->lqs[w->id]) > 0 ||
+        gmk_rq_count(&s->rq) > 0 ||
+        gmk_ring_mpmc_count(&s->overflow) > 0 ||
+        gmk_det_ready(&s->det))
+        return true;
+
+    uint64_t tick = gmk_atomic_load(&w->tick, memory_order_relaxed);
+    for (uint32_t k = 0; k < s->n_workers; k++) {
+        uint64_t due = gmk_evq_next_due(&s->evqs[k]);
+        if (due < tick || (k == w->id && due == tick))
+            return true;
+    }
+    return false;
+}
+
+/* Spin for spin_ns before parking: work that shows up within a few
+ * microseconds skips both the futex sleep and the waker's syscall. */
+static bool worker_spin(gmk_worker_t *w) {
+    if (w->spin_ns == 0) return false;
+    uint64_t end = gmk_hal_now_ns() + w->spin_ns;
+    do {
+        for (uint32_t i = 0; i < 32; i++)
+            gmk_cpu_relax();
+        if (worker_has_work(w)) return true;
+    } while (gmk_hal_now_ns() < end &&
+             gmk_atomic_load(&w->running, memory_order_relaxed));
+    return false;
+}
+
+/* Park on the eventcount: publish parked, re-check every queue, then
+ * sleep unless a wake came in between. Wakers publish work, fence and
+ * read parked (gmk_worker_wake), so one side always sees the other.
+ * The timeout is only a safety net; worker 0 also wakes to rebalance. */
+static void worker_park(gmk_worker_t *w) {
+    uint32_t key = gmk_hal_park_prepare(&w->park);
+    gmk_atomic_store(&w->parked, true, memory_order_seq_cst);
+    gmk_atomic_fence(memory_order_seq_cst);
+
+    if (worker_has_work(w) || !gmk_atomic_load(&w->running, memory_order_acquire)) {
+        gmk_hal_park_cancel(&w->park);
+        gmk_atomic_store(&w->parked, false, memory_order_release);
+        return;
+    }
+
+    if (w->metrics)
+        gmk_metric_inc(w->metrics, 0, GMK_METRIC_WORKER_PARKS, 1);
+    if (w->trace)
+        gmk_trace_write(w->trace, 0, GMK_EV_WORKER_PARK, 0, w->id, 0);
+
+    uint64_t timeout = w->id == 0 && w->alloc ? GMK_ALLOC_REBALANCE_NS
+                                               : GMK_PARK_TIMEOUT_NS;
+    gmk_hal_park_commit(&w->park, key, timeout);
 
-            if (gmk_atomic_load(&w->running, memory_order_acquire))
-                gmk_hal_park_wait(&w->park, 1000000); /* 1ms timeout */
+    gmk_atomic_store(&w->parked, false, memory_order_release);
+    if (w->metrics)
+        gmk_metric_inc(w->metrics, 0, GMK_METRIC_WORKER_WAKES, 1);
+}
 
-            gmk_atomic_store(&w->parked, false, memory_order_release);
+void *gmk_worker_loop(void *arg) {
+    gmk_worker_t *w = (gmk_worker_t *)arg;
+
+    /* Bind this thread to our allocator magazines */
+    gmk_hal_self_set(w->id);
+
+    while (gmk_atomic_load(&w->running, memory_order_acquire)) {
+        /* 0. Deterministic lane first: it holds the tick barrier */
+        bool got_work = worker_det(w);
+
+        /* 1. Gather a batch: own LQ, then overflow bucket, then RQ */
+        uint32_t n = worker_gather(w);
+        if (n > 0) {
+            got_work = true;
             if (w->metrics)
-                gmk_metric_inc(w->metrics, 0, GMK_METRIC_WORKER_WAKES, 1);
+                gmk_metric_batch(w->metrics, n);
+            if (gmk_lq_count(&w->sched->lqs[w->id]) >= GMK_STEAL_WAKE_MIN ||
+                gmk_rq_count(&w->sched->rq) >= GMK_STEAL_WAKE_MIN)
+                worker_wake_thief(w);
+
+            /* 2. Sort by type and dispatch, inside the bump epoch */
+            gmk_epoch_enter(w->epoch, w->id, &w->tick);
+            worker_dispatch_batch(w, n);
+            gmk_epoch_exit(w->epoch, w->id);
+        }
+
+        /* 3. Steal from a sibling's LQ (tasks run next iteration) */
+        if (!got_work && worker_steal(w))
+            got_work = true;
+
+        /* 4. Check EVQ shards for due events */
+        if (!got_work && worker_expire(w) > 0)
+            got_work = true;
+
+        /* 5. No work: spin briefly, then park until woken */
+        if (!got_work) {
+            worker_rebalance(w);
+            if (!worker_spin(w))
+                worker_park(w);
         }
     }
 
+    /* Hand cached objects back so slab stats are exact after halt */
+    if (w->alloc)
+        gmk_alloc_cache_flush(w->alloc, w->id);
+    for (uint32_t t = 0; w->tenant_alloc && t < GMK_MAX_TENANTS; t++)
+        if (w->tenant_alloc[t]) gmk_alloc_cache_flush(w->tenant_alloc[t], w->id);
+
     return NULL;
 }
 
@@ -145,6 +394,11 @@ int gmk_worker_pool_init(gmk_worker_pool_t *pool, uint32_t n_workers,
         w->trace   = trace;
         w->metrics = metrics;
         w->kernel  = kernel;
+        w->siblings   = pool->workers;
+        w->n_siblings = n_workers;
+        w->steal_rng  = (i + 1) * 0x9E3779B9u;
+        w->batch_size = GMK_WORKER_BATCH_SIZE;
+        w->spin_ns    = GMK_PARK_SPIN_NS;
         atomic_init(&w->running, false);
         atomic_init(&w->parked, false);
         atomic_init(&w->tasks_dispatched, 0);
@@ -200,12 +454,62 @@ void gmk_worker_pool_destroy(gmk_worker_pool_t *pool) {
     }
 }
 
+void gmk_worker_pool_set_batch(gmk_worker_pool_t *pool, uint32_t batch_size) {
+    if (!pool || !pool->workers) return;
+    if (batch_size == 0) batch_size = 1;
+    if (batch_size > GMK_WORKER_BATCH_MAX) batch_size = GMK_WORKER_BATCH_MAX;
+    for (uint32_t i = 0; i < pool->n_workers; i++)
+        pool->workers[i].batch_size = batch_size;
+}
+
+void gmk_worker_pool_set_tenant_allocs(gmk_worker_pool_t *pool, gmk_alloc_t **allocs) {
+    if (!pool || !pool->workers) return;
+    for (uint32_t i = 0; i < pool->n_workers; i++)
+        pool->workers[i].tenant_alloc = allocs;
+}
+
+void gmk_worker_pool_set_epoch(gmk_worker_pool_t *pool, gmk_epoch_t *e) {
+    if (!pool || !pool->workers) return;
+    for (uint32_t i = 0; i < pool->n_workers; i++)
+        pool->workers[i].epoch = e;
+}
+
+void gmk_worker_pool_set_park(gmk_worker_pool_t *pool, uint64_t spin_ns) {
+    if (!pool || !pool->workers) return;
+    if (spin_ns == 0) spin_ns = GMK_PARK_SPIN_NS;
+    if (spin_ns == GMK_PARK_SPIN_OFF) spin_ns = 0;
+    for (uint32_t i = 0; i < pool->n_workers; i++)
+        pool->workers[i].spin_ns = spin_ns;
+}
+
+/* The fence pairs with the one in worker_park: the caller's queue push
+ * is visible to the worker's re-check, or its parked flag is visible here. */
 void gmk_worker_wake(gmk_worker_t *w) {
     if (!w) return;
-    if (gmk_atomic_load(&w->parked, memory_order_acquire))
+    gmk_atomic_fence(memory_order_seq_cst);
+    if (gmk_atomic_load(&w->parked, memory_order_relaxed))
         gmk_hal_park_wake(&w->park);
 }
 
+void gmk_worker_wake_one(gmk_worker_pool_t *pool) {
+    if (!pool) return;
+    gmk_atomic_fence(memory_order_seq_cst);
+    for (uint32_t i = 0; i < pool->n_workers; i++) {
+        if (gmk_atomic_load(&pool->workers[i].parked, memory_order_relaxed)) {
+            gmk_hal_park_wake(&pool->workers[i].park);
+            return;
+        }
+    }
+}
+
+void gmk_worker_notify(void *arg, int worker_id) {
+    gmk_worker_pool_t *pool = (gmk_worker_pool_t *)arg;
+    if (worker_id >= 0 && (uint32_t)worker_id < pool->n_workers)
+        gmk_worker_wake(&pool->workers[worker_id]);
+    else
+        gmk_worker_wake_one(pool);
+}
+
 void gmk_worker_wake_all(gmk_worker_pool_t *pool) {
     if (!pool) return;
     for (uint32_t i = 0; i < pool->n_workers; i++)
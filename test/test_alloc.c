@@ -0,0 +1,369 @@
+/*
+ * GGMK/cpu — Unified allocator tests (routing, page map, payloads)
+ */
+#include "ggmk/alloc.h"
+#include "ggmk/types.h"
+#include "ggmk/hal.h"
+#include "ggmk/metrics.h"
+#include "test_util.h"
+
+#define ARENA_SIZE (4u << 20)
+
+static void test_page_map_classes(void) {
+    gmk_alloc_t a;
+    GMK_ASSERT_EQ(gmk_alloc_init(&a, ARENA_SIZE), 0, "alloc init");
+    GMK_ASSERT_EQ((uintptr_t)a.arena.base % GMK_ALLOC_PAGE, 0, "arena page-aligned");
+
+    void *task = gmk_alloc(&a, sizeof(gmk_task_t));
+    GMK_ASSERT_EQ(gmk_alloc_class(&a, task), GMK_MAG_TASK, "task slab class");
+    GMK_ASSERT_EQ(gmk_alloc_usable_size(&a, task), sizeof(gmk_task_t), "task size");
+
+    static const uint32_t sizes[] = { 1, 32, 33, 100, 1000, 4096, 65536 };
+    void *ptrs[7];
+    for (uint32_t i = 0; i < 7; i++) {
+        ptrs[i] = gmk_alloc(&a, sizes[i]);
+        GMK_ASSERT_NOT_NULL(ptrs[i], "block alloc");
+        GMK_ASSERT_EQ(gmk_alloc_class(&a, ptrs[i]),
+                      GMK_MAG_BLOCK + gmk_block_bin(sizes[i]), "block bin class");
+        GMK_ASSERT(gmk_alloc_usable_size(&a, ptrs[i]) >= sizes[i], "usable >= requested");
+    }
+
+    /* Bump and foreign pointers have no class */
+    void *bump = gmk_bump(&a, 64);
+    GMK_ASSERT_NOT_NULL(bump, "bump alloc");
+    GMK_ASSERT_EQ(gmk_alloc_class(&a, bump), -1, "bump has no class");
+    int local;
+    GMK_ASSERT_EQ(gmk_alloc_class(&a, &local), -1, "foreign pointer");
+    GMK_ASSERT_EQ(gmk_alloc_usable_size(&a, &local), 0, "foreign size 0");
+
+    /* Size-free frees return every object to its own slab */
+    gmk_free(&a, task);
+    for (uint32_t i = 0; i < 7; i++)
+        gmk_free(&a, ptrs[i]);
+    gmk_free(&a, bump);      /* ignored */
+    gmk_free(&a, &local);    /* ignored */
+    GMK_ASSERT_EQ(gmk_slab_used(&a.task_slab), 0, "task slab empty");
+    for (uint32_t i = 0; i < GMK_BLOCK_BINS; i++)
+        GMK_ASSERT_EQ(gmk_slab_used(&a.block.bins[i]), 0, "bin empty");
+
+    gmk_alloc_destroy(&a);
+}
+
+static void test_unaligned_arena_size(void) {
+    /* A ragged tail goes to the bump region; bins stay page-exact */
+    gmk_alloc_t a;
+    GMK_ASSERT_EQ(gmk_alloc_init(&a, 1000 * 1000 + 123), 0, "odd-size init");
+    GMK_ASSERT_EQ((uintptr_t)a.bump.base % GMK_ALLOC_PAGE, 0, "bump page-aligned");
+    for (uint32_t i = 0; i < GMK_BLOCK_BINS; i++) {
+        if (a.block.bins[i].capacity == 0) continue;
+        GMK_ASSERT_EQ((uintptr_t)a.block.bins[i].base % GMK_ALLOC_PAGE, 0,
+                      "bin page-aligned");
+    }
+    GMK_ASSERT_EQ(gmk_alloc_class(&a, a.bump.base), -1, "first bump page unmapped");
+    gmk_alloc_destroy(&a);
+
+    GMK_ASSERT_EQ(gmk_alloc_init(&a, GMK_ALLOC_MIN_ARENA - 1), -1,
+                  "arena below minimum rejected");
+}
+
+static void test_payload_roundtrip(void) {
+    gmk_alloc_t a;
+    GMK_ASSERT_EQ(gmk_alloc_init(&a, ARENA_SIZE), 0, "alloc init");
+
+    uint8_t *p = (uint8_t *)gmk_payload_alloc(&a, 56);
+    GMK_ASSERT_NOT_NULL(p, "payload alloc");
+    GMK_ASSERT_EQ((uintptr_t)p % 8, 0, "payload 8-byte aligned");
+    memset(p, 0x5A, 56);
+
+    int bin = gmk_block_bin(56 + sizeof(gmk_payload_hdr_t));
+    GMK_ASSERT_EQ(gmk_slab_used(&a.block.bins[bin]), 1, "one object out");
+
+    gmk_payload_retain(p);
+    GMK_ASSERT_EQ(gmk_payload_release(&a, p), 0, "still referenced");
+    GMK_ASSERT_EQ(gmk_payload_release(&a, p), 1, "freed on last release");
+    GMK_ASSERT_EQ(gmk_slab_used(&a.block.bins[bin]), 0, "returned without a size");
+
+    gmk_alloc_destroy(&a);
+}
+
+static void test_grown_segments_resolve(void) {
+    /* Objects from grown segments still resolve their class by page */
+    gmk_alloc_t a;
+    GMK_ASSERT_EQ(gmk_alloc_init(&a, ARENA_SIZE), 0, "alloc init");
+
+    static void *objs[4096];
+    int bin = gmk_block_bin(2000);
+    uint32_t home = a.block.bins[bin].capacity, n = 0, bad = 0;
+    while (n < 4096 && (objs[n] = gmk_alloc(&a, 2000)) != NULL) {
+        int cls = gmk_alloc_class(&a, objs[n]);
+        if (cls < GMK_MAG_BLOCK + bin || cls > GMK_MAG_BLOCK + bin + GMK_BLOCK_SPILL)
+            bad++;
+        n++;
+    }
+    GMK_ASSERT_EQ(bad, 0, "every object resolves to its class or a spill class");
+    GMK_ASSERT(n > home * 4, "class grew past its home segment");
+
+    for (uint32_t i = 0; i < n; i++)
+        gmk_free(&a, objs[i]);
+    gmk_block_stats_t st;
+    gmk_block_stats(&a.block, bin, &st);
+    GMK_ASSERT_EQ(st.used, 0, "all freed without sizes");
+    GMK_ASSERT(gmk_alloc_rebalance(&a) + gmk_alloc_rebalance(&a) > 0,
+               "idle pages go back to the pool");
+
+    gmk_alloc_destroy(&a);
+}
+
+static void test_large_objects(void) {
+    gmk_alloc_t a;
+    GMK_ASSERT_EQ(gmk_alloc_init(&a, 64u << 20), 0, "alloc init");
+
+    uint8_t *big = (uint8_t *)gmk_alloc(&a, 8u << 20);
+    GMK_ASSERT_NOT_NULL(big, "8 MB from the arena");
+    GMK_ASSERT_EQ(gmk_alloc_class(&a, big), GMK_ALLOC_CLASS_LARGE, "large class");
+    GMK_ASSERT_EQ(gmk_alloc_usable_size(&a, big), 8u << 20, "usable size");
+    big[(8u << 20) - 1] = 1;
+
+    /* Refcounted large payloads */
+    uint8_t *p = (uint8_t *)gmk_payload_alloc(&a, 1u << 20);
+    GMK_ASSERT_NOT_NULL(p, "1 MB payload");
+    GMK_ASSERT_EQ(gmk_alloc_class(&a, p - sizeof(gmk_payload_hdr_t)),
+                  GMK_ALLOC_CLASS_LARGE, "payload in an extent");
+    gmk_payload_retain(p);
+    GMK_ASSERT_EQ(gmk_payload_release(&a, p), 0, "still referenced");
+    GMK_ASSERT_EQ(gmk_payload_release(&a, p), 1, "freed");
+
+    gmk_free(&a, big);
+    gmk_block_stats_t st;
+    gmk_block_large_stats(&a.block, &st);
+    GMK_ASSERT_EQ(st.used, 0, "extents returned");
+    GMK_ASSERT_EQ(st.allocs, 2, "both counted");
+    GMK_ASSERT_EQ(gmk_alloc(&a, UINT32_MAX), NULL, "beyond the pool");
+    GMK_ASSERT_EQ(gmk_atomic_load(&a.total_alloc_fails, memory_order_relaxed), 1,
+                  "failure counted");
+
+    gmk_alloc_destroy(&a);
+}
+
+static void test_elastic_chunks(void) {
+    gmk_alloc_t a;
+    GMK_ASSERT_EQ(gmk_alloc_init(&a, ARENA_SIZE), 0, "alloc init");
+    GMK_ASSERT_EQ(gmk_alloc_set_elastic(&a, 1u << 20, ARENA_SIZE), -1,
+                  "ceiling below arena + one chunk rejected");
+    GMK_ASSERT_EQ(gmk_alloc_set_elastic(&a, 4u << 20, 32u << 20), 0, "elastic");
+
+    /* A burst well past the 4 MB arena never fails */
+    static void *objs[16384];
+    uint32_t n = 0;
+    for (; n < 16384; n++) {
+        objs[n] = gmk_alloc(&a, 1000);
+        if (!objs[n]) break;
+        memset(objs[n], 0xA5, 1000);
+    }
+    GMK_ASSERT_EQ(n, 16384, "16 MB of 1000-byte objects");
+    GMK_ASSERT_EQ(gmk_atomic_load(&a.total_alloc_fails, memory_order_relaxed), 0,
+                  "no failures");
+    uint64_t grows = gmk_atomic_load(&a.chunk_grows, memory_order_relaxed);
+    GMK_ASSERT(grows >= 3, "chunks added");
+
+    /* Chunk pointers resolve and free without a size */
+    int bin = gmk_block_bin(1000);
+    uint32_t in_chunks = 0, bad = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (gmk_alloc_block_of(&a, objs[i]) != &a.block) in_chunks++;
+        int cls = gmk_alloc_class(&a, objs[i]);
+        if (cls < GMK_MAG_BLOCK + bin || cls > GMK_MAG_BLOCK + bin + GMK_BLOCK_SPILL)
+            bad++;
+    }
+    GMK_ASSERT_EQ(bad, 0, "chunk objects resolve to their class or a spill class");
+    GMK_ASSERT(in_chunks > n / 2, "most objects live in chunks");
+
+    /* A large extent bigger than a chunk gets a chunk of its own */
+    uint8_t *big = (uint8_t *)gmk_alloc(&a, 6u << 20);
+    GMK_ASSERT_NOT_NULL(big, "6 MB extent");
+    GMK_ASSERT_EQ(gmk_alloc_class(&a, big), GMK_ALLOC_CLASS_LARGE, "large in chunk");
+    GMK_ASSERT_EQ(gmk_alloc_usable_size(&a, big), 6u << 20, "large size");
+    big[(6u << 20) - 1] = 1;
+
+    /* Nothing beyond the ceiling */
+    GMK_ASSERT_EQ(gmk_alloc(&a, 16u << 20), NULL, "ceiling holds");
+
+    for (uint32_t i = 0; i < n; i++)
+        gmk_free(&a, objs[i]);
+    gmk_free(&a, big);
+
+    /* Empty chunks go back after enough idle passes */
+    for (uint32_t i = 0; i < GMK_ALLOC_CHUNK_IDLE_PASSES + 2; i++)
+        gmk_alloc_rebalance(&a);
+    GMK_ASSERT_EQ(gmk_atomic_load(&a.chunk_bytes, memory_order_relaxed), 0,
+                  "all chunks released");
+    GMK_ASSERT_EQ(gmk_atomic_load(&a.chunk_releases, memory_order_relaxed),
+                  gmk_atomic_load(&a.chunk_grows, memory_order_relaxed),
+                  "every chunk released");
+
+    /* Released descriptors are reused */
+    for (uint32_t i = 0; i < 8192; i++) {
+        objs[i] = gmk_alloc(&a, 1000);
+        GMK_ASSERT_NOT_NULL(objs[i], "regrow after release");
+    }
+    for (uint32_t i = 0; i < 8192; i++)
+        gmk_free(&a, objs[i]);
+
+    gmk_alloc_destroy(&a);
+}
+
+static void test_fixed_arena_stays_fixed(void) {
+    gmk_alloc_t a;
+    GMK_ASSERT_EQ(gmk_alloc_init(&a, ARENA_SIZE), 0, "alloc init");
+    GMK_ASSERT_EQ(gmk_alloc(&a, 8u << 20), NULL, "no growth by default");
+    GMK_ASSERT_EQ(gmk_atomic_load(&a.chunk_grows, memory_order_relaxed), 0,
+                  "no chunks");
+    gmk_alloc_destroy(&a);
+}
+
+static void test_peer_free(void) {
+    /* Objects freed through a linked peer go back to their owner */
+    gmk_alloc_t a, b;
+    GMK_ASSERT_EQ(gmk_alloc_init(&a, ARENA_SIZE), 0, "init a");
+    GMK_ASSERT_EQ(gmk_alloc_init(&b, ARENA_SIZE), 0, "init b");
+
+    void *p = gmk_payload_alloc(&b, 100);
+    void *big = gmk_alloc(&b, 1u << 20);
+    GMK_ASSERT_NOT_NULL(p, "payload from b");
+    GMK_ASSERT_NOT_NULL(big, "extent from b");
+    GMK_ASSERT_EQ(gmk_payload_release(&a, p), 1, "released");
+    int bin = gmk_block_bin(100 + sizeof(gmk_payload_hdr_t));
+    GMK_ASSERT_EQ(gmk_slab_used(&b.block.bins[bin]), 1, "unlinked: ignored");
+
+    gmk_alloc_link(&a, &b);
+    p = gmk_payload_alloc(&b, 100);
+    GMK_ASSERT_EQ(gmk_payload_release(&a, p), 1, "released via peer");
+    gmk_free(&a, big);
+    GMK_ASSERT_EQ(gmk_slab_used(&b.block.bins[bin]), 1, "returned to b");
+    gmk_block_stats_t st;
+    gmk_block_large_stats(&b.block, &st);
+    GMK_ASSERT_EQ(st.used, 0, "extent returned to b");
+
+    /* Own bump pointers are not forwarded */
+    void *bump = gmk_bump(&a, 64);
+    gmk_free(&a, bump);
+
+    gmk_alloc_destroy(&a);
+    gmk_alloc_destroy(&b);
+}
+
+static void test_alloc_stats(void) {
+    gmk_alloc_t a;
+    GMK_ASSERT_EQ(gmk_alloc_init(&a, ARENA_SIZE), 0, "init");
+
+    void *objs[10];
+    for (int i = 0; i < 10; i++)
+        objs[i] = gmk_alloc(&a, 100);
+    void *task = gmk_alloc(&a, sizeof(gmk_task_t));
+    void *big  = gmk_alloc(&a, 100000);
+    GMK_ASSERT_NULL(gmk_alloc(&a, 64u << 20), "oversized extent fails");
+
+    gmk_alloc_stats_t st;
+    GMK_ASSERT_EQ(gmk_alloc_stats(&a, &st), 0, "snapshot");
+    int cls = GMK_MAG_BLOCK + gmk_block_bin(100);
+    uint32_t obj = gmk_block_bin_size(cls - GMK_MAG_BLOCK);
+    GMK_ASSERT_EQ(st.cls[cls].used, 10, "bin in use");
+    GMK_ASSERT_EQ(st.cls[cls].allocs, 10, "bin allocs");
+    GMK_ASSERT(st.cls[cls].capacity >= 10, "bin capacity");
+    GMK_ASSERT_EQ(st.cls[cls].frag_permille, (obj - 100) * 1000 / obj,
+                  "bin internal fragmentation");
+    GMK_ASSERT_EQ(st.cls[GMK_MAG_TASK].used, 1, "task slab in use");
+    GMK_ASSERT_EQ(st.cls[GMK_ALLOC_CLASS_LARGE].used, 1, "one extent");
+    GMK_ASSERT_EQ(st.cls[GMK_ALLOC_CLASS_LARGE].fails, 1, "extent failure");
+    GMK_ASSERT_EQ(st.cls[cls].fails, 0, "bin never failed");
+    GMK_ASSERT_EQ(st.alloc_fails, 1, "total failures");
+    GMK_ASSERT_EQ(st.reserved_bytes, ARENA_SIZE, "fixed arena");
+    uint64_t used = 10ull * obj + sizeof(gmk_task_t) + 25 * GMK_ALLOC_PAGE;
+    GMK_ASSERT_EQ(st.used_bytes, used, "bytes in use");
+
+    /* Gauges follow the snapshot up and down; the shared tenant only
+     * moves the global slot */
+    gmk_metrics_t m;
+    GMK_ASSERT_EQ(gmk_metrics_init(&m, 2), 0, "metrics");
+    gmk_alloc_set_metrics(&a, &m, 1);
+    gmk_alloc_publish(&a);
+    GMK_ASSERT_EQ(gmk_metric_get_tenant(&m, 1, GMK_METRIC_ALLOC_IN_USE), used,
+                  "tenant gauge");
+    GMK_ASSERT_EQ(gmk_metric_get(&m, GMK_METRIC_ALLOC_RESERVED), ARENA_SIZE,
+                  "global reserved");
+    for (int i = 0; i < 10; i++)
+        gmk_free(&a, objs[i]);
+    gmk_free(&a, big);
+    gmk_alloc_publish(&a);
+    GMK_ASSERT_EQ(gmk_metric_get(&m, GMK_METRIC_ALLOC_IN_USE), sizeof(gmk_task_t),
+                  "gauge comes down");
+
+    gmk_alloc_t shared;
+    GMK_ASSERT_EQ(gmk_alloc_init(&shared, ARENA_SIZE), 0, "init shared");
+    gmk_alloc_set_metrics(&shared, &m, GMK_ALLOC_SHARED);
+    gmk_alloc_publish(&shared);
+    GMK_ASSERT_EQ(gmk_metric_get(&m, GMK_METRIC_ALLOC_RESERVED), 2ull * ARENA_SIZE,
+                  "global sums allocators");
+    GMK_ASSERT_EQ(gmk_metric_get_tenant(&m, 1, GMK_METRIC_ALLOC_RESERVED), ARENA_SIZE,
+                  "tenant slot unchanged");
+
+    gmk_free(&a, task);
+    gmk_alloc_destroy(&shared);
+    gmk_alloc_destroy(&a);
+}
+
+static void test_hal_page_policy(void) {
+    /* Large regions are 2 MB aligned and arrive zeroed in every mode */
+    static const uint32_t modes[] = {
+        GMK_HAL_HUGE_THP, GMK_HAL_HUGE_OFF, GMK_HAL_HUGE_TLB
+    };
+    for (uint32_t m = 0; m < 3; m++) {
+        gmk_hal_mem_policy(modes[m], false);
+        uint8_t *p = (uint8_t *)gmk_hal_page_alloc(3u << 20, GMK_ALLOC_PAGE);
+        GMK_ASSERT_NOT_NULL(p, "3 MB region");
+        GMK_ASSERT_EQ((uintptr_t)p % (2u << 20), 0, "2 MB aligned");
+        GMK_ASSERT(p[0] == 0 && p[(3u << 20) - 1] == 0, "zeroed");
+        p[(3u << 20) - 1] = 1;
+        gmk_hal_page_free(p, 3u << 20);
+    }
+    gmk_hal_mem_policy(GMK_HAL_HUGE_THP, false);
+
+    uint8_t *small = (uint8_t *)gmk_hal_page_alloc(100, 64);
+    GMK_ASSERT_NOT_NULL(small, "small region");
+    GMK_ASSERT_EQ((uintptr_t)small % GMK_ALLOC_PAGE, 0, "page aligned");
+    gmk_hal_page_free(small, 100);
+
+    /* Placement is a no-op unless asked for, and hints nest */
+    GMK_ASSERT(gmk_hal_node_count() >= 1, "at least one node");
+    GMK_ASSERT_EQ(gmk_hal_worker_node(0), GMK_HAL_NODE_ANY, "NUMA off");
+    int prev = gmk_hal_mem_node(0);
+    GMK_ASSERT_EQ(prev, GMK_HAL_NODE_ANY, "no hint by default");
+    GMK_ASSERT_EQ(gmk_hal_mem_node(prev), 0, "hint restored");
+
+    gmk_hal_mem_policy(GMK_HAL_HUGE_THP, true);
+    int node = gmk_hal_worker_node(3);
+    GMK_ASSERT(node == GMK_HAL_NODE_ANY || node < (int)gmk_hal_node_count(),
+               "worker node in range");
+    gmk_alloc_t a;
+    GMK_ASSERT_EQ(gmk_alloc_init(&a, ARENA_SIZE), 0, "alloc init with NUMA on");
+    GMK_ASSERT_EQ(gmk_alloc_cache_init(&a, 4), 0, "per-node magazines");
+    GMK_ASSERT_EQ(a.caches[3]->mags[GMK_MAG_TASK].count, 0, "zeroed magazine");
+    gmk_alloc_destroy(&a);
+    gmk_hal_mem_policy(GMK_HAL_HUGE_THP, false);
+}
+
+int main(void) {
+    GMK_TEST_BEGIN("alloc");
+    GMK_RUN_TEST(test_page_map_classes);
+    GMK_RUN_TEST(test_unaligned_arena_size);
+    GMK_RUN_TEST(test_payload_roundtrip);
+    GMK_RUN_TEST(test_grown_segments_resolve);
+    GMK_RUN_TEST(test_large_objects);
+    GMK_RUN_TEST(test_elastic_chunks);
+    GMK_RUN_TEST(test_fixed_arena_stays_fixed);
+    GMK_RUN_TEST(test_peer_free);
+    GMK_RUN_TEST(test_alloc_stats);
+    GMK_RUN_TEST(test_hal_page_policy);
+    GMK_TEST_END();
+    return 0;
+}
@@ -3,6 +3,7 @@
  */
 #include "ggmk/alloc.h"
 #include "test_util.h"
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -21,8 +22,8 @@ static void test_various_sizes(void) {
     void *p64 = gmk_block_alloc(&b, 64);
     GMK_ASSERT_NOT_NULL(p64, "alloc 64");
 
-    void *p100 = gmk_block_alloc(&b, 100); /* rounds up to 128 */
-    GMK_ASSERT_NOT_NULL(p100, "alloc 100 (-> 128)");
+    void *p100 = gmk_block_alloc(&b, 100); /* rounds up to 112 */
+    GMK_ASSERT_NOT_NULL(p100, "alloc 100 (-> 112)");
 
     void *p1k = gmk_block_alloc(&b, 1024);
     GMK_ASSERT_NOT_NULL(p1k, "alloc 1024");
@@ -89,11 +90,283 @@ static void test_small_alloc(void) {
     free(mem);
 }
 
+static void test_size_classes(void) {
+    /* Every size maps to the smallest class that holds it */
+    GMK_ASSERT_EQ(gmk_block_bin_size(0), 32, "first class");
+    GMK_ASSERT_EQ(gmk_block_bin_size(GMK_BLOCK_BINS - 1), GMK_BLOCK_MAX_SIZE, "last class");
+    GMK_ASSERT_EQ(gmk_block_bin_size(GMK_BLOCK_BINS), 0, "out of range");
+
+    int bad = 0;
+    for (uint32_t size = 1; size <= GMK_BLOCK_MAX_SIZE; size++) {
+        int bin = gmk_block_bin(size);
+        if (bin < 0 || gmk_block_bin_size(bin) < size) bad++;
+        else if (bin > 0 && gmk_block_bin_size(bin - 1) >= size) bad++;
+    }
+    GMK_ASSERT_EQ(bad, 0, "bin is the tightest fit for every size");
+    GMK_ASSERT_EQ(gmk_block_bin(GMK_BLOCK_MAX_SIZE + 1), -1, "too large");
+
+    /* Four classes per power of two */
+    GMK_ASSERT_EQ(gmk_block_bin_size(gmk_block_bin(65)), 80, "65 -> 80");
+    GMK_ASSERT_EQ(gmk_block_bin_size(gmk_block_bin(72)), 80, "64B payload + hdr -> 80");
+    GMK_ASSERT_EQ(gmk_block_bin_size(gmk_block_bin(4104)), 5120, "4K payload + hdr -> 5K");
+}
+
+static void test_fragmentation_stats(void) {
+    size_t mem_size = 4 * 1024 * 1024;
+    void *mem = aligned_alloc(4096, mem_size);
+    gmk_block_t b;
+    GMK_ASSERT_EQ(gmk_block_init(&b, mem, mem_size), 0, "init");
+
+    int bin = gmk_block_bin(100);
+    gmk_block_stats_t st;
+    GMK_ASSERT_EQ(gmk_block_stats(&b, bin, &st), 0, "stats");
+    GMK_ASSERT_EQ(st.obj_size, 112, "class size");
+    GMK_ASSERT(st.capacity > 0, "class has memory");
+    GMK_ASSERT_EQ(st.frag_permille, 0, "no allocs, no fragmentation");
+
+    void *p1 = gmk_block_alloc(&b, 100);
+    void *p2 = gmk_block_alloc(&b, 112);
+    GMK_ASSERT_EQ(gmk_block_stats(&b, bin, &st), 0, "stats");
+    GMK_ASSERT_EQ(st.used, 2, "two live");
+    GMK_ASSERT_EQ(st.allocs, 2, "two allocs");
+    GMK_ASSERT_EQ(st.req_bytes, 212, "requested bytes");
+    GMK_ASSERT_EQ(st.frag_permille, (12u * 1000) / 224, "12 of 224 bytes wasted");
+
+    gmk_block_free(&b, p1, 100);
+    gmk_block_free(&b, p2, 112);
+    GMK_ASSERT_EQ(gmk_block_stats(&b, bin, &st), 0, "stats");
+    GMK_ASSERT_EQ(st.used, 0, "none live");
+    GMK_ASSERT_EQ(st.high_water, 2, "peak kept");
+    GMK_ASSERT_EQ(gmk_block_stats(&b, GMK_BLOCK_BINS, &st), -1, "bad bin");
+
+    /* Every class gets memory in a modest region */
+    for (int i = 0; i < GMK_BLOCK_BINS; i++)
+        GMK_ASSERT(b.bins[i].capacity > 0, "class populated");
+
+    gmk_block_destroy(&b);
+    free(mem);
+}
+
+static uint32_t total_used(const gmk_block_t *b) {
+    uint32_t used = 0;
+    gmk_block_stats_t st;
+    for (int i = 0; i < GMK_BLOCK_BINS; i++) {
+        gmk_block_stats(b, i, &st);
+        used += st.used;
+    }
+    return used;
+}
+
+#define GROW_MAX 8192
+
+static void test_grow_and_reclaim(void) {
+    /* One dominant size takes the pool instead of failing at its home */
+    size_t mem_size = 4 * 1024 * 1024;
+    void *mem = aligned_alloc(4096, mem_size);
+    gmk_block_t b;
+    GMK_ASSERT_EQ(gmk_block_init(&b, mem, mem_size), 0, "init");
+
+    int bin = gmk_block_bin(1000);
+    gmk_block_stats_t st;
+    gmk_block_stats(&b, bin, &st);
+    uint32_t home_cap = st.capacity;
+    uint32_t pool0 = gmk_atomic_load(&b.pool_pages, memory_order_relaxed);
+    GMK_ASSERT(pool0 * GMK_ALLOC_PAGE >= mem_size * 4 / 10, "reserve held in pool");
+
+    static void *objs[GROW_MAX];
+    uint32_t n = 0, own = 0;
+    while (n < GROW_MAX && (objs[n] = gmk_block_alloc(&b, 1000)) != NULL) {
+        if (gmk_block_ptr_bin(&b, objs[n]) == bin) own++;
+        n++;
+    }
+    GMK_ASSERT(n < GROW_MAX, "eventually exhausted");
+    GMK_ASSERT(own > home_cap * 4, "class grew well past its home");
+    gmk_block_stats(&b, bin, &st);
+    GMK_ASSERT(st.segs > 1 && st.grows == st.segs - 1, "grown segments");
+    GMK_ASSERT(st.pages * GMK_ALLOC_PAGE > mem_size / 3, "most pages moved to the class");
+
+    /* Frees route by page table, whatever size the caller passes */
+    for (uint32_t i = 0; i < n; i++)
+        gmk_block_free(&b, objs[i], 1);
+    GMK_ASSERT_EQ(total_used(&b), 0, "everything back");
+
+    /* First pass still sees the burst; the next one finds the class idle */
+    gmk_block_rebalance(&b);
+    GMK_ASSERT(gmk_block_rebalance(&b) > 0, "idle pages reclaimed");
+    gmk_block_stats(&b, bin, &st);
+    GMK_ASSERT_EQ(st.segs, 0, "idle class released every segment");
+    GMK_ASSERT(gmk_atomic_load(&b.pool_pages, memory_order_relaxed) > pool0,
+               "pool larger than at init");
+
+    /* An emptied class grows back on demand */
+    void *p = gmk_block_alloc(&b, 1000);
+    GMK_ASSERT_NOT_NULL(p, "alloc after reclaim");
+    GMK_ASSERT_EQ(gmk_block_ptr_bin(&b, p), bin, "served by its own class");
+    gmk_block_free(&b, p, 1000);
+
+    gmk_block_destroy(&b);
+    free(mem);
+}
+
+static void test_spill_over(void) {
+    /* Tiny region: no pool left, so a dry class borrows larger objects */
+    size_t mem_size = 64 * 1024;
+    void *mem = aligned_alloc(4096, mem_size);
+    gmk_block_t b;
+    GMK_ASSERT_EQ(gmk_block_init(&b, mem, mem_size), 0, "init");
+
+    int bin = gmk_block_bin(40);
+    static void *objs[GROW_MAX];
+    uint32_t n = 0, spilled = 0;
+    while (n < GROW_MAX && (objs[n] = gmk_block_alloc(&b, 40)) != NULL) {
+        int got = gmk_block_ptr_bin(&b, objs[n]);
+        GMK_ASSERT(got >= bin && got <= bin + GMK_BLOCK_SPILL, "own or spill class");
+        if (got != bin) spilled++;
+        n++;
+    }
+    GMK_ASSERT(spilled > 0, "spilled into larger classes");
+
+    gmk_block_stats_t st;
+    gmk_block_stats(&b, bin, &st);
+    GMK_ASSERT_EQ(st.spills, spilled, "spills counted on the requesting class");
+
+    for (uint32_t i = 0; i < n; i++)
+        gmk_block_free(&b, objs[i], 40);
+    GMK_ASSERT_EQ(total_used(&b), 0, "spilled objects freed to their owners");
+
+    gmk_block_destroy(&b);
+    free(mem);
+}
+
+static void test_large_extents(void) {
+    size_t mem_size = 16 * 1024 * 1024;
+    void *mem = aligned_alloc(4096, mem_size);
+    gmk_block_t b;
+    GMK_ASSERT_EQ(gmk_block_init(&b, mem, mem_size), 0, "init");
+    uint32_t pool0 = gmk_atomic_load(&b.pool_pages, memory_order_relaxed);
+
+    uint8_t *x = (uint8_t *)gmk_block_large_alloc(&b, 65537);
+    uint8_t *y = (uint8_t *)gmk_block_large_alloc(&b, 1u << 20);
+    uint8_t *z = (uint8_t *)gmk_block_large_alloc(&b, 1u << 20);
+    GMK_ASSERT(x && y && z, "large allocs");
+    GMK_ASSERT_EQ((size_t)(x - b.base) % GMK_ALLOC_PAGE, 0, "page-aligned");
+    GMK_ASSERT_EQ(gmk_block_large_size(&b, x), 17 * GMK_ALLOC_PAGE, "rounded to pages");
+    GMK_ASSERT_EQ(gmk_block_large_size(&b, x + 8), 0, "interior pointer is not an extent");
+    GMK_ASSERT_EQ(gmk_block_ptr_bin(&b, y), -1, "extent has no bin");
+    memset(y, 0xCD, 1u << 20);
+    GMK_ASSERT_EQ(z[0], 0, "neighbours untouched");
+
+    gmk_block_stats_t st;
+    gmk_block_large_stats(&b, &st);
+    GMK_ASSERT_EQ(st.used, 3, "three live");
+    GMK_ASSERT_EQ(st.pages, 17 + 256 + 256, "live pages");
+    GMK_ASSERT_EQ(st.allocs, 3, "allocs");
+    GMK_ASSERT(st.frag_permille > 0 && st.frag_permille < 10, "page rounding waste");
+
+    /* Adjacent free extents merge for free in the page table */
+    gmk_block_large_free(&b, x);
+    gmk_block_free(&b, y, 0);
+    uint8_t *w = (uint8_t *)gmk_block_large_alloc(&b, (1u << 20) + 17 * GMK_ALLOC_PAGE);
+    GMK_ASSERT(w == x, "freed neighbours reused as one run");
+    gmk_block_large_free(&b, w);
+    gmk_block_large_free(&b, w);   /* double free ignored */
+    gmk_block_large_free(&b, z);
+
+    GMK_ASSERT_NULL(gmk_block_large_alloc(&b, mem_size), "larger than the pool");
+    gmk_block_large_stats(&b, &st);
+    GMK_ASSERT_EQ(st.used, 0, "none live");
+    GMK_ASSERT_EQ(st.high_water, 17 + 256 + 256, "peak pages");
+    GMK_ASSERT_EQ(st.fails, 1, "failure counted");
+    GMK_ASSERT_EQ(st.segs + st.spills, 0, "no segments or spills");
+    GMK_ASSERT_EQ(gmk_atomic_load(&b.pool_pages, memory_order_relaxed), pool0,
+                  "pool fully restored");
+
+    gmk_block_destroy(&b);
+    free(mem);
+}
+
+/* ── Rebalancing under concurrent alloc/free ───────────────────── */
+#define RB_THREADS 4
+#define RB_ROUNDS  20000
+#define RB_LIVE    64
+
+static gmk_block_t rb_block;
+static _Atomic(bool) rb_stop;
+static _Atomic(uint32_t) rb_bad;
+
+static void *rb_worker(void *arg) {
+    uint32_t id = (uint32_t)(uintptr_t)arg;
+    uint32_t x = 0x12345u + id;
+    uint32_t *live[RB_LIVE] = {0};
+    uint32_t size[RB_LIVE];
+
+    for (uint32_t i = 0; i < RB_ROUNDS; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        uint32_t slot = x % RB_LIVE;
+        if (live[slot]) {
+            if (live[slot][0] != id || live[slot][size[slot] / 4 - 1] != id)
+                gmk_atomic_add(&rb_bad, 1, memory_order_relaxed);
+            gmk_block_free(&rb_block, live[slot], size[slot]);
+        }
+        /* Phases shift demand between small and large classes */
+        size[slot] = (i / 2000) % 2 ? 64 + (x >> 20) % 1024 : 2048 + (x >> 16) % 8192;
+        size[slot] &= ~3u;  /* whole words for the guard */
+        live[slot] = (uint32_t *)gmk_block_alloc(&rb_block, size[slot]);
+        if (live[slot]) {
+            live[slot][0] = id;
+            live[slot][size[slot] / 4 - 1] = id;
+        }
+    }
+    for (uint32_t i = 0; i < RB_LIVE; i++) {
+        if (live[i] && live[i][size[i] / 4 - 1] != id)
+            gmk_atomic_add(&rb_bad, 1, memory_order_relaxed);
+        gmk_block_free(&rb_block, live[i], size[i]);
+    }
+    return NULL;
+}
+
+static void *rb_balancer(void *arg) {
+    (void)arg;
+    while (!gmk_atomic_load(&rb_stop, memory_order_acquire))
+        gmk_block_rebalance(&rb_block);
+    return NULL;
+}
+
+static void test_rebalance_concurrent(void) {
+    size_t mem_size = 8 * 1024 * 1024;
+    void *mem = aligned_alloc(4096, mem_size);
+    GMK_ASSERT_EQ(gmk_block_init(&rb_block, mem, mem_size), 0, "init");
+    atomic_init(&rb_stop, false);
+    atomic_init(&rb_bad, 0);
+
+    pthread_t bal, th[RB_THREADS];
+    pthread_create(&bal, NULL, rb_balancer, NULL);
+    for (uint32_t i = 0; i < RB_THREADS; i++)
+        pthread_create(&th[i], NULL, rb_worker, (void *)(uintptr_t)(i + 1));
+    for (uint32_t i = 0; i < RB_THREADS; i++)
+        pthread_join(th[i], NULL);
+    gmk_atomic_store(&rb_stop, true, memory_order_release);
+    pthread_join(bal, NULL);
+
+    GMK_ASSERT_EQ(gmk_atomic_load(&rb_bad, memory_order_relaxed), 0,
+                  "no object shared or overwritten");
+    GMK_ASSERT_EQ(total_used(&rb_block), 0, "all objects returned");
+
+    gmk_block_destroy(&rb_block);
+    free(mem);
+}
+
 int main(void) {
     GMK_TEST_BEGIN("alloc_block");
     GMK_RUN_TEST(test_various_sizes);
     GMK_RUN_TEST(test_reuse_after_free);
     GMK_RUN_TEST(test_small_alloc);
+    GMK_RUN_TEST(test_size_classes);
+    GMK_RUN_TEST(test_fragmentation_stats);
+    GMK_RUN_TEST(test_grow_and_reclaim);
+    GMK_RUN_TEST(test_spill_over);
+    GMK_RUN_TEST(test_large_extents);
+    GMK_RUN_TEST(test_rebalance_concurrent);
     GMK_TEST_END();
     return 0;
 }
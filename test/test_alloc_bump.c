@@ -2,6 +2,7 @@
  * GGMK/cpu — Bump allocator tests
  */
 #include "ggmk/alloc.h"
+#include "ggmk/hal.h"
 #include "test_util.h"
 #include <stdlib.h>
 #include <string.h>
@@ -105,12 +106,80 @@ static void test_concurrent(void) {
     free(mem);
 }
 
+/* ── Worker slices and tick epochs ───────────────────────────── */
+static gmk_alloc_t ep_alloc;
+static gmk_epoch_t ep;
+static _Atomic(uint64_t) ep_tick;
+
+static void *epoch_fn(void *arg) {
+    (void)arg;
+    gmk_alloc_t *a = &ep_alloc;
+    gmk_bump_local_t *slice = &a->caches[0]->bump;
+    gmk_hal_self_set(0);
+
+    /* Outside a batch: the shared region */
+    uint8_t *p = (uint8_t *)gmk_bump(a, 64);
+    GMK_ASSERT(p >= a->bump.base && p < a->bump.base + a->bump.size, "shared");
+
+    /* Tick 1 on worker 0 while worker 1 runs a tick-1 batch */
+    atomic_store(&ep_tick, 1);
+    GMK_ASSERT_EQ(gmk_epoch_enter(&ep, 0, &ep_tick), 1, "entered tick 1");
+    GMK_ASSERT_EQ(gmk_epoch_enter(&ep, 1, &ep_tick), 1, "worker 1 in tick 1");
+    uint8_t *p1 = (uint8_t *)gmk_bump(a, 100);
+    GMK_ASSERT(p1 == slice->base, "worker slice");
+    gmk_epoch_exit(&ep, 0);
+
+    /* Tick 2: worker 1 still holds tick 1, so the slice keeps growing */
+    atomic_store(&ep_tick, 2);
+    GMK_ASSERT_EQ(gmk_epoch_advance(&ep, 2), 1, "safe held at tick 1");
+    gmk_epoch_enter(&ep, 0, &ep_tick);
+    uint8_t *p2 = (uint8_t *)gmk_bump(a, 100);
+    GMK_ASSERT(p2 == p1 + 104, "no rewind while tick 1 runs");
+    gmk_epoch_exit(&ep, 0);
+
+    /* Tick 3 with worker 1 done: everything from tick 2 back is free */
+    gmk_epoch_exit(&ep, 1);
+    atomic_store(&ep_tick, 3);
+    GMK_ASSERT_EQ(gmk_epoch_advance(&ep, 3), 3, "safe caught up");
+    gmk_epoch_enter(&ep, 0, &ep_tick);
+    GMK_ASSERT(gmk_bump(a, 100) == slice->base, "rewound");
+    GMK_ASSERT_EQ(slice->resets, 1, "one rewind");
+
+    /* Same tick: no rewind even when full */
+    GMK_ASSERT_EQ(gmk_bump(a, slice->size), NULL, "slice exhausted");
+    GMK_ASSERT_EQ(slice->fails, 1, "failure counted");
+    gmk_epoch_exit(&ep, 0);
+    return NULL;
+}
+
+static void test_worker_epochs(void) {
+    GMK_ASSERT_EQ(gmk_alloc_init(&ep_alloc, 4u << 20), 0, "alloc init");
+    size_t bump_size = ep_alloc.bump.size;
+    GMK_ASSERT_EQ(gmk_alloc_cache_init(&ep_alloc, 2), 0, "cache init");
+    GMK_ASSERT_EQ(gmk_epoch_init(&ep, 2), 0, "epoch init");
+    gmk_alloc_set_epoch(&ep_alloc, &ep);
+
+    size_t share = ep_alloc.caches[0]->bump.size;
+    GMK_ASSERT(share > 0, "worker slice");
+    GMK_ASSERT_EQ(ep_alloc.bump.size + 2 * share, bump_size, "region split");
+    GMK_ASSERT(ep_alloc.caches[1]->bump.base == ep_alloc.caches[0]->bump.base + share,
+               "slices adjacent");
+
+    pthread_t t;
+    pthread_create(&t, NULL, epoch_fn, NULL);
+    pthread_join(t, NULL);
+
+    gmk_epoch_destroy(&ep);
+    gmk_alloc_destroy(&ep_alloc);
+}
+
 int main(void) {
     GMK_TEST_BEGIN("alloc_bump");
     GMK_RUN_TEST(test_basic);
     GMK_RUN_TEST(test_reset);
     GMK_RUN_TEST(test_exhaustion);
     GMK_RUN_TEST(test_concurrent);
+    GMK_RUN_TEST(test_worker_epochs);
     GMK_TEST_END();
     return 0;
 }
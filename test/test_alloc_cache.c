@@ -0,0 +1,156 @@
+/*
+ * GGMK/cpu — Per-worker magazine tests
+ */
+#include "ggmk/alloc.h"
+#include "ggmk/hal.h"
+#include "ggmk/types.h"
+#include "test_util.h"
+#include <pthread.h>
+#include <sched.h>
+
+#define ARENA_SIZE (4u << 20)
+
+static void test_unbound_thread_bypasses_cache(void) {
+    gmk_alloc_t a;
+    GMK_ASSERT_EQ(gmk_alloc_init(&a, ARENA_SIZE), 0, "alloc init");
+    GMK_ASSERT_EQ(gmk_alloc_cache_init(&a, 2), 0, "cache init");
+
+    /* Main thread never bound a worker id */
+    GMK_ASSERT_EQ(gmk_hal_self(), UINT32_MAX, "unbound");
+    void *p = gmk_alloc(&a, sizeof(gmk_task_t));
+    GMK_ASSERT_NOT_NULL(p, "alloc");
+    GMK_ASSERT_EQ(gmk_slab_used(&a.task_slab), 1, "exactly one from slab");
+    gmk_free(&a, p);
+    GMK_ASSERT_EQ(gmk_slab_used(&a.task_slab), 0, "freed straight to slab");
+
+    gmk_alloc_destroy(&a);
+}
+
+/* ── Refill / flush batching on a bound thread ─────────────────── */
+static gmk_alloc_t batch_alloc;
+
+static void *batch_fn(void *arg) {
+    (void)arg;
+    gmk_alloc_t *a = &batch_alloc;
+    gmk_hal_self_set(1);
+
+    int bin = gmk_block_bin(100);
+    gmk_slab_t *s = &a->block.bins[bin];
+
+    /* First alloc refills half a magazine under one lock */
+    void *objs[GMK_ALLOC_MAG_SIZE * 2];
+    objs[0] = gmk_alloc(a, 100);
+    GMK_ASSERT_NOT_NULL(objs[0], "first alloc");
+    GMK_ASSERT_EQ(gmk_slab_used(s), GMK_ALLOC_MAG_BATCH, "refilled one batch");
+    GMK_ASSERT_EQ(a->caches[1]->mags[GMK_MAG_BLOCK + bin].count,
+                  GMK_ALLOC_MAG_BATCH - 1, "rest parked in magazine");
+
+    for (uint32_t i = 1; i < GMK_ALLOC_MAG_BATCH; i++)
+        objs[i] = gmk_alloc(a, 100);
+    GMK_ASSERT_EQ(gmk_slab_used(s), GMK_ALLOC_MAG_BATCH, "served from magazine");
+
+    /* Free more than a magazine holds: overflow flushes half at a time */
+    for (uint32_t i = GMK_ALLOC_MAG_BATCH; i < GMK_ALLOC_MAG_SIZE * 2; i++)
+        objs[i] = gmk_alloc(a, 100);
+    for (uint32_t i = 0; i < GMK_ALLOC_MAG_SIZE * 2; i++)
+        gmk_free(a, objs[i]);
+    uint32_t cached = a->caches[1]->mags[GMK_MAG_BLOCK + bin].count;
+    GMK_ASSERT(cached <= GMK_ALLOC_MAG_SIZE, "magazine stays bounded");
+    GMK_ASSERT_EQ(gmk_slab_used(s), cached, "only cached objects stay out");
+
+    gmk_alloc_cache_flush(a, 1);
+    GMK_ASSERT_EQ(gmk_slab_used(s), 0, "flush returns everything");
+    GMK_ASSERT_EQ(a->caches[1]->mags[GMK_MAG_BLOCK + bin].count, 0, "magazine empty");
+    return NULL;
+}
+
+static void test_refill_and_flush(void) {
+    GMK_ASSERT_EQ(gmk_alloc_init(&batch_alloc, ARENA_SIZE), 0, "alloc init");
+    GMK_ASSERT_EQ(gmk_alloc_cache_init(&batch_alloc, 2), 0, "cache init");
+
+    pthread_t t;
+    pthread_create(&t, NULL, batch_fn, NULL);
+    pthread_join(t, NULL);
+
+    gmk_alloc_destroy(&batch_alloc);
+}
+
+/* ── Remote frees: payloads allocated on one worker, freed on the next ── */
+#define RF_WORKERS 4
+#define RF_ROUNDS  5000
+
+static gmk_alloc_t rf_alloc;
+static _Atomic(uintptr_t) rf_handoff[RF_WORKERS];
+static _Atomic(uint32_t)  rf_bad;
+
+static void *remote_free_fn(void *arg) {
+    uint32_t id = (uint32_t)(uintptr_t)arg;
+    uint32_t next = (id + 1) % RF_WORKERS;
+    gmk_hal_self_set(id);
+
+    for (uint32_t i = 0; i < RF_ROUNDS; i++) {
+        uint32_t *p = (uint32_t *)gmk_payload_alloc(&rf_alloc, 64);
+        if (!p) {
+            gmk_atomic_add(&rf_bad, 1, memory_order_relaxed);
+            continue;
+        }
+        p[0] = id;
+        p[15] = i;
+
+        /* Hand to the next worker; free whatever it handed us */
+        uintptr_t prev = 0;
+        while (!gmk_atomic_cas_strong(&rf_handoff[next], &prev, (uintptr_t)p,
+                                      memory_order_acq_rel,
+                                      memory_order_relaxed)) {
+            prev = 0;
+            sched_yield();
+        }
+
+        uintptr_t mine;
+        while ((mine = atomic_exchange_explicit(&rf_handoff[id], 0,
+                                                memory_order_acq_rel)) == 0) {
+            sched_yield(); /* wait for the previous worker */
+        }
+        uint32_t *q = (uint32_t *)mine;
+        if (q[0] != (id + RF_WORKERS - 1) % RF_WORKERS)
+            gmk_atomic_add(&rf_bad, 1, memory_order_relaxed);
+        gmk_payload_release(&rf_alloc, q);
+    }
+
+    gmk_alloc_cache_flush(&rf_alloc, id);
+    return NULL;
+}
+
+static void test_remote_free(void) {
+    GMK_ASSERT_EQ(gmk_alloc_init(&rf_alloc, ARENA_SIZE), 0, "alloc init");
+    GMK_ASSERT_EQ(gmk_alloc_cache_init(&rf_alloc, RF_WORKERS), 0, "cache init");
+    atomic_init(&rf_bad, 0);
+    for (uint32_t i = 0; i < RF_WORKERS; i++)
+        atomic_init(&rf_handoff[i], 0);
+
+    pthread_t th[RF_WORKERS];
+    for (uint32_t i = 0; i < RF_WORKERS; i++)
+        pthread_create(&th[i], NULL, remote_free_fn, (void *)(uintptr_t)i);
+    for (uint32_t i = 0; i < RF_WORKERS; i++)
+        pthread_join(th[i], NULL);
+
+    GMK_ASSERT_EQ(gmk_atomic_load(&rf_bad, memory_order_relaxed), 0,
+                  "no failed allocs or corrupted payloads");
+
+    int bin = gmk_block_bin(64 + sizeof(gmk_payload_hdr_t));
+    GMK_ASSERT_EQ(gmk_slab_used(&rf_alloc.block.bins[bin]), 0,
+                  "all payloads back in the slab after flush");
+    GMK_ASSERT_EQ(gmk_atomic_load(&rf_alloc.total_alloc_fails, memory_order_relaxed),
+                  0, "no alloc failures");
+
+    gmk_alloc_destroy(&rf_alloc);
+}
+
+int main(void) {
+    GMK_TEST_BEGIN("alloc_cache");
+    GMK_RUN_TEST(test_unbound_thread_bypasses_cache);
+    GMK_RUN_TEST(test_refill_and_flush);
+    GMK_RUN_TEST(test_remote_free);
+    GMK_TEST_END();
+    return 0;
+}
@@ -4,6 +4,7 @@
 #include "ggmk/alloc.h"
 #include "test_util.h"
 #include <stdlib.h>
+#include <pthread.h>
 
 static void test_basic_alloc_free(void) {
     size_t mem_size = 4096;
@@ -88,11 +89,206 @@ static void test_high_watermark(void) {
     free(mem);
 }
 
+static void test_batch_alloc_free(void) {
+    size_t mem_size = 2048;
+    void *mem = aligned_alloc(64, mem_size);
+    gmk_slab_t s;
+    GMK_ASSERT_EQ(gmk_slab_init(&s, mem, mem_size, 128), 0, "init");
+    uint32_t cap = s.capacity;
+
+    void *objs[32];
+    GMK_ASSERT_EQ(gmk_slab_alloc_n(&s, objs, 4), 4, "alloc_n 4");
+    GMK_ASSERT_EQ(gmk_slab_used(&s), 4, "used == 4");
+    for (uint32_t i = 1; i < 4; i++)
+        GMK_ASSERT_NE((uintptr_t)objs[i], (uintptr_t)objs[i - 1], "distinct");
+
+    GMK_ASSERT_EQ(gmk_slab_alloc_n(&s, objs + 4, 32), cap - 4,
+                  "alloc_n short when slab runs out");
+    GMK_ASSERT_NULL(gmk_slab_alloc(&s), "slab exhausted");
+    GMK_ASSERT_EQ(s.high_water, cap, "high water tracks batches");
+
+    gmk_slab_free_n(&s, objs, cap);
+    GMK_ASSERT_EQ(gmk_slab_used(&s), 0, "free_n returns everything");
+    GMK_ASSERT_NOT_NULL(gmk_slab_alloc(&s), "reusable after free_n");
+
+    gmk_slab_destroy(&s);
+    free(mem);
+}
+
+static void test_modes(void) {
+    static const uint32_t modes[] = {
+        GMK_SLAB_LOCKED, GMK_SLAB_SPIN, GMK_SLAB_LOCKFREE
+    };
+    size_t mem_size = 2048;
+    void *mem = aligned_alloc(64, mem_size);
+    gmk_slab_t s;
+    GMK_ASSERT_EQ(gmk_slab_init(&s, mem, mem_size, 128), 0, "init");
+    GMK_ASSERT_EQ(s.mode, GMK_SLAB_DEFAULT_MODE, "default mode");
+    GMK_ASSERT_EQ(gmk_slab_set_mode(&s, 0), -1, "unknown mode rejected");
+
+    /* Objects allocated in one mode can be freed in the next */
+    void *held = gmk_slab_alloc(&s);
+    for (uint32_t m = 0; m < 3; m++) {
+        GMK_ASSERT_EQ(gmk_slab_set_mode(&s, modes[m]), 0, "set mode");
+        gmk_slab_free(&s, held);
+
+        void *objs[32];
+        uint32_t n = gmk_slab_alloc_n(&s, objs, 32);
+        GMK_ASSERT_EQ(n, s.capacity, "every object reachable");
+        GMK_ASSERT_NULL(gmk_slab_alloc(&s), "exhausted");
+        gmk_slab_free_n(&s, objs + 1, n - 1);
+        held = objs[0];
+        GMK_ASSERT_EQ(gmk_slab_used(&s), 1, "one held across mode switch");
+    }
+    gmk_slab_free(&s, held);
+    GMK_ASSERT_EQ(gmk_slab_used(&s), 0, "all returned");
+
+    gmk_slab_destroy(&s);
+    free(mem);
+}
+
+/* ── Lock-free churn: no object is ever handed out twice ─────────── */
+/* Fresh objects come out in address order; freed ones are reused first */
+static void test_bump_then_list(void) {
+    size_t mem_size = 4096;
+    void *mem = aligned_alloc(64, mem_size);
+    gmk_slab_t s;
+    GMK_ASSERT_EQ(gmk_slab_init(&s, mem, mem_size, 64), 0, "init");
+
+    uint8_t *a = (uint8_t *)gmk_slab_alloc(&s);
+    uint8_t *b = (uint8_t *)gmk_slab_alloc(&s);
+    GMK_ASSERT_EQ((uintptr_t)a, (uintptr_t)mem, "first fresh object at base");
+    GMK_ASSERT_EQ((uintptr_t)b, (uintptr_t)(a + 64), "bump order");
+    GMK_ASSERT_EQ(gmk_atomic_load(&s.fresh, memory_order_relaxed), 2, "two fresh taken");
+
+    gmk_slab_free(&s, a);
+    GMK_ASSERT_EQ((uintptr_t)gmk_slab_alloc(&s), (uintptr_t)a, "freed object reused first");
+    GMK_ASSERT_EQ(gmk_atomic_load(&s.fresh, memory_order_relaxed), 2, "no fresh taken");
+
+    /* A batch drains the list, then continues from the fresh index */
+    gmk_slab_free(&s, b);
+    void *out[4];
+    GMK_ASSERT_EQ(gmk_slab_alloc_n(&s, out, 4), 4, "batch");
+    GMK_ASSERT_EQ((uintptr_t)out[0], (uintptr_t)b, "list first");
+    GMK_ASSERT_EQ((uintptr_t)out[1], (uintptr_t)(a + 128), "then fresh");
+    GMK_ASSERT_EQ((uintptr_t)out[3], (uintptr_t)(a + 256), "fresh in order");
+
+    /* Drain only counts objects ever handed out */
+    GMK_ASSERT_EQ(gmk_slab_drain(&s), -1, "objects still out");
+    gmk_slab_free(&s, a);
+    gmk_slab_free_n(&s, out, 4);
+    GMK_ASSERT_EQ(gmk_slab_drain(&s), 0, "partially bumped slab drains");
+    GMK_ASSERT_NULL(gmk_slab_alloc(&s), "drained slab is empty");
+
+    gmk_slab_destroy(&s);
+    free(mem);
+}
+
+#define LF_THREADS 4
+#define LF_ROUNDS  50000
+
+static gmk_slab_t lf_slab;
+static _Atomic(uint32_t) lf_bad;
+
+static void *lf_fn(void *arg) {
+    uint32_t id = (uint32_t)(uintptr_t)arg + 1;
+    void *held[4];
+
+    for (uint32_t r = 0; r < LF_ROUNDS; r++) {
+        uint32_t n = 0;
+        for (; n < 4; n++) {
+            held[n] = gmk_slab_alloc(&lf_slab);
+            if (!held[n]) break;
+            /* Claim the object; a concurrent owner would have marked it.
+             * Word 1: word 0 holds the link of an intrusive free object */
+            _Atomic(uint32_t) *mark = (_Atomic(uint32_t) *)held[n] + 1;
+            uint32_t zero = 0;
+            if (!gmk_atomic_cas_strong(mark, &zero, id, memory_order_relaxed,
+                                       memory_order_relaxed))
+                gmk_atomic_add(&lf_bad, 1, memory_order_relaxed);
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            gmk_atomic_store((_Atomic(uint32_t) *)held[i] + 1, 0, memory_order_relaxed);
+            gmk_slab_free(&lf_slab, held[i]);
+        }
+    }
+    return NULL;
+}
+
+static void lockfree_churn(bool intrusive) {
+    size_t mem_size = 16 * (64 + (intrusive ? 0 : sizeof(int32_t)));
+    void *mem = aligned_alloc(64, 1024 + mem_size);
+    memset(mem, 0, 1024 + mem_size);
+    GMK_ASSERT_EQ(gmk_slab_init(&lf_slab, mem, mem_size, 64), 0, "init");
+    GMK_ASSERT_EQ(gmk_slab_set_intrusive(&lf_slab, intrusive), 0, "layout");
+    GMK_ASSERT_EQ(lf_slab.capacity, 16, "16 objects");
+    gmk_slab_set_mode(&lf_slab, GMK_SLAB_LOCKFREE);
+    atomic_init(&lf_bad, 0);
+
+    pthread_t th[LF_THREADS];
+    for (uint32_t i = 0; i < LF_THREADS; i++)
+        pthread_create(&th[i], NULL, lf_fn, (void *)(uintptr_t)i);
+    for (uint32_t i = 0; i < LF_THREADS; i++)
+        pthread_join(th[i], NULL);
+
+    GMK_ASSERT_EQ(gmk_atomic_load(&lf_bad, memory_order_relaxed), 0,
+                  "no object owned twice");
+    GMK_ASSERT_EQ(gmk_slab_used(&lf_slab), 0, "all objects returned");
+
+    void *objs[16];
+    GMK_ASSERT_EQ(gmk_slab_alloc_n(&lf_slab, objs, 16), lf_slab.capacity,
+                  "free list intact after churn");
+
+    gmk_slab_destroy(&lf_slab);
+    free(mem);
+}
+
+static void test_lockfree_concurrent(void) {
+    lockfree_churn(false);
+    lockfree_churn(true);
+}
+
+/* ── Intrusive links ─────────────────────────────────────────────── */
+
+static void test_intrusive(void) {
+    size_t mem_size = 4096;
+    void *mem = aligned_alloc(64, mem_size);
+    gmk_slab_t s;
+    GMK_ASSERT_EQ(gmk_slab_init(&s, mem, mem_size, 64), 0, "init");
+    GMK_ASSERT_EQ(s.capacity, 4096 / 68, "array layout");
+    GMK_ASSERT_EQ(gmk_slab_set_intrusive(&s, true), 0, "switch before use");
+    GMK_ASSERT_EQ(s.capacity, 64, "array space reclaimed");
+    GMK_ASSERT_NULL(s.free_list, "no link array");
+
+    /* The link goes in the freed object's first word, nowhere else */
+    void *objs[64];
+    GMK_ASSERT_EQ(gmk_slab_alloc_n(&s, objs, 64), 64, "every object");
+    memset(objs[5], 0xAB, 64);
+    gmk_slab_free(&s, objs[5]);
+    GMK_ASSERT_EQ(((uint8_t *)objs[5])[4], 0xAB, "rest of object untouched");
+    GMK_ASSERT_EQ(gmk_slab_set_intrusive(&s, false), -1, "no switch after use");
+
+    gmk_slab_free_n(&s, objs, 5);
+    GMK_ASSERT_EQ((uintptr_t)gmk_slab_alloc(&s), (uintptr_t)objs[0], "batch reused first");
+    gmk_slab_free(&s, objs[0]);
+    gmk_slab_free_n(&s, objs + 6, 58);
+    GMK_ASSERT_EQ(gmk_slab_used(&s), 0, "all returned");
+    GMK_ASSERT_EQ(gmk_slab_drain(&s), 0, "drain walks the in-object list");
+
+    gmk_slab_destroy(&s);
+    free(mem);
+}
+
 int main(void) {
     GMK_TEST_BEGIN("alloc_slab");
     GMK_RUN_TEST(test_basic_alloc_free);
     GMK_RUN_TEST(test_exhaust_and_reuse);
     GMK_RUN_TEST(test_high_watermark);
+    GMK_RUN_TEST(test_batch_alloc_free);
+    GMK_RUN_TEST(test_modes);
+    GMK_RUN_TEST(test_bump_then_list);
+    GMK_RUN_TEST(test_lockfree_concurrent);
+    GMK_RUN_TEST(test_intrusive);
     GMK_TEST_END();
     return 0;
 }
@@ -33,6 +33,16 @@ static int multi_handler(gmk_ctx_t *ctx) {
     }
 }
 
+/* ── Timer handler: records the tick it ran at ─────────────────── */
+static _Atomic(int)      timer_count;
+static _Atomic(uint64_t) timer_tick;
+
+static int timer_handler(gmk_ctx_t *ctx) {
+    gmk_atomic_store(&timer_tick, ctx->tick, memory_order_relaxed);
+    gmk_atomic_add(&timer_count, 1, memory_order_release);
+    return GMK_OK;
+}
+
 static void test_boot_halt(void) {
     gmk_kernel_t kernel;
     gmk_boot_cfg_t cfg = {
@@ -43,6 +53,8 @@ static void test_boot_halt(void) {
 
     int rc = gmk_boot(&kernel, &cfg, NULL, 0);
     GMK_ASSERT_EQ(rc, 0, "boot with no modules");
+    GMK_ASSERT_EQ(kernel.cfg.batch_size, GMK_WORKER_BATCH_SIZE,
+                  "default batch size");
 
     gmk_halt(&kernel);
 }
@@ -138,6 +150,64 @@ static void test_multi_phase(void) {
     gmk_halt(&kernel);
 }
 
+/* ── Worker-targeted submit ──────────────────────────────────── */
+static _Atomic(int) targeted_count;
+
+static int targeted_handler(gmk_ctx_t *ctx) {
+    (void)ctx;
+    gmk_atomic_add(&targeted_count, 1, memory_order_relaxed);
+    return GMK_OK;
+}
+
+static void test_submit_to(void) {
+    atomic_init(&targeted_count, 0);
+
+    gmk_handler_reg_t handlers[] = {
+        { .type = 11, .fn = targeted_handler, .name = "targeted" },
+    };
+    gmk_module_t mod = {
+        .name = "targeted_mod", .handlers = handlers, .n_handlers = 1,
+    };
+    gmk_module_t *mods[] = { &mod };
+
+    gmk_kernel_t kernel;
+    gmk_boot_cfg_t cfg = {
+        .arena_size = 4 * 1024 * 1024,
+        .n_workers  = 2,
+        .n_tenants  = 1,
+        .batch_size = 4,
+        .slab_mode  = GMK_SLAB_LOCKFREE,
+    };
+    gmk_boot(&kernel, &cfg, mods, 1);
+    GMK_ASSERT_EQ(kernel.pool.workers[1].batch_size, 4, "cfg batch size applied");
+    GMK_ASSERT_EQ(kernel.alloc.task_slab.mode, GMK_SLAB_LOCKFREE,
+                  "cfg slab mode applied");
+
+    gmk_task_t bad;
+    memset(&bad, 0, sizeof(bad));
+    GMK_ASSERT_EQ(gmk_submit_to(&kernel, &bad, 2), GMK_FAIL(GMK_ERR_INVALID),
+                  "out-of-range worker rejected");
+
+    for (int i = 0; i < 20; i++) {
+        gmk_task_t t;
+        memset(&t, 0, sizeof(t));
+        t.type = 11;
+        GMK_ASSERT_EQ(gmk_submit_to(&kernel, &t, (uint32_t)(i & 1)), 0,
+                      "submit_to");
+    }
+
+    for (int wait = 0; wait < 200; wait++) {
+        if (gmk_atomic_load(&targeted_count, memory_order_relaxed) >= 20)
+            break;
+        usleep(5000);
+    }
+
+    GMK_ASSERT_EQ(gmk_atomic_load(&targeted_count, memory_order_relaxed), 20,
+                  "20 targeted tasks completed");
+
+    gmk_halt(&kernel);
+}
+
 static void test_channel_integration(void) {
     atomic_init(&echo_count, 0);
 
@@ -184,12 +254,232 @@ static void test_channel_integration(void) {
     gmk_halt(&kernel);
 }
 
+/* ── Tenant quotas ───────────────────────────────────────────── */
+#define HOG_OBJS 4000   /* 8 MB of 2000-byte objects */
+
+static _Atomic(int)      hog_done;
+static _Atomic(uint32_t) hog_got[2];
+static _Atomic(uintptr_t) hog_alloc[2];
+
+static int hog_handler(gmk_ctx_t *ctx) {
+    static void *objs[HOG_OBJS];
+    uint16_t t = ctx->task->tenant;
+    uint32_t n = 0;
+    while (n < HOG_OBJS && (objs[n] = gmk_alloc(ctx->alloc, 2000)) != NULL)
+        n++;
+    for (uint32_t i = 0; i < n; i++)
+        gmk_free(ctx->alloc, objs[i]);
+    gmk_atomic_store(&hog_got[t], n, memory_order_relaxed);
+    gmk_atomic_store(&hog_alloc[t], (uintptr_t)ctx->alloc, memory_order_relaxed);
+    gmk_atomic_add(&hog_done, 1, memory_order_release);
+    return GMK_OK;
+}
+
+static void test_tenant_quota(void) {
+    atomic_init(&hog_done, 0);
+
+    gmk_handler_reg_t handlers[] = {
+        { .type = 1, .fn = hog_handler, .name = "hog" },
+    };
+    gmk_module_t mod = {
+        .name = "hog_mod", .version = GMK_VERSION(0, 1, 0),
+        .handlers = handlers, .n_handlers = 1,
+    };
+    gmk_module_t *mods[] = { &mod };
+
+    /* Tenant 0 shares the 64 MB kernel arena; tenant 1 gets 4 MB, up to 6 */
+    gmk_kernel_t kernel;
+    gmk_boot_cfg_t cfg = {
+        .arena_size = 64 * 1024 * 1024,
+        .n_workers  = 1,
+        .n_tenants  = 2,
+    };
+    cfg.tenant_quota[1] = (gmk_tenant_quota_t){ 4u << 20, 6u << 20 };
+    GMK_ASSERT_EQ(gmk_boot(&kernel, &cfg, mods, 1), 0, "boot with quotas");
+    GMK_ASSERT(gmk_tenant_alloc(&kernel, 0) == &kernel.alloc, "tenant 0 shares");
+    GMK_ASSERT(gmk_tenant_alloc(&kernel, 1) != &kernel.alloc, "tenant 1 own arena");
+
+    for (uint16_t t = 0; t < 2; t++) {
+        gmk_task_t task;
+        memset(&task, 0, sizeof(task));
+        task.type   = 1;
+        task.tenant = t;
+        gmk_submit(&kernel, &task);
+    }
+    for (int wait = 0; wait < 400; wait++) {
+        if (gmk_atomic_load(&hog_done, memory_order_acquire) >= 2) break;
+        usleep(5000);
+    }
+    GMK_ASSERT_EQ(gmk_atomic_load(&hog_done, memory_order_acquire), 2, "both ran");
+
+    GMK_ASSERT_EQ(gmk_atomic_load(&hog_alloc[1], memory_order_relaxed),
+                  (uintptr_t)gmk_tenant_alloc(&kernel, 1), "ctx alloc by tenant");
+    uint32_t got1 = gmk_atomic_load(&hog_got[1], memory_order_relaxed);
+    GMK_ASSERT(got1 > 1024 && got1 < 3072, "tenant 1 stops at its hard quota");
+    GMK_ASSERT_EQ(gmk_atomic_load(&hog_got[0], memory_order_relaxed), HOG_OBJS,
+                  "tenant 0 unaffected");
+
+    GMK_ASSERT_EQ(gmk_metric_get_tenant(&kernel.metrics, 1, GMK_METRIC_ALLOC_GROWS),
+                  1, "one chunk past the soft quota");
+    GMK_ASSERT_EQ(gmk_metric_get_tenant(&kernel.metrics, 1, GMK_METRIC_ALLOC_FAILS),
+                  1, "hard quota failure counted");
+    GMK_ASSERT(gmk_metric_get_tenant(&kernel.metrics, 1, GMK_METRIC_ALLOC_BYTES)
+               == (uint64_t)got1 * 2000, "tenant 1 bytes");
+    GMK_ASSERT_EQ(gmk_metric_get_tenant(&kernel.metrics, 0, GMK_METRIC_ALLOC_FAILS),
+                  0, "no failures charged to tenant 0");
+
+    gmk_halt(&kernel);
+
+    /* A hard quota too small for a chunk is rejected */
+    cfg.tenant_quota[1] = (gmk_tenant_quota_t){ 4u << 20, (4u << 20) + 4096 };
+    GMK_ASSERT_EQ(gmk_boot(&kernel, &cfg, mods, 1), -1, "bad quota rejected");
+}
+
+/* Timers park in a worker's EVQ shard and fire once the tick reaches them */
+static void test_timer_fires(void) {
+    atomic_init(&timer_count, 0);
+    atomic_init(&timer_tick, 0);
+
+    gmk_handler_reg_t handlers[] = {
+        { .type = 12, .fn = timer_handler, .name = "timer" },
+    };
+    gmk_module_t mod = {
+        .name = "timer_mod", .handlers = handlers, .n_handlers = 1,
+    };
+    gmk_module_t *mods[] = { &mod };
+
+    gmk_kernel_t kernel;
+    gmk_boot_cfg_t cfg = {
+        .arena_size = 4 * 1024 * 1024,
+        .n_workers  = 2,
+        .n_tenants  = 1,
+    };
+    gmk_boot(&kernel, &cfg, mods, 1);
+
+    for (uint32_t i = 0; i < 4; i++) {
+        gmk_task_t t;
+        memset(&t, 0, sizeof(t));
+        t.type  = 12;
+        t.meta0 = 3;
+        GMK_ASSERT_EQ(_gmk_enqueue_at(&kernel.sched, &t, (int)(i & 1), NULL), 0,
+                      "enqueue_at");
+    }
+
+    /* Ticks 1 and 2: nothing due */
+    gmk_tick_advance(&kernel);
+    gmk_tick_advance(&kernel);
+    usleep(20000);
+    GMK_ASSERT_EQ(gmk_atomic_load(&timer_count, memory_order_acquire), 0,
+                  "not fired early");
+
+    gmk_tick_advance(&kernel);
+    for (int wait = 0; wait < 200; wait++) {
+        if (gmk_atomic_load(&timer_count, memory_order_acquire) >= 4)
+            break;
+        usleep(5000);
+    }
+    GMK_ASSERT_EQ(gmk_atomic_load(&timer_count, memory_order_acquire), 4,
+                  "all timers fired");
+    GMK_ASSERT_EQ(gmk_atomic_load(&timer_tick, memory_order_relaxed), 3,
+                  "fired at tick 3");
+    GMK_ASSERT_EQ(gmk_evq_count(&kernel.sched.evqs[0]) +
+                  gmk_evq_count(&kernel.sched.evqs[1]), 0, "shards drained");
+
+    gmk_halt(&kernel);
+}
+
+/* With tick_ns set, the timer thread drives ticks: an ns deadline fires
+ * without manual advances, and a cancelled one never does */
+static void test_timer_deadline(void) {
+    atomic_init(&timer_count, 0);
+    atomic_init(&timer_tick, 0);
+
+    gmk_handler_reg_t handlers[] = {
+        { .type = 12, .fn = timer_handler, .name = "timer" },
+    };
+    gmk_module_t mod = {
+        .name = "timer_mod", .handlers = handlers, .n_handlers = 1,
+    };
+    gmk_module_t *mods[] = { &mod };
+
+    gmk_kernel_t kernel;
+    gmk_boot_cfg_t cfg = {
+        .arena_size = 4 * 1024 * 1024,
+        .n_workers  = 2,
+        .n_tenants  = 1,
+        .tick_ns    = 200000,
+    };
+    GMK_ASSERT_EQ(gmk_boot(&kernel, &cfg, mods, 1), 0, "boot");
+
+    gmk_task_t t;
+    memset(&t, 0, sizeof(t));
+    t.type = 12;
+    uint64_t start = gmk_hal_now_ns();
+    GMK_ASSERT_EQ(gmk_submit_at_ns(&kernel, &t, start + 5000000, -1, NULL), 0,
+                  "submit_at_ns");
+    gmk_evq_handle_t h;
+    GMK_ASSERT_EQ(gmk_submit_at_ns(&kernel, &t, start + 1000000, 1, &h), 0,
+                  "submit_at_ns with handle");
+    GMK_ASSERT_EQ(gmk_timer_cancel(&kernel, h), 0, "cancel");
+    GMK_ASSERT_EQ(gmk_timer_cancel(&kernel, h), -1, "cancel twice");
+
+    for (int wait = 0; wait < 400; wait++) {
+        if (gmk_atomic_load(&timer_count, memory_order_acquire) >= 1)
+            break;
+        usleep(1000);
+    }
+    uint64_t fired = gmk_hal_now_ns();
+    usleep(5000);
+    GMK_ASSERT_EQ(gmk_atomic_load(&timer_count, memory_order_acquire), 1,
+                  "deadline fired once, cancelled one never");
+    GMK_ASSERT(fired - start >= 5000000, "not before the deadline");
+    GMK_ASSERT(gmk_atomic_load(&timer_tick, memory_order_relaxed) >= 25,
+               "fired at or after the deadline tick");
+    gmk_halt(&kernel);
+
+    /* Without a tick period there is no ns clock to map onto */
+    cfg.tick_ns = 0;
+    GMK_ASSERT_EQ(gmk_boot(&kernel, &cfg, mods, 1), 0, "boot no ticker");
+    GMK_ASSERT(gmk_submit_at_ns(&kernel, &t, start, -1, NULL) < 0,
+               "ns deadline needs tick_ns");
+    GMK_ASSERT(gmk_submit_at(&kernel, &t, 1, 2, NULL) < 0, "bad worker");
+    gmk_halt(&kernel);
+}
+
+/* Halt must not wait out the tick period (1 s ticks), whether the timer
+ * thread is just starting or already asleep */
+static void test_ticker_halt(void) {
+    gmk_kernel_t kernel;
+    gmk_boot_cfg_t cfg = {
+        .arena_size = 4 * 1024 * 1024,
+        .n_workers  = 1,
+        .n_tenants  = 1,
+        .tick_ns    = 1000000000ull,
+    };
+
+    uint64_t worst = 0;
+    for (int i = 0; i < 5; i++) {
+        GMK_ASSERT_EQ(gmk_boot(&kernel, &cfg, NULL, 0), 0, "boot");
+        if (i % 2) usleep(5000);   /* also halt a ticker that is asleep */
+        uint64_t t0 = gmk_hal_now_ns();
+        gmk_halt(&kernel);
+        uint64_t ns = gmk_hal_now_ns() - t0;
+        if (ns > worst) worst = ns;
+    }
+    GMK_ASSERT(worst < cfg.tick_ns / 5, "halt does not wait for the next tick");
+}
+
 int main(void) {
     GMK_TEST_BEGIN("boot");
     GMK_RUN_TEST(test_boot_halt);
     GMK_RUN_TEST(test_boot_with_handler);
     GMK_RUN_TEST(test_multi_phase);
     GMK_RUN_TEST(test_channel_integration);
+    GMK_RUN_TEST(test_submit_to);
+    GMK_RUN_TEST(test_tenant_quota);
+    GMK_RUN_TEST(test_timer_fires);
+    GMK_RUN_TEST(test_timer_deadline);
+    GMK_RUN_TEST(test_ticker_halt);
     GMK_TEST_END();
     return 0;
 }
@@ -45,6 +45,63 @@ static void test_enqueue_to_lq(void) {
     gmk_sched_destroy(&s);
 }
 
+static void test_enqueue_n(void) {
+    gmk_sched_t s;
+    gmk_sched_init(&s, 2);
+
+    gmk_task_t batch[4];
+    for (uint32_t i = 0; i < 4; i++)
+        batch[i] = make_task(30 + i, GMK_PRIO_NORMAL);
+
+    GMK_ASSERT_EQ(_gmk_enqueue_n(&s, batch, 4, 1), 4, "enqueue_n to LQ[1]");
+    GMK_ASSERT_EQ(batch[3].seq, 3, "contiguous seqs reserved");
+
+    gmk_task_t out;
+    for (uint32_t i = 0; i < 4; i++) {
+        GMK_ASSERT_EQ(gmk_lq_pop(&s.lqs[1], &out), 0, "pop LQ[1]");
+        GMK_ASSERT_EQ(out.seq, i, "seq order kept");
+    }
+
+    GMK_ASSERT_EQ(_gmk_enqueue_n(&s, batch, 4, -1), 4, "enqueue_n to RQ");
+    GMK_ASSERT_EQ(gmk_rq_count(&s.rq), 4, "RQ holds batch");
+    GMK_ASSERT_EQ(batch[0].seq, 4, "seq continues");
+
+    gmk_sched_destroy(&s);
+}
+
+static void test_enqueue_copy_n(void) {
+    gmk_sched_t s;
+    gmk_sched_init(&s, 2);
+
+    /* Leave room for two tasks in worker 1's inbox */
+    gmk_task_t fill = make_task(50, GMK_PRIO_NORMAL);
+    uint32_t filled = 0;
+    while (gmk_lq_push_remote(&s.lqs[1], &fill) == 0)
+        filled++;
+    gmk_task_t out;
+    GMK_ASSERT_EQ(gmk_ring_mpmc_pop(&s.lqs[1].inbox, &out), 0, "free one");
+    GMK_ASSERT_EQ(gmk_ring_mpmc_pop(&s.lqs[1].inbox, &out), 0, "free two");
+
+    gmk_task_t tasks[4] = {
+        make_task(51, GMK_PRIO_NORMAL), make_task(52, GMK_PRIO_NORMAL),
+        make_task(53, GMK_PRIO_HIGH),   make_task(54, GMK_PRIO_LOW),
+    };
+    const gmk_task_t *src[4] = { &tasks[0], &tasks[1], &tasks[2], &tasks[3] };
+    uint32_t seq0 = gmk_atomic_load(&s.next_seq, memory_order_relaxed);
+    GMK_ASSERT_EQ(_gmk_enqueue_copy_n(&s, src, 4, 1), 4, "all four enqueued");
+    GMK_ASSERT_EQ(tasks[3].seq, 0, "sources untouched");
+
+    GMK_ASSERT_EQ(gmk_ring_mpmc_count(&s.lqs[1].inbox), filled, "inbox full again");
+    GMK_ASSERT_EQ(gmk_rq_count(&s.rq), 2, "overflow to RQ");
+    GMK_ASSERT_EQ(gmk_rq_pop(&s.rq, &out), 0, "pop HIGH");
+    GMK_ASSERT_EQ(out.type, 53, "HIGH first");
+    GMK_ASSERT_EQ(out.seq, seq0 + 2, "seq stamped in the cell");
+    GMK_ASSERT_EQ(gmk_rq_pop(&s.rq, &out), 0, "pop LOW");
+    GMK_ASSERT_EQ(out.type, 54, "LOW next");
+
+    gmk_sched_destroy(&s);
+}
+
 static void test_seq_monotonic(void) {
     gmk_sched_t s;
     gmk_sched_init(&s, 2);
@@ -100,7 +157,7 @@ static void test_yield_overflow(void) {
     memset(&fill, 0, sizeof(fill));
     fill.type = 99;
     for (uint32_t i = 0; i < GMK_LQ_DEFAULT_CAP; i++) {
-        gmk_ring_spsc_push(&s.lqs[0].ring, &fill);
+        gmk_ring_spmc_push(&s.lqs[0].ring, &fill);
     }
 
     /* Yield should go to overflow bucket */
@@ -132,15 +189,61 @@ static void test_yield_at(void) {
     gmk_sched_destroy(&s);
 }
 
+static void test_enqueue_at(void) {
+    gmk_sched_t s;
+    gmk_sched_init(&s, 2);
+
+    /* Routed to worker 1's shard; fires there in tick order */
+    gmk_task_t t = make_task(5, GMK_PRIO_NORMAL);
+    t.meta0 = 30;
+    gmk_evq_handle_t h;
+    GMK_ASSERT_EQ(_gmk_enqueue_at(&s, &t, 1, &h), 0, "enqueue_at worker 1");
+    t.meta0 = 20;
+    t.type  = 6;
+    gmk_evq_handle_t h6;
+    GMK_ASSERT_EQ(_gmk_enqueue_at(&s, &t, 1, &h6), 0, "second timer");
+    GMK_ASSERT_EQ(gmk_evq_count(&s.evqs[0]), 0, "shard 0 untouched");
+    GMK_ASSERT_EQ(gmk_evq_count(&s.evqs[1]), 2, "shard 1 holds both");
+    GMK_ASSERT_EQ(gmk_evq_next_due(&s.evqs[1]), 20, "peek");
+
+    GMK_ASSERT_EQ(_gmk_cancel_at(&s, h6), 0, "cancel through handle");
+    GMK_ASSERT_EQ(_gmk_cancel_at(&s, h6), -1, "cancel twice");
+
+    gmk_task_t out;
+    GMK_ASSERT_EQ(gmk_evq_pop_due(&s.evqs[1], 30, &out), 0, "due at 30");
+    GMK_ASSERT_EQ(out.type, 5, "surviving timer");
+    GMK_ASSERT_EQ(_gmk_cancel_at(&s, h), -1, "cancel after fire");
+
+    /* A full shard spills to the next one, and the handle follows it */
+    gmk_evq_t *first = &s.evqs[0];
+    uint32_t fails = 0;
+    for (uint32_t i = 0; i < first->cap; i++) {
+        t.meta0 = 100 + i;
+        if (_gmk_enqueue_at(&s, &t, 0, NULL) != 0) fails++;
+    }
+    GMK_ASSERT_EQ(fails, 0, "fill shard 0");
+    GMK_ASSERT_EQ(gmk_evq_count(first), first->cap, "shard 0 full");
+    t.meta0 = 50;
+    GMK_ASSERT_EQ(_gmk_enqueue_at(&s, &t, 0, &h), 0, "spill");
+    GMK_ASSERT_EQ(gmk_evq_count(&s.evqs[1]), 1, "landed on shard 1");
+    GMK_ASSERT_EQ(_gmk_cancel_at(&s, h), 0, "cancel spilled timer");
+    GMK_ASSERT_EQ(gmk_evq_count(&s.evqs[1]), 0, "shard 1 empty");
+
+    gmk_sched_destroy(&s);
+}
+
 int main(void) {
     GMK_TEST_BEGIN("enqueue");
     GMK_RUN_TEST(test_enqueue_to_rq);
     GMK_RUN_TEST(test_enqueue_to_lq);
+    GMK_RUN_TEST(test_enqueue_n);
+    GMK_RUN_TEST(test_enqueue_copy_n);
     GMK_RUN_TEST(test_seq_monotonic);
     GMK_RUN_TEST(test_yield_basic);
     GMK_RUN_TEST(test_yield_circuit_breaker);
     GMK_RUN_TEST(test_yield_overflow);
     GMK_RUN_TEST(test_yield_at);
+    GMK_RUN_TEST(test_enqueue_at);
     GMK_TEST_END();
     return 0;
 }
@@ -64,6 +64,33 @@ static void test_reset(void) {
 
 static gmk_metrics_t conc_metrics;
 
+static void test_batch_histogram(void) {
+    gmk_metrics_t m;
+    gmk_metrics_init(&m, 1);
+
+    gmk_metric_batch(&m, 1);    /* bucket 0 */
+    gmk_metric_batch(&m, 2);    /* bucket 1 */
+    gmk_metric_batch(&m, 3);    /* bucket 2: (2, 4] */
+    gmk_metric_batch(&m, 4);    /* bucket 2 */
+    gmk_metric_batch(&m, 32);   /* bucket 5 */
+    gmk_metric_batch(&m, 256);  /* bucket 8 */
+    gmk_metric_batch(&m, 1000); /* clamped to last bucket */
+    gmk_metric_batch(&m, 0);    /* ignored */
+
+    GMK_ASSERT_EQ(gmk_metric_batch_get(&m, 0), 1, "bucket 1");
+    GMK_ASSERT_EQ(gmk_metric_batch_get(&m, 1), 1, "bucket 2");
+    GMK_ASSERT_EQ(gmk_metric_batch_get(&m, 2), 2, "bucket 3..4");
+    GMK_ASSERT_EQ(gmk_metric_batch_get(&m, 5), 1, "bucket 17..32");
+    GMK_ASSERT_EQ(gmk_metric_batch_get(&m, 8), 2, "bucket 129..256 + clamp");
+    GMK_ASSERT_EQ(gmk_metric_batch_get(&m, GMK_BATCH_HIST_BUCKETS), 0,
+                  "out-of-range bucket reads 0");
+
+    gmk_metrics_reset(&m);
+    GMK_ASSERT_EQ(gmk_metric_batch_get(&m, 2), 0, "reset clears histogram");
+
+    gmk_metrics_destroy(&m);
+}
+
 static void *metric_thread(void *arg) {
     uint16_t tenant = (uint16_t)(uintptr_t)arg;
     for (int i = 0; i < METRIC_ITERS; i++) {
@@ -99,6 +126,7 @@ int main(void) {
     GMK_RUN_TEST(test_basic_inc_get);
     GMK_RUN_TEST(test_multiple_metrics);
     GMK_RUN_TEST(test_reset);
+    GMK_RUN_TEST(test_batch_histogram);
     GMK_RUN_TEST(test_concurrent);
     GMK_TEST_END();
     return 0;
@@ -59,6 +59,137 @@ static void test_wraparound(void) {
     gmk_ring_mpmc_destroy(&r);
 }
 
+/* Init leaves the buffer untouched; the ring still works once it wraps
+ * and the stored sequences are no longer zero */
+static void test_lazy_init(void) {
+    gmk_ring_mpmc_t r;
+    GMK_ASSERT_EQ(gmk_ring_mpmc_init(&r, 64, sizeof(uint32_t)), 0, "init");
+
+    size_t dirty = 0;
+    for (size_t i = 0; i < r.buf_bytes; i++)
+        dirty += r.buf[i] != 0;
+    GMK_ASSERT_EQ(dirty, 0, "init wrote nothing");
+
+    uint32_t in[48], out[48];
+    for (uint32_t round = 0; round < 10; round++) {
+        for (uint32_t i = 0; i < 48; i++) in[i] = round * 48 + i;
+        GMK_ASSERT_EQ(gmk_ring_mpmc_push_n(&r, in, 48), 48, "push_n");
+        GMK_ASSERT_EQ(gmk_ring_mpmc_pop_n(&r, out, 48), 48, "pop_n");
+        GMK_ASSERT_EQ(out[47], round * 48 + 47, "order kept across wraps");
+    }
+    GMK_ASSERT_EQ(gmk_ring_mpmc_pop(&r, out), -1, "empty after wraps");
+
+    gmk_ring_mpmc_destroy(&r);
+}
+
+/* ── Bulk push/pop ───────────────────────────────────────────── */
+static void test_bulk(void) {
+    gmk_ring_mpmc_t r;
+    GMK_ASSERT_EQ(gmk_ring_mpmc_init(&r, 8, sizeof(uint32_t)), 0, "init");
+
+    uint32_t in[10], out[10];
+    for (uint32_t i = 0; i < 10; i++) in[i] = 100 + i;
+
+    GMK_ASSERT_EQ(gmk_ring_mpmc_push_n(&r, in, 5), 5, "push_n 5");
+    GMK_ASSERT_EQ(gmk_ring_mpmc_push_n(&r, in + 5, 5), 3, "push_n short when full");
+    GMK_ASSERT_EQ(gmk_ring_mpmc_push_n(&r, in, 1), 0, "push_n on full");
+
+    GMK_ASSERT_EQ(gmk_ring_mpmc_pop_n(&r, out, 6), 6, "pop_n 6");
+    for (uint32_t i = 0; i < 6; i++)
+        GMK_ASSERT_EQ(out[i], 100 + i, "pop_n FIFO");
+
+    /* Wrap: push across the end of the buffer, mix with single pops */
+    GMK_ASSERT_EQ(gmk_ring_mpmc_push_n(&r, in, 6), 6, "push_n wraps");
+    uint32_t one;
+    GMK_ASSERT_EQ(gmk_ring_mpmc_pop(&r, &one), 0, "single pop");
+    GMK_ASSERT_EQ(one, 106, "single pop sees bulk-pushed data");
+    GMK_ASSERT_EQ(gmk_ring_mpmc_pop_n(&r, out, 10), 7, "pop_n drains");
+    GMK_ASSERT_EQ(out[0], 107, "order after wrap");
+    GMK_ASSERT_EQ(out[6], 105, "last bulk element");
+    GMK_ASSERT_EQ(gmk_ring_mpmc_pop_n(&r, out, 10), 0, "pop_n on empty");
+
+    gmk_ring_mpmc_destroy(&r);
+}
+
+/* ── Zero-copy reserve/commit, peek/release ──────────────────── */
+static void test_reserve_peek(void) {
+    gmk_ring_mpmc_t r;
+    GMK_ASSERT_EQ(gmk_ring_mpmc_init(&r, 4, sizeof(uint32_t)), 0, "init");
+
+    uint32_t p0, p1, pos;
+    uint32_t *a = (uint32_t *)gmk_ring_mpmc_reserve(&r, &p0);
+    uint32_t *b = (uint32_t *)gmk_ring_mpmc_reserve(&r, &p1);
+    GMK_ASSERT(a && b && a != b, "two distinct reservations");
+    *b = 2;
+    gmk_ring_mpmc_commit(&r, p1);
+
+    /* Out-of-order commit: consumers wait on the first cell */
+    GMK_ASSERT(gmk_ring_mpmc_peek(&r, &pos) == NULL, "blocked on uncommitted head");
+    *a = 1;
+    gmk_ring_mpmc_commit(&r, p0);
+
+    const uint32_t *v = (const uint32_t *)gmk_ring_mpmc_peek(&r, &pos);
+    GMK_ASSERT(v != NULL, "peek");
+    GMK_ASSERT_EQ(*v, 1, "peek reads first cell in place");
+    uint32_t out;
+    GMK_ASSERT_EQ(gmk_ring_mpmc_pop(&r, &out), 0, "pop past a peeked cell");
+    GMK_ASSERT_EQ(out, 2, "second element");
+    gmk_ring_mpmc_release(&r, pos);
+
+    for (uint32_t i = 0; i < 4; i++) {
+        a = (uint32_t *)gmk_ring_mpmc_reserve(&r, &pos);
+        GMK_ASSERT(a != NULL, "reserve fill");
+        *a = 10 + i;
+        gmk_ring_mpmc_commit(&r, pos);
+    }
+    GMK_ASSERT(gmk_ring_mpmc_reserve(&r, &pos) == NULL, "reserve on full");
+    for (uint32_t i = 0; i < 4; i++) {
+        v = (const uint32_t *)gmk_ring_mpmc_peek(&r, &pos);
+        GMK_ASSERT_EQ(*v, 10 + i, "FIFO across wrap");
+        gmk_ring_mpmc_release(&r, pos);
+    }
+    GMK_ASSERT(gmk_ring_mpmc_peek(&r, &pos) == NULL, "peek on empty");
+
+    gmk_ring_mpmc_destroy(&r);
+}
+
+static void test_reserve_peek_n(void) {
+    gmk_ring_mpmc_t r;
+    GMK_ASSERT_EQ(gmk_ring_mpmc_init(&r, 8, sizeof(uint32_t)), 0, "init");
+
+    /* Offset the indices so the runs below wrap the buffer */
+    uint32_t pos, out[6];
+    for (uint32_t i = 0; i < 6; i++) GMK_ASSERT_EQ(gmk_ring_mpmc_push(&r, &i), 0, "push");
+    GMK_ASSERT_EQ(gmk_ring_mpmc_pop_n(&r, out, 6), 6, "pop");
+
+    GMK_ASSERT_EQ(gmk_ring_mpmc_reserve_n(&r, 5, &pos), 5, "reserve run");
+    for (uint32_t i = 0; i < 5; i++)
+        *(uint32_t *)gmk_ring_mpmc_slot(&r, pos + i) = 100 + i;
+    GMK_ASSERT_EQ(gmk_ring_mpmc_peek_n(&r, 8, &pos), 0, "nothing visible before commit");
+    gmk_ring_mpmc_commit_n(&r, pos, 5);
+
+    uint32_t more;
+    GMK_ASSERT_EQ(gmk_ring_mpmc_reserve_n(&r, 8, &more), 3, "short run when nearly full");
+    for (uint32_t i = 0; i < 3; i++)
+        *(uint32_t *)gmk_ring_mpmc_slot(&r, more + i) = 200 + i;
+    gmk_ring_mpmc_commit_n(&r, more, 3);
+    GMK_ASSERT_EQ(gmk_ring_mpmc_reserve_n(&r, 1, &more), 0, "reserve_n on full");
+
+    GMK_ASSERT_EQ(gmk_ring_mpmc_peek_n(&r, 4, &pos), 4, "peek run");
+    for (uint32_t i = 0; i < 4; i++)
+        GMK_ASSERT_EQ(*(const uint32_t *)gmk_ring_mpmc_slot(&r, pos + i), 100 + i,
+                      "read in place across the wrap");
+    GMK_ASSERT_EQ(gmk_ring_mpmc_reserve_n(&r, 1, &more), 0, "peeked cells not free yet");
+    gmk_ring_mpmc_release_n(&r, pos, 4);
+    GMK_ASSERT_EQ(gmk_ring_mpmc_count(&r), 4, "four left");
+
+    GMK_ASSERT_EQ(gmk_ring_mpmc_pop_n(&r, out, 6), 4, "rest");
+    GMK_ASSERT_EQ(out[0], 104, "FIFO after release_n");
+    GMK_ASSERT_EQ(out[3], 202, "last element");
+
+    gmk_ring_mpmc_destroy(&r);
+}
+
 /* ── Multi-producer concurrent test ──────────────────────────── */
 #define NUM_PRODUCERS 4
 #define NUM_CONSUMERS 4
@@ -103,6 +234,79 @@ static void *mpmc_consumer(void *arg) {
     return NULL;
 }
 
+#define BULK_CHUNK 16
+
+static void *mpmc_bulk_producer(void *arg) {
+    thread_arg_t *a = (thread_arg_t *)arg;
+    uint64_t local_sum = 0;
+    uint32_t vals[BULK_CHUNK];
+    for (uint32_t i = 0; i < ITEMS_PER_THREAD; i += BULK_CHUNK) {
+        uint32_t n = ITEMS_PER_THREAD - i < BULK_CHUNK ? ITEMS_PER_THREAD - i
+                                                       : BULK_CHUNK;
+        for (uint32_t j = 0; j < n; j++) {
+            vals[j] = a->thread_id * ITEMS_PER_THREAD + i + j;
+            local_sum += vals[j];
+        }
+        uint32_t done = 0;
+        while (done < n)
+            done += gmk_ring_mpmc_push_n(a->ring, vals + done, n - done);
+    }
+    gmk_atomic_add(&producer_sum, local_sum, memory_order_relaxed);
+    return NULL;
+}
+
+static void *mpmc_bulk_consumer(void *arg) {
+    thread_arg_t *a = (thread_arg_t *)arg;
+    uint64_t local_sum = 0;
+    uint32_t total = NUM_PRODUCERS * ITEMS_PER_THREAD;
+    uint32_t vals[BULK_CHUNK];
+    while (gmk_atomic_load(&total_consumed, memory_order_relaxed) < total) {
+        uint32_t n = gmk_ring_mpmc_pop_n(a->ring, vals, BULK_CHUNK);
+        for (uint32_t j = 0; j < n; j++)
+            local_sum += vals[j];
+        if (n) gmk_atomic_add(&total_consumed, n, memory_order_relaxed);
+    }
+    gmk_atomic_add(&consumer_sum, local_sum, memory_order_relaxed);
+    return NULL;
+}
+
+static void test_mpmc_concurrent_bulk(void) {
+    gmk_ring_mpmc_t r;
+    GMK_ASSERT_EQ(gmk_ring_mpmc_init(&r, 256, sizeof(uint32_t)), 0, "init");
+
+    atomic_init(&producer_sum, 0);
+    atomic_init(&consumer_sum, 0);
+    atomic_init(&total_consumed, 0);
+
+    pthread_t prods[NUM_PRODUCERS], cons[NUM_CONSUMERS];
+    thread_arg_t pargs[NUM_PRODUCERS], cargs[NUM_CONSUMERS];
+
+    /* Half the consumers use the single-element path to mix both */
+    for (int i = 0; i < NUM_CONSUMERS; i++) {
+        cargs[i] = (thread_arg_t){ .ring = &r, .thread_id = (uint32_t)i };
+        pthread_create(&cons[i], NULL,
+                       (i & 1) ? mpmc_consumer : mpmc_bulk_consumer, &cargs[i]);
+    }
+    for (int i = 0; i < NUM_PRODUCERS; i++) {
+        pargs[i] = (thread_arg_t){ .ring = &r, .thread_id = (uint32_t)i };
+        pthread_create(&prods[i], NULL, mpmc_bulk_producer, &pargs[i]);
+    }
+
+    for (int i = 0; i < NUM_PRODUCERS; i++)
+        pthread_join(prods[i], NULL);
+    for (int i = 0; i < NUM_CONSUMERS; i++)
+        pthread_join(cons[i], NULL);
+
+    uint64_t ps = gmk_atomic_load(&producer_sum, memory_order_relaxed);
+    uint64_t cs = gmk_atomic_load(&consumer_sum, memory_order_relaxed);
+    GMK_ASSERT_EQ(ps, cs, "bulk: producer sum == consumer sum");
+
+    uint32_t tc = gmk_atomic_load(&total_consumed, memory_order_relaxed);
+    GMK_ASSERT_EQ(tc, NUM_PRODUCERS * ITEMS_PER_THREAD, "bulk: all items consumed");
+
+    gmk_ring_mpmc_destroy(&r);
+}
+
 static void test_mpmc_concurrent(void) {
     gmk_ring_mpmc_t r;
     GMK_ASSERT_EQ(gmk_ring_mpmc_init(&r, 1024, sizeof(uint32_t)), 0, "init");
@@ -158,13 +362,79 @@ static void test_task_sized(void) {
     gmk_ring_mpmc_destroy(&r);
 }
 
+/* ── Cell layouts ────────────────────────────────────────────── */
+static void test_layouts(void) {
+    static const uint32_t layouts[] = {
+        GMK_RING_PACKED, GMK_RING_PADDED, GMK_RING_SPLIT
+    };
+
+    for (uint32_t l = 0; l < 3; l++) {
+        gmk_ring_mpmc_t r;
+        GMK_ASSERT_EQ(gmk_ring_mpmc_init_layout(&r, 8, 48, layouts[l]), 0,
+                      "init layout");
+
+        uint8_t in[10][48], out[10][48];
+        for (uint32_t i = 0; i < 10; i++) {
+            memset(in[i], (int)(0x10 + i), 48);
+            *(uint32_t *)in[i] = i;
+        }
+
+        /* Mix single, bulk and zero-copy paths across the wrap */
+        for (int round = 0; round < 3; round++) {
+            GMK_ASSERT_EQ(gmk_ring_mpmc_push(&r, in[0]), 0, "push");
+            GMK_ASSERT_EQ(gmk_ring_mpmc_push_n(&r, in[1], 5), 5, "push_n");
+            uint32_t pos;
+            uint8_t *slot = (uint8_t *)gmk_ring_mpmc_reserve(&r, &pos);
+            GMK_ASSERT(slot != NULL, "reserve");
+            memcpy(slot, in[6], 48);
+            gmk_ring_mpmc_commit(&r, pos);
+            GMK_ASSERT_EQ(gmk_ring_mpmc_push(&r, in[7]), 0, "push to full");
+            GMK_ASSERT_EQ(gmk_ring_mpmc_push(&r, in[8]), -1, "full");
+
+            GMK_ASSERT_EQ(gmk_ring_mpmc_pop_n(&r, out, 10), 8, "pop_n all");
+            for (uint32_t i = 0; i < 8; i++) {
+                GMK_ASSERT_EQ(*(uint32_t *)out[i], i, "FIFO per layout");
+                GMK_ASSERT_EQ(out[i][47], 0x10 + i, "last byte per layout");
+            }
+        }
+
+        /* Slot addresses follow the layout's stride */
+        uint32_t p0, p1;
+        uint8_t *a = (uint8_t *)gmk_ring_mpmc_reserve(&r, &p0);
+        uint8_t *b = (uint8_t *)gmk_ring_mpmc_reserve(&r, &p1);
+        size_t stride = (size_t)(b - a);
+        if (layouts[l] == GMK_RING_PACKED)
+            GMK_ASSERT_EQ(stride, 56, "packed stride");
+        else if (layouts[l] == GMK_RING_PADDED)
+            GMK_ASSERT_EQ(stride, GMK_CACHE_LINE, "padded stride is one line");
+        else
+            GMK_ASSERT_EQ(stride, 48, "split data is dense");
+        gmk_ring_mpmc_commit(&r, p0);
+        gmk_ring_mpmc_commit(&r, p1);
+
+        GMK_ASSERT_EQ(r.buf_bytes, gmk_ring_mpmc_buf_size(8, 48, layouts[l]),
+                      "buf_size matches allocation");
+        gmk_ring_mpmc_destroy(&r);
+    }
+
+    gmk_ring_mpmc_t bad;
+    GMK_ASSERT_EQ(gmk_ring_mpmc_init_layout(&bad, 8, 48, 3), -1,
+                  "unknown layout rejected");
+}
+
 int main(void) {
     GMK_TEST_BEGIN("ring_mpmc");
     GMK_RUN_TEST(test_basic_push_pop);
     GMK_RUN_TEST(test_full_and_empty);
     GMK_RUN_TEST(test_wraparound);
+    GMK_RUN_TEST(test_lazy_init);
     GMK_RUN_TEST(test_task_sized);
+    GMK_RUN_TEST(test_layouts);
+    GMK_RUN_TEST(test_bulk);
+    GMK_RUN_TEST(test_reserve_peek);
+    GMK_RUN_TEST(test_reserve_peek_n);
     GMK_RUN_TEST(test_mpmc_concurrent);
+    GMK_RUN_TEST(test_mpmc_concurrent_bulk);
     GMK_TEST_END();
     return 0;
 }
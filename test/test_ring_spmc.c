@@ -0,0 +1,196 @@
+/*
+ * GGMK/cpu — SPMC ring buffer tests
+ */
+#include "ggmk/ring_spmc.h"
+#include "test_util.h"
+#include <pthread.h>
+
+static void test_basic_push_pop(void) {
+    gmk_ring_spmc_t r;
+    GMK_ASSERT_EQ(gmk_ring_spmc_init(&r, 8, sizeof(uint32_t)), 0, "init");
+
+    uint32_t val = 42;
+    GMK_ASSERT_EQ(gmk_ring_spmc_push(&r, &val), 0, "push 42");
+    val = 99;
+    GMK_ASSERT_EQ(gmk_ring_spmc_push(&r, &val), 0, "push 99");
+    GMK_ASSERT_EQ(gmk_ring_spmc_count(&r), 2, "count == 2");
+
+    uint32_t out;
+    GMK_ASSERT_EQ(gmk_ring_spmc_pop(&r, &out), 0, "pop");
+    GMK_ASSERT_EQ(out, 42, "FIFO: first out is 42");
+    GMK_ASSERT_EQ(gmk_ring_spmc_pop(&r, &out), 0, "pop");
+    GMK_ASSERT_EQ(out, 99, "FIFO: second out is 99");
+    GMK_ASSERT(gmk_ring_spmc_empty(&r), "ring empty after draining");
+    GMK_ASSERT_EQ(gmk_ring_spmc_pop(&r, &out), -1, "pop when empty fails");
+
+    gmk_ring_spmc_destroy(&r);
+}
+
+static void test_full(void) {
+    gmk_ring_spmc_t r;
+    GMK_ASSERT_EQ(gmk_ring_spmc_init(&r, 4, sizeof(uint32_t)), 0, "init");
+
+    for (uint32_t i = 0; i < 4; i++)
+        GMK_ASSERT_EQ(gmk_ring_spmc_push(&r, &i), 0, "push fill");
+
+    uint32_t val = 100;
+    GMK_ASSERT_EQ(gmk_ring_spmc_push(&r, &val), -1, "push when full fails");
+    GMK_ASSERT_EQ(gmk_ring_spmc_count(&r), 4, "count == cap");
+
+    gmk_ring_spmc_destroy(&r);
+}
+
+static void test_pop_n(void) {
+    gmk_ring_spmc_t r;
+    GMK_ASSERT_EQ(gmk_ring_spmc_init(&r, 8, sizeof(uint32_t)), 0, "init");
+
+    for (uint32_t i = 0; i < 6; i++)
+        gmk_ring_spmc_push(&r, &i);
+
+    uint32_t out[8];
+    GMK_ASSERT_EQ(gmk_ring_spmc_pop_n(&r, out, 4), 4, "pop_n capped by max");
+    for (uint32_t i = 0; i < 4; i++)
+        GMK_ASSERT_EQ(out[i], i, "pop_n FIFO");
+    GMK_ASSERT_EQ(gmk_ring_spmc_pop_n(&r, out, 8), 2, "pop_n takes the rest");
+    GMK_ASSERT_EQ(out[1], 5, "last element");
+    GMK_ASSERT_EQ(gmk_ring_spmc_pop_n(&r, out, 8), 0, "pop_n on empty");
+
+    gmk_ring_spmc_destroy(&r);
+}
+
+static void test_steal_half(void) {
+    gmk_ring_spmc_t victim, thief;
+    GMK_ASSERT_EQ(gmk_ring_spmc_init(&victim, 16, sizeof(uint32_t)), 0, "init victim");
+    GMK_ASSERT_EQ(gmk_ring_spmc_init(&thief, 16, sizeof(uint32_t)), 0, "init thief");
+
+    for (uint32_t i = 0; i < 9; i++)
+        gmk_ring_spmc_push(&victim, &i);
+
+    /* Larger half of 9 is 5, taken from the head */
+    GMK_ASSERT_EQ(gmk_ring_spmc_steal(&thief, &victim, 16), 5, "stole 5");
+    GMK_ASSERT_EQ(gmk_ring_spmc_count(&victim), 4, "victim keeps 4");
+    GMK_ASSERT_EQ(gmk_ring_spmc_count(&thief), 5, "thief has 5");
+
+    uint32_t out;
+    for (uint32_t i = 0; i < 5; i++) {
+        gmk_ring_spmc_pop(&thief, &out);
+        GMK_ASSERT_EQ(out, i, "thief gets oldest tasks in order");
+    }
+    gmk_ring_spmc_pop(&victim, &out);
+    GMK_ASSERT_EQ(out, 5, "victim continues where thief stopped");
+
+    /* max bounds the steal; a lone element is still stealable */
+    GMK_ASSERT_EQ(gmk_ring_spmc_steal(&thief, &victim, 1), 1, "steal capped by max");
+    GMK_ASSERT_EQ(gmk_ring_spmc_steal(&thief, &victim, 0), 0, "max 0 steals nothing");
+
+    gmk_ring_spmc_destroy(&victim);
+    gmk_ring_spmc_destroy(&thief);
+}
+
+static void test_wraparound(void) {
+    gmk_ring_spmc_t victim, thief;
+    gmk_ring_spmc_init(&victim, 4, sizeof(uint32_t));
+    gmk_ring_spmc_init(&thief, 4, sizeof(uint32_t));
+
+    uint32_t out, next_in = 0, next_out = 0;
+    for (int round = 0; round < 50; round++) {
+        while (gmk_ring_spmc_push(&victim, &next_in) == 0)
+            next_in++;
+        gmk_ring_spmc_steal(&thief, &victim, 4);
+        while (gmk_ring_spmc_pop(&thief, &out) == 0)
+            GMK_ASSERT_EQ(out, next_out++, "order across wrap (thief)");
+        while (gmk_ring_spmc_pop(&victim, &out) == 0)
+            GMK_ASSERT_EQ(out, next_out++, "order across wrap (victim)");
+    }
+    GMK_ASSERT_EQ(next_out, next_in, "every element seen once");
+
+    gmk_ring_spmc_destroy(&victim);
+    gmk_ring_spmc_destroy(&thief);
+}
+
+/* ── Concurrent test: owner pushes/pops, thieves steal ───────── */
+#define CONC_COUNT   100000
+#define CONC_THIEVES 3
+
+static gmk_ring_spmc_t conc_ring;
+static _Atomic(bool)   conc_done;
+static _Atomic(uint32_t) conc_seen;
+
+static void *owner_fn(void *arg) {
+    uint64_t *sum = (uint64_t *)arg;
+    for (uint32_t i = 0; i < CONC_COUNT; i++) {
+        while (gmk_ring_spmc_push(&conc_ring, &i) != 0) {
+            uint32_t v;
+            if (gmk_ring_spmc_pop(&conc_ring, &v) == 0) {
+                *sum += v;
+                gmk_atomic_add(&conc_seen, 1, memory_order_relaxed);
+            }
+        }
+    }
+    uint32_t v;
+    while (gmk_ring_spmc_pop(&conc_ring, &v) == 0) {
+        *sum += v;
+        gmk_atomic_add(&conc_seen, 1, memory_order_relaxed);
+    }
+    gmk_atomic_store(&conc_done, true, memory_order_release);
+    return NULL;
+}
+
+static void *thief_fn(void *arg) {
+    uint64_t *sum = (uint64_t *)arg;
+    gmk_ring_spmc_t mine;
+    gmk_ring_spmc_init(&mine, 256, sizeof(uint32_t));
+
+    while (!gmk_atomic_load(&conc_done, memory_order_acquire) ||
+           !gmk_ring_spmc_empty(&conc_ring)) {
+        gmk_ring_spmc_steal(&mine, &conc_ring, 256);
+        uint32_t v;
+        while (gmk_ring_spmc_pop(&mine, &v) == 0) {
+            *sum += v;
+            gmk_atomic_add(&conc_seen, 1, memory_order_relaxed);
+        }
+    }
+
+    gmk_ring_spmc_destroy(&mine);
+    return NULL;
+}
+
+static void test_concurrent_steal(void) {
+    GMK_ASSERT_EQ(gmk_ring_spmc_init(&conc_ring, 1024, sizeof(uint32_t)),
+                  0, "init concurrent");
+    atomic_init(&conc_done, false);
+    atomic_init(&conc_seen, 0);
+
+    pthread_t owner, thieves[CONC_THIEVES];
+    uint64_t sums[CONC_THIEVES + 1] = {0};
+    pthread_create(&owner, NULL, owner_fn, &sums[0]);
+    for (int i = 0; i < CONC_THIEVES; i++)
+        pthread_create(&thieves[i], NULL, thief_fn, &sums[i + 1]);
+    pthread_join(owner, NULL);
+    for (int i = 0; i < CONC_THIEVES; i++)
+        pthread_join(thieves[i], NULL);
+
+    uint64_t sum = 0;
+    for (int i = 0; i <= CONC_THIEVES; i++)
+        sum += sums[i];
+
+    uint64_t expected = (uint64_t)(CONC_COUNT - 1) * CONC_COUNT / 2;
+    GMK_ASSERT_EQ(gmk_atomic_load(&conc_seen, memory_order_relaxed),
+                  CONC_COUNT, "every element consumed exactly once");
+    GMK_ASSERT_EQ(sum, expected, "concurrent sum correct");
+    GMK_ASSERT(gmk_ring_spmc_empty(&conc_ring), "ring empty after concurrent");
+
+    gmk_ring_spmc_destroy(&conc_ring);
+}
+
+int main(void) {
+    GMK_TEST_BEGIN("ring_spmc");
+    GMK_RUN_TEST(test_basic_push_pop);
+    GMK_RUN_TEST(test_full);
+    GMK_RUN_TEST(test_pop_n);
+    GMK_RUN_TEST(test_steal_half);
+    GMK_RUN_TEST(test_wraparound);
+    GMK_RUN_TEST(test_concurrent_steal);
+    GMK_TEST_END();
+    return 0;
+}
@@ -83,6 +83,40 @@ static void test_large_elements(void) {
     gmk_ring_spsc_destroy(&r);
 }
 
+static void test_reserve_commit(void) {
+    gmk_ring_spsc_t r;
+    GMK_ASSERT_EQ(gmk_ring_spsc_init(&r, 4, sizeof(uint32_t)), 0, "init");
+
+    uint32_t *slot = (uint32_t *)gmk_ring_spsc_reserve(&r);
+    GMK_ASSERT(slot != NULL, "reserve on empty ring");
+    *slot = 7;
+    GMK_ASSERT(gmk_ring_spsc_empty(&r), "reserved slot not visible before commit");
+    gmk_ring_spsc_commit(&r);
+    GMK_ASSERT_EQ(gmk_ring_spsc_count(&r), 1, "visible after commit");
+
+    const uint32_t *head = (const uint32_t *)gmk_ring_spsc_peek(&r);
+    GMK_ASSERT(head != NULL, "peek");
+    GMK_ASSERT_EQ(*head, 7, "peek reads in place");
+    GMK_ASSERT_EQ(gmk_ring_spsc_count(&r), 1, "peek does not consume");
+    gmk_ring_spsc_release(&r);
+    GMK_ASSERT(gmk_ring_spsc_peek(&r) == NULL, "peek on empty");
+
+    /* reserve fails when full; mixes with copy push/pop across the wrap */
+    for (uint32_t i = 0; i < 4; i++) {
+        slot = (uint32_t *)gmk_ring_spsc_reserve(&r);
+        *slot = i;
+        gmk_ring_spsc_commit(&r);
+    }
+    GMK_ASSERT(gmk_ring_spsc_reserve(&r) == NULL, "reserve on full");
+    uint32_t out;
+    for (uint32_t i = 0; i < 4; i++) {
+        GMK_ASSERT_EQ(gmk_ring_spsc_pop(&r, &out), 0, "pop");
+        GMK_ASSERT_EQ(out, i, "FIFO across reserve/pop");
+    }
+
+    gmk_ring_spsc_destroy(&r);
+}
+
 /* ── Concurrent test ─────────────────────────────────────────── */
 #define CONC_COUNT 100000
 static gmk_ring_spsc_t conc_ring;
@@ -136,6 +170,7 @@ int main(void) {
     GMK_RUN_TEST(test_full_and_empty);
     GMK_RUN_TEST(test_wraparound);
     GMK_RUN_TEST(test_large_elements);
+    GMK_RUN_TEST(test_reserve_commit);
     GMK_RUN_TEST(test_concurrent);
     GMK_TEST_END();
     return 0;
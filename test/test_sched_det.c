@@ -0,0 +1,341 @@
+/*
+ * GGMK/cpu — Deterministic lane tests
+ */
+#include "ggmk/ggmk.h"
+#include "test_util.h"
+#include <string.h>
+#include <unistd.h>
+
+static gmk_task_t make_det_task(uint32_t type, uint32_t prio, uint64_t id) {
+    gmk_task_t t;
+    memset(&t, 0, sizeof(t));
+    t.type  = type;
+    t.flags = GMK_SET_PRIORITY(GMK_TF_DETERMINISTIC, prio);
+    t.meta0 = id;
+    return t;
+}
+
+/* One batch per tick: grouped by type, (priority, arrival) within a type,
+ * seq stamped in that order */
+static void test_canonical_batch(void) {
+    static const uint32_t spec[][2] = {   /* type, priority */
+        { 7, 2 }, { 3, 1 }, { 7, 0 }, { 3, 1 }, { 5, 3 }, { 3, 0 },
+    };
+    gmk_det_t d;
+    GMK_ASSERT_EQ(gmk_det_init(&d, 64, 2), 0, "init");
+
+    for (uint32_t i = 0; i < 6; i++) {
+        gmk_task_t t = make_det_task(spec[i][0], spec[i][1], i);
+        GMK_ASSERT_EQ(gmk_det_push(&d, &t), 0, "push");
+    }
+
+    gmk_det_group_t g;
+    uint64_t tick = 0;
+    GMK_ASSERT(!gmk_det_ready(&d), "released at the next tick, not this one");
+    GMK_ASSERT_EQ(gmk_det_claim(&d, &g, &tick), -1, "nothing at tick 0");
+
+    gmk_det_advance(&d, 1);
+    GMK_ASSERT(gmk_det_ready(&d), "ready at tick 1");
+
+    static const uint32_t want_type[] = { 3, 5, 7 };
+    static const uint32_t want_len[]  = { 3, 1, 2 };
+    static const uint64_t want_id[]   = { 5, 1, 3, 4, 2, 0 };
+    uint32_t seen = 0;
+    for (uint32_t k = 0; k < 3; k++) {
+        GMK_ASSERT_EQ(gmk_det_claim(&d, &g, &tick), 0, "claim group");
+        GMK_ASSERT_EQ(tick, 1, "batch tick");
+        GMK_ASSERT_EQ(g.len, want_len[k], "group size");
+        for (uint32_t i = g.start; i < g.start + g.len; i++, seen++) {
+            GMK_ASSERT_EQ(d.batch[i].task.type, want_type[k], "one type per group");
+            GMK_ASSERT_EQ(d.batch[i].task.meta0, want_id[seen], "canonical order");
+            GMK_ASSERT_EQ(d.batch[i].task.seq, seen, "seq stamped in order");
+        }
+    }
+    GMK_ASSERT_EQ(gmk_det_claim(&d, &g, &tick), -1, "all groups claimed");
+    GMK_ASSERT_EQ(gmk_det_count(&d), 6, "batch still open");
+
+    for (uint32_t k = 0; k < 3; k++)
+        gmk_det_done(&d);
+    GMK_ASSERT_EQ(gmk_det_count(&d), 0, "drained");
+    GMK_ASSERT(!gmk_det_ready(&d), "idle");
+    gmk_det_destroy(&d);
+}
+
+/* The next batch opens only after every group of the current one is done */
+static void test_tick_barrier(void) {
+    gmk_det_t d;
+    gmk_det_init(&d, 64, 2);
+
+    gmk_task_t a = make_det_task(1, GMK_PRIO_NORMAL, 100);
+    gmk_task_t b = make_det_task(2, GMK_PRIO_NORMAL, 200);
+    gmk_det_push(&d, &a);
+    gmk_det_advance(&d, 1);
+
+    gmk_det_group_t g;
+    uint64_t tick = 0;
+    GMK_ASSERT_EQ(gmk_det_claim(&d, &g, &tick), 0, "open tick 1");
+
+    /* Pushed during tick 1, released at 2; the tick races ahead */
+    gmk_det_push(&d, &b);
+    gmk_det_advance(&d, 5);
+    GMK_ASSERT(!gmk_det_ready(&d), "not ready while tick 1 runs");
+    GMK_ASSERT_EQ(gmk_det_claim(&d, &g, &tick), -1, "barrier holds");
+
+    gmk_det_done(&d);
+    GMK_ASSERT(gmk_det_ready(&d), "ready once tick 1 is done");
+    GMK_ASSERT_EQ(gmk_det_claim(&d, &g, &tick), 0, "open the next batch");
+    GMK_ASSERT_EQ(tick, 2, "release tick, not the current tick");
+    GMK_ASSERT_EQ(d.batch[g.start].task.meta0, 200, "task b");
+    gmk_det_done(&d);
+    gmk_det_destroy(&d);
+}
+
+/* Emissions follow the emitter's batch index, not the order they ran in,
+ * and come before host pushes of the same release tick */
+static void test_emission_order(void) {
+    gmk_det_t d;
+    gmk_det_init(&d, 64, 2);
+
+    for (uint32_t i = 0; i < 3; i++) {
+        gmk_task_t t = make_det_task(4, GMK_PRIO_NORMAL, i);
+        gmk_det_push(&d, &t);
+    }
+    gmk_det_advance(&d, 1);
+
+    gmk_det_group_t g;
+    uint64_t tick = 0;
+    GMK_ASSERT_EQ(gmk_det_claim(&d, &g, &tick), 0, "open tick 1");
+    GMK_ASSERT_EQ(g.len, 3, "one group");
+
+    gmk_hal_self_set(1);
+    gmk_task_t host = make_det_task(4, GMK_PRIO_NORMAL, 99);
+    gmk_det_push(&d, &host);     /* not inside a dispatch: a host push */
+
+    gmk_det_begin(&d, 1, g.start + 2);
+    gmk_task_t c20 = make_det_task(4, GMK_PRIO_NORMAL, 20);
+    gmk_task_t c21 = make_det_task(4, GMK_PRIO_NORMAL, 21);
+    gmk_det_push(&d, &c20);
+    gmk_det_push(&d, &c21);
+    gmk_det_end(&d, 1);
+
+    gmk_det_begin(&d, 1, g.start);
+    gmk_task_t c00 = make_det_task(4, GMK_PRIO_NORMAL, 0);
+    gmk_det_push(&d, &c00);
+    gmk_det_end(&d, 1);
+    gmk_hal_self_set(UINT32_MAX);
+
+    gmk_det_done(&d);
+    gmk_det_advance(&d, 2);
+    GMK_ASSERT_EQ(gmk_det_claim(&d, &g, &tick), 0, "open tick 2");
+    GMK_ASSERT_EQ(tick, 2, "emissions released at the next tick");
+    GMK_ASSERT_EQ(g.len, 4, "three emissions and the host push");
+
+    static const uint64_t want[] = { 0, 20, 21, 99 };
+    for (uint32_t i = 0; i < 4; i++)
+        GMK_ASSERT_EQ(d.batch[g.start + i].task.meta0, want[i], "emitter order");
+    gmk_det_done(&d);
+    gmk_det_destroy(&d);
+}
+
+static void test_capacity(void) {
+    gmk_det_t d;
+    gmk_det_init(&d, 4, 1);
+    gmk_task_t t = make_det_task(1, GMK_PRIO_NORMAL, 0);
+    for (uint32_t i = 0; i < 4; i++)
+        GMK_ASSERT_EQ(gmk_det_push(&d, &t), 0, "push");
+    GMK_ASSERT_EQ(gmk_det_push(&d, &t), -1, "full");
+    GMK_ASSERT_EQ(gmk_det_count(&d), 4, "count");
+    gmk_det_destroy(&d);
+}
+
+/* The enqueue paths divert the flag into the lane and nowhere else */
+static void test_enqueue_routes(void) {
+    gmk_sched_t s;
+    GMK_ASSERT_EQ(gmk_sched_init(&s, 2), 0, "sched init");
+
+    gmk_task_t t = make_det_task(1, GMK_PRIO_NORMAL, 0);
+    GMK_ASSERT_EQ(_gmk_enqueue(&s, &t, -1), 0, "enqueue");
+    GMK_ASSERT_EQ(_gmk_enqueue_local(&s, &t, 0), 0, "enqueue_local");
+    GMK_ASSERT_EQ(gmk_rq_count(&s.rq), 0, "not in the RQ");
+    GMK_ASSERT_EQ(gmk_lq_count(&s.lqs[0]), 0, "not in an LQ");
+
+    gmk_task_t mixed[3] = {
+        make_det_task(2, GMK_PRIO_NORMAL, 0),
+        make_det_task(2, GMK_PRIO_NORMAL, 1),
+        make_det_task(2, GMK_PRIO_NORMAL, 2),
+    };
+    mixed[0].flags &= (uint16_t)~GMK_TF_DETERMINISTIC;
+    mixed[2].flags &= (uint16_t)~GMK_TF_DETERMINISTIC;
+    GMK_ASSERT_EQ(_gmk_enqueue_n(&s, mixed, 3, 1), 3, "mixed enqueue_n");
+    GMK_ASSERT_EQ(gmk_lq_count(&s.lqs[1]), 2, "plain tasks to the inbox");
+    GMK_ASSERT_EQ(gmk_det_count(&s.det), 3, "deterministic ones to the lane");
+
+    gmk_sched_destroy(&s);
+}
+
+/* ── Replay: a small simulation, byte-identical across runs ──────── */
+/* SIM_TYPES independent types, each with its own state and output log.
+ * Every task mixes its inputs into its type's state, logs a record and,
+ * until SIM_TICKS, emits one or two children of any type for the next
+ * tick. A non-deterministic noise task rides along to share the workers. */
+#define SIM_TYPE     20
+#define SIM_TYPES    4
+#define SIM_NOISE    30
+#define SIM_TICKS    24
+#define SIM_SEEDS    16
+#define SIM_LOG_MAX  16384
+
+typedef struct {
+    uint64_t tick;
+    uint64_t meta0;
+    uint64_t state;
+    uint32_t seq;
+    uint32_t prio;
+} sim_rec_t;
+
+static uint64_t  sim_state[SIM_TYPES];
+static sim_rec_t sim_log[SIM_TYPES][SIM_LOG_MAX];
+static uint32_t  sim_len[SIM_TYPES];
+static sim_rec_t sim_ref[SIM_TYPES][SIM_LOG_MAX];
+static uint32_t  sim_ref_len[SIM_TYPES];
+static _Atomic(int) sim_noise;
+
+static int sim_handler(gmk_ctx_t *ctx) {
+    gmk_task_t *t = ctx->task;
+    uint32_t k = t->type - SIM_TYPE;
+    uint64_t x = sim_state[k] ^ t->meta0 ^ (ctx->tick << 32) ^ t->seq;
+    x = x * 6364136223846793005ull + 1442695040888963407ull;
+    sim_state[k] = x;
+
+    if (sim_len[k] < SIM_LOG_MAX)
+        sim_log[k][sim_len[k]++] = (sim_rec_t){
+            ctx->tick, t->meta0, x, t->seq, GMK_PRIORITY(t->flags),
+        };
+
+    if (ctx->tick < SIM_TICKS) {
+        uint32_t kids = (x >> 61) == 0 ? 2 : 1;
+        for (uint32_t i = 0; i < kids; i++) {
+            uint64_t y = x + i * 0x9E3779B97F4A7C15ull;
+            gmk_task_t c = make_det_task(SIM_TYPE + (uint32_t)((y >> 40) % SIM_TYPES),
+                                         (uint32_t)(y >> 50) & 3, y);
+            gmk_submit(ctx->kernel, &c);
+        }
+        if ((x & 7) == 0) {
+            gmk_task_t n = make_det_task(SIM_NOISE, GMK_PRIO_NORMAL, 0);
+            n.flags &= (uint16_t)~GMK_TF_DETERMINISTIC;
+            gmk_submit(ctx->kernel, &n);
+        }
+    }
+    return GMK_OK;
+}
+
+static int noise_handler(gmk_ctx_t *ctx) {
+    (void)ctx;
+    gmk_atomic_add(&sim_noise, 1, memory_order_relaxed);
+    return GMK_OK;
+}
+
+/* One run: seed from the host, drive the tick, wait for the lane to drain.
+ * step_ticks advances one tick at a time instead of jumping to the end. */
+static void sim_run(uint32_t workers, bool step_ticks) {
+    memset(sim_state, 0, sizeof(sim_state));
+    memset(sim_len, 0, sizeof(sim_len));
+    atomic_init(&sim_noise, 0);
+
+    gmk_handler_reg_t handlers[SIM_TYPES + 1];
+    for (uint32_t i = 0; i < SIM_TYPES; i++)
+        handlers[i] = (gmk_handler_reg_t){
+            .type = SIM_TYPE + i, .fn = sim_handler, .name = "sim",
+            .flags = GMK_HF_DETERMINISTIC,
+        };
+    handlers[SIM_TYPES] = (gmk_handler_reg_t){
+        .type = SIM_NOISE, .fn = noise_handler, .name = "noise",
+    };
+    gmk_module_t mod = {
+        .name = "sim", .handlers = handlers, .n_handlers = SIM_TYPES + 1,
+    };
+    gmk_module_t *mods[] = { &mod };
+
+    gmk_kernel_t kernel;
+    gmk_boot_cfg_t cfg = {
+        .arena_size = 8 * 1024 * 1024,
+        .n_workers  = workers,
+        .n_tenants  = 1,
+    };
+    GMK_ASSERT_EQ(gmk_boot(&kernel, &cfg, mods, 1), 0, "boot");
+
+    uint64_t x = 88172645463325252ull;
+    for (uint32_t i = 0; i < SIM_SEEDS; i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        gmk_task_t t = make_det_task(SIM_TYPE + (uint32_t)(x % SIM_TYPES),
+                                     (uint32_t)(x >> 8) & 3, x);
+        GMK_ASSERT_EQ(gmk_submit(&kernel, &t), 0, "seed");
+    }
+
+    if (step_ticks) {
+        for (uint32_t i = 0; i < SIM_TICKS + 2; i++) {
+            gmk_tick_advance(&kernel);
+            usleep(500);
+        }
+    } else {
+        gmk_tick_advance_to(&kernel, SIM_TICKS + 2);
+    }
+
+    for (int wait = 0; wait < 2000 && gmk_det_count(&kernel.sched.det) > 0; wait++)
+        usleep(1000);
+    GMK_ASSERT_EQ(gmk_det_count(&kernel.sched.det), 0, "lane drained");
+    gmk_halt(&kernel);
+}
+
+static bool sim_same_as_ref(void) {
+    for (uint32_t k = 0; k < SIM_TYPES; k++) {
+        if (sim_len[k] != sim_ref_len[k]) return false;
+        if (memcmp(sim_log[k], sim_ref[k], sim_len[k] * sizeof(sim_rec_t)) != 0)
+            return false;
+    }
+    return true;
+}
+
+static void test_replay(void) {
+    sim_run(1, false);
+    uint32_t total = 0;
+    for (uint32_t k = 0; k < SIM_TYPES; k++) {
+        GMK_ASSERT(sim_len[k] < SIM_LOG_MAX, "log fits");
+        total += sim_len[k];
+        /* Within a type: ticks in order, seq rising */
+        for (uint32_t i = 1; i < sim_len[k]; i++) {
+            const sim_rec_t *a = &sim_log[k][i - 1], *b = &sim_log[k][i];
+            GMK_ASSERT(a->tick < b->tick ||
+                       (a->tick == b->tick && a->prio <= b->prio && a->seq < b->seq),
+                       "canonical order within a type");
+        }
+        GMK_ASSERT_EQ(sim_log[k][sim_len[k] - 1].tick, SIM_TICKS, "ran to the end");
+    }
+    GMK_ASSERT(total > SIM_SEEDS * SIM_TICKS, "population survived");
+    GMK_ASSERT(gmk_atomic_load(&sim_noise, memory_order_relaxed) > 0,
+               "noise ran alongside");
+    memcpy(sim_ref, sim_log, sizeof(sim_ref));
+    memcpy(sim_ref_len, sim_len, sizeof(sim_ref_len));
+
+    static const struct { uint32_t workers; bool step; } runs[] = {
+        { 1, false }, { 2, true }, { 4, false }, { 4, true },
+    };
+    for (uint32_t r = 0; r < sizeof(runs) / sizeof(runs[0]); r++) {
+        sim_run(runs[r].workers, runs[r].step);
+        GMK_ASSERT(sim_same_as_ref(), "byte-identical replay");
+    }
+}
+
+int main(void) {
+    GMK_TEST_BEGIN("sched_det");
+    GMK_RUN_TEST(test_canonical_batch);
+    GMK_RUN_TEST(test_tick_barrier);
+    GMK_RUN_TEST(test_emission_order);
+    GMK_RUN_TEST(test_capacity);
+    GMK_RUN_TEST(test_enqueue_routes);
+    GMK_RUN_TEST(test_replay);
+    GMK_TEST_END();
+    return 0;
+}
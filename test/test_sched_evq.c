@@ -1,11 +1,11 @@
 /*
- * GGMK/cpu — Event Queue tests
+ * GGMK/cpu — Event Queue (timing wheel) tests
  */
 #include "ggmk/sched.h"
 #include "test_util.h"
 #include <string.h>
 
-static gmk_task_t make_evq_task(uint32_t type, uint32_t tick, uint32_t prio) {
+static gmk_task_t make_evq_task(uint32_t type, uint64_t tick, uint32_t prio) {
     gmk_task_t t;
     memset(&t, 0, sizeof(t));
     t.type  = type;
@@ -105,12 +105,247 @@ static void test_capacity(void) {
     gmk_evq_destroy(&evq);
 }
 
+/* Ticks on every wheel level, pushed out of order, pop in tick order */
+static void test_far_ticks(void) {
+    static const uint32_t ticks[] = {
+        0xFFFFFFF0u, 70000, 3, 300, 20000000, 65536, 256, 255, 1u << 24,
+    };
+    static const uint32_t sorted[] = {
+        3, 255, 256, 300, 65536, 70000, 1u << 24, 20000000, 0xFFFFFFF0u,
+    };
+    const uint32_t n = sizeof(ticks) / sizeof(ticks[0]);
+    gmk_evq_t evq;
+    gmk_evq_init(&evq, n);
+
+    for (uint32_t i = 0; i < n; i++) {
+        gmk_task_t t = make_evq_task(ticks[i], ticks[i], GMK_PRIO_NORMAL);
+        GMK_ASSERT_EQ(gmk_evq_push(&evq, &t), 0, "push");
+    }
+
+    gmk_task_t out;
+    GMK_ASSERT_EQ(gmk_evq_pop_due(&evq, 2, &out), -1, "nothing due at 2");
+    for (uint32_t i = 0; i < n; i++) {
+        /* Exactly at the deadline, not a tick before */
+        if (sorted[i] > 3)
+            GMK_ASSERT_EQ(gmk_evq_pop_due(&evq, sorted[i] - 1, &out), -1,
+                          "not due early");
+        GMK_ASSERT_EQ(gmk_evq_pop_due(&evq, sorted[i], &out), 0, "due");
+        GMK_ASSERT_EQ(out.type, sorted[i], "tick order across levels");
+    }
+    GMK_ASSERT_EQ(gmk_evq_count(&evq), 0, "drained");
+    gmk_evq_destroy(&evq);
+}
+
+/* Ticks are 64-bit: deadlines past 2^32 neither wrap nor alias */
+static void test_ticks_past_32bit(void) {
+    static const uint64_t ticks[] = {
+        1ull << 62, 0x100000001ull, 0xFFFFFFFFull, 1ull << 40, 0x100000000ull,
+    };
+    gmk_evq_t evq;
+    gmk_evq_init(&evq, 8);
+
+    for (uint32_t i = 0; i < 5; i++) {
+        gmk_task_t t = make_evq_task(i, ticks[i], GMK_PRIO_NORMAL);
+        GMK_ASSERT_EQ(gmk_evq_push(&evq, &t), 0, "push");
+    }
+    gmk_task_t t = make_evq_task(9, 5, GMK_PRIO_NORMAL);
+    gmk_evq_push(&evq, &t);
+
+    gmk_task_t out[8];
+    GMK_ASSERT_EQ(gmk_evq_pop_due_n(&evq, 0xFFFFFFFEull, out, 8), 1,
+                  "only the low tick is due");
+    GMK_ASSERT_EQ(out[0].type, 9, "tick 5");
+    GMK_ASSERT_EQ(gmk_evq_pop_due_n(&evq, 0x100000000ull, out, 8), 2,
+                  "both sides of 2^32");
+    GMK_ASSERT_EQ(out[0].type, 2, "0xFFFFFFFF first");
+    GMK_ASSERT_EQ(out[1].type, 4, "then 2^32");
+    GMK_ASSERT(gmk_evq_next_due(&evq) == 0x100000001ull, "next_due is 64-bit");
+
+    GMK_ASSERT_EQ(gmk_evq_pop_due_n(&evq, (1ull << 40) - 1, out, 8), 1,
+                  "2^32 + 1");
+    GMK_ASSERT_EQ(out[0].type, 1, "2^32 + 1 type");
+    GMK_ASSERT_EQ(gmk_evq_pop_due_n(&evq, UINT64_MAX, out, 8), 2, "rest");
+    GMK_ASSERT_EQ(out[0].type, 3, "2^40");
+    GMK_ASSERT_EQ(out[1].type, 0, "2^62");
+    GMK_ASSERT_EQ(gmk_evq_count(&evq), 0, "drained");
+    gmk_evq_destroy(&evq);
+}
+
+/* Same tick and priority: push order survives cascades from level 2 */
+static void test_fifo_across_cascade(void) {
+    gmk_evq_t evq;
+    gmk_evq_init(&evq, 64);
+
+    gmk_task_t out;
+    for (uint32_t i = 0; i < 4; i++) {
+        gmk_task_t t = make_evq_task(i, 100000, GMK_PRIO_NORMAL);
+        gmk_evq_push(&evq, &t);
+    }
+    /* Move close enough that new pushes land on level 0 directly */
+    GMK_ASSERT_EQ(gmk_evq_pop_due(&evq, 99990, &out), -1, "not due");
+    for (uint32_t i = 4; i < 8; i++) {
+        gmk_task_t t = make_evq_task(i, 100000, GMK_PRIO_NORMAL);
+        gmk_evq_push(&evq, &t);
+    }
+
+    for (uint32_t i = 0; i < 8; i++) {
+        GMK_ASSERT_EQ(gmk_evq_pop_due(&evq, 100000, &out), 0, "pop");
+        GMK_ASSERT_EQ(out.type, i, "FIFO");
+    }
+    gmk_evq_destroy(&evq);
+}
+
+static void test_cancel(void) {
+    gmk_evq_t evq;
+    gmk_evq_init(&evq, 4);
+
+    gmk_evq_handle_t h[3];
+    for (uint32_t i = 0; i < 3; i++) {
+        gmk_task_t t = make_evq_task(i, 10 + i * 1000, GMK_PRIO_NORMAL);
+        GMK_ASSERT_EQ(gmk_evq_arm(&evq, &t, &h[i]), 0, "arm");
+    }
+
+    GMK_ASSERT_EQ(gmk_evq_cancel(&evq, h[1]), 0, "cancel pending");
+    GMK_ASSERT_EQ(gmk_evq_cancel(&evq, h[1]), -1, "cancel twice");
+    GMK_ASSERT_EQ(gmk_evq_count(&evq), 2, "count after cancel");
+
+    gmk_task_t out;
+    GMK_ASSERT_EQ(gmk_evq_pop_due(&evq, 5000, &out), 0, "pop 1");
+    GMK_ASSERT_EQ(out.type, 0, "first survivor");
+    GMK_ASSERT_EQ(gmk_evq_cancel(&evq, h[0]), -1, "cancel after fire");
+
+    /* The freed node is reused; the old handle must not reach it */
+    gmk_task_t t = make_evq_task(9, 6000, GMK_PRIO_NORMAL);
+    gmk_evq_handle_t h9;
+    GMK_ASSERT_EQ(gmk_evq_arm(&evq, &t, &h9), 0, "re-arm");
+    GMK_ASSERT_EQ(gmk_evq_cancel(&evq, h[0]), -1, "stale handle");
+    GMK_ASSERT_EQ(gmk_evq_cancel(&evq, 0), -1, "null handle");
+
+    /* Cancel a staged timer (its tick is already due) */
+    GMK_ASSERT_EQ(gmk_evq_pop_due_n(&evq, 0, &out, 1), 0, "nothing due at 0");
+    GMK_ASSERT_EQ(gmk_evq_pop_due(&evq, 6000, &out), 0, "pop 2");
+    GMK_ASSERT_EQ(out.type, 2, "tick 2010");
+    GMK_ASSERT_EQ(gmk_evq_cancel(&evq, h9), 0, "cancel last");
+    GMK_ASSERT_EQ(gmk_evq_count(&evq), 0, "empty");
+    GMK_ASSERT_EQ(gmk_evq_pop_due(&evq, 10000, &out), -1, "nothing left");
+
+    gmk_evq_destroy(&evq);
+}
+
+/* The lock-free peek tracks arms, pops and cancels */
+static void test_next_due(void) {
+    gmk_evq_t evq;
+    gmk_evq_init(&evq, 8);
+    GMK_ASSERT(gmk_evq_next_due(&evq) == UINT64_MAX, "empty");
+
+    gmk_evq_handle_t h;
+    gmk_task_t t = make_evq_task(1, 40, GMK_PRIO_NORMAL);
+    gmk_evq_arm(&evq, &t, &h);
+    t = make_evq_task(2, 1000, GMK_PRIO_NORMAL);
+    gmk_evq_push(&evq, &t);
+    GMK_ASSERT_EQ(gmk_evq_next_due(&evq), 40, "earliest armed");
+
+    t = make_evq_task(3, 7, GMK_PRIO_NORMAL);
+    gmk_evq_push(&evq, &t);
+    GMK_ASSERT_EQ(gmk_evq_next_due(&evq), 7, "earlier arm lowers it");
+
+    gmk_task_t out;
+    GMK_ASSERT_EQ(gmk_evq_pop_due(&evq, 10, &out), 0, "pop tick 7");
+    GMK_ASSERT_EQ(gmk_evq_next_due(&evq), 40, "next after pop");
+
+    GMK_ASSERT_EQ(gmk_evq_cancel(&evq, h), 0, "cancel tick 40");
+    uint64_t due = gmk_evq_next_due(&evq);
+    GMK_ASSERT(due > 40 && due <= 1000, "lower bound for the level-1 timer");
+    GMK_ASSERT_EQ(gmk_evq_pop_due(&evq, due - 1, &out), -1, "nothing before it");
+
+    GMK_ASSERT_EQ(gmk_evq_pop_due(&evq, 1000, &out), 0, "pop tick 1000");
+    GMK_ASSERT(gmk_evq_next_due(&evq) == UINT64_MAX, "empty again");
+    gmk_evq_destroy(&evq);
+}
+
+/* Random arms, cancels and batch pops against a linear-scan model of the
+ * (tick, priority, seq) order */
+#define MODEL_N 2048
+
+typedef struct {
+    gmk_evq_handle_t h;
+    uint32_t         tick, prio, id;
+    bool             live;
+} model_t;
+
+static inline uint32_t xorshift(uint32_t *x) {
+    *x ^= *x << 13;
+    *x ^= *x >> 17;
+    *x ^= *x << 5;
+    return *x;
+}
+
+static void test_random_model(void) {
+    static model_t m[MODEL_N];
+    gmk_evq_t evq;
+    GMK_ASSERT_EQ(gmk_evq_init(&evq, MODEL_N), 0, "init");
+
+    uint32_t x = 88172645u, armed = 0, live = 0, now = 0, bad = 0;
+    gmk_task_t out[16];
+
+    while (armed < MODEL_N || live > 0) {
+        uint32_t r = xorshift(&x) % 8;
+        if (r < 4 && armed < MODEL_N) {
+            /* Future deadlines, mostly near, some far */
+            uint32_t span = (r == 0) ? 1u << 20 : 512;
+            model_t *e = &m[armed];
+            e->tick = now + 1 + xorshift(&x) % span;
+            e->prio = xorshift(&x) % GMK_PRIORITY_COUNT;
+            e->id   = armed;
+            e->live = true;
+            gmk_task_t t = make_evq_task(armed, e->tick, e->prio);
+            if (gmk_evq_arm(&evq, &t, &e->h) != 0) bad++;
+            armed++;
+            live++;
+        } else if (r == 4 && armed > 0) {
+            model_t *e = &m[xorshift(&x) % armed];
+            int want = e->live ? 0 : -1;
+            if (gmk_evq_cancel(&evq, e->h) != want) bad++;
+            if (e->live) { e->live = false; live--; }
+        } else {
+            now += 1 + xorshift(&x) % (live < 64 ? 4096 : 64);
+            uint32_t got = gmk_evq_pop_due_n(&evq, now, out, 16);
+            for (uint32_t k = 0; k < got; k++) {
+                /* Expected: the live entry with the smallest key */
+                model_t *best = NULL;
+                for (uint32_t i = 0; i < armed; i++) {
+                    model_t *e = &m[i];
+                    if (!e->live || e->tick > now) continue;
+                    if (!best || e->tick < best->tick ||
+                        (e->tick == best->tick && e->prio < best->prio))
+                        best = e;
+                }
+                if (!best || best->id != out[k].type) { bad++; break; }
+                best->live = false;
+                live--;
+            }
+        }
+        if (gmk_evq_count(&evq) != live) bad++;
+        if (bad) break;
+    }
+
+    GMK_ASSERT_EQ(bad, 0, "wheel matches model");
+    GMK_ASSERT_EQ(gmk_evq_count(&evq), 0, "drained");
+    gmk_evq_destroy(&evq);
+}
+
 int main(void) {
     GMK_TEST_BEGIN("sched_evq");
     GMK_RUN_TEST(test_basic);
     GMK_RUN_TEST(test_ordering);
     GMK_RUN_TEST(test_priority_within_tick);
     GMK_RUN_TEST(test_capacity);
+    GMK_RUN_TEST(test_far_ticks);
+    GMK_RUN_TEST(test_ticks_past_32bit);
+    GMK_RUN_TEST(test_fifo_across_cascade);
+    GMK_RUN_TEST(test_cancel);
+    GMK_RUN_TEST(test_next_due);
+    GMK_RUN_TEST(test_random_model);
     GMK_TEST_END();
     return 0;
 }
@@ -4,6 +4,7 @@
 #include "ggmk/sched.h"
 #include "test_util.h"
 #include <string.h>
+#include <pthread.h>
 
 static gmk_task_t make_task(uint32_t type) {
     gmk_task_t t;
@@ -78,11 +79,164 @@ static void test_fifo_order(void) {
     gmk_lq_destroy(&lq);
 }
 
+static void test_steal(void) {
+    gmk_lq_t victim, thief;
+    gmk_lq_init(&victim, 16);
+    gmk_lq_init(&thief, 16);
+
+    for (uint32_t i = 0; i < 10; i++) {
+        gmk_task_t t = make_task(i);
+        gmk_lq_push(&victim, &t);
+    }
+
+    GMK_ASSERT_EQ(gmk_lq_steal(&thief, &victim), 5, "steal half");
+    GMK_ASSERT_EQ(gmk_lq_count(&victim), 5, "victim keeps half");
+
+    gmk_task_t out;
+    GMK_ASSERT_EQ(gmk_lq_pop(&thief, &out), 0, "thief pop");
+    GMK_ASSERT_EQ(out.type, 0, "thief takes oldest");
+    GMK_ASSERT_EQ(gmk_lq_pop(&victim, &out), 0, "victim pop");
+    GMK_ASSERT_EQ(out.type, 5, "victim keeps newest");
+
+    /* Thief at its watermark steals nothing */
+    for (uint32_t i = 0; i < 16; i++) {
+        gmk_task_t t = make_task(100);
+        if (gmk_lq_push(&thief, &t) != 0) break;
+    }
+    GMK_ASSERT_EQ(gmk_lq_steal(&thief, &victim), 0, "full thief skips steal");
+    GMK_ASSERT_EQ(gmk_lq_steal(&thief, &thief), 0, "no self-steal");
+
+    gmk_lq_destroy(&victim);
+    gmk_lq_destroy(&thief);
+}
+
+static void test_remote_inbox(void) {
+    gmk_lq_t lq;
+    gmk_lq_init(&lq, 16);
+
+    /* Remote tasks wait in the inbox until the owner pops */
+    for (uint32_t i = 0; i < 4; i++) {
+        gmk_task_t t = make_task(10 + i);
+        GMK_ASSERT_EQ(gmk_lq_push_remote(&lq, &t), 0, "remote push");
+    }
+    GMK_ASSERT_EQ(gmk_ring_spmc_count(&lq.ring), 0, "ring untouched");
+    GMK_ASSERT_EQ(gmk_lq_count(&lq), 4, "count includes inbox");
+
+    /* Local work first, then the spliced inbox in FIFO order */
+    gmk_task_t local = make_task(1);
+    gmk_lq_push(&lq, &local);
+
+    gmk_task_t out;
+    GMK_ASSERT_EQ(gmk_lq_pop(&lq, &out), 0, "pop local");
+    GMK_ASSERT_EQ(out.type, 1, "local first");
+    for (uint32_t i = 0; i < 4; i++) {
+        GMK_ASSERT_EQ(gmk_lq_pop(&lq, &out), 0, "pop spliced");
+        GMK_ASSERT_EQ(out.type, 10 + i, "inbox FIFO order");
+    }
+    GMK_ASSERT_EQ(gmk_lq_pop(&lq, &out), -1, "empty");
+
+    /* A thief takes half of an idle owner's inbox */
+    gmk_lq_t thief;
+    gmk_lq_init(&thief, 16);
+    for (uint32_t i = 0; i < 6; i++) {
+        gmk_task_t t = make_task(20 + i);
+        gmk_lq_push_remote(&lq, &t);
+    }
+    GMK_ASSERT_EQ(gmk_lq_steal(&thief, &lq), 3, "steal half of inbox");
+    GMK_ASSERT_EQ(gmk_lq_pop(&thief, &out), 0, "thief pop");
+    GMK_ASSERT_EQ(out.type, 20, "thief takes oldest inbox task");
+
+    gmk_lq_destroy(&thief);
+    gmk_lq_destroy(&lq);
+}
+
+static void test_pop_n(void) {
+    gmk_lq_t lq;
+    gmk_lq_init(&lq, 16);
+
+    for (uint32_t i = 0; i < 3; i++) {
+        gmk_task_t t = make_task(i);
+        gmk_lq_push(&lq, &t);
+    }
+    for (uint32_t i = 3; i < 6; i++) {
+        gmk_task_t t = make_task(i);
+        gmk_lq_push_remote(&lq, &t);
+    }
+
+    /* One bulk pop drains local work and the spliced inbox, in order */
+    gmk_task_t out[8];
+    GMK_ASSERT_EQ(gmk_lq_pop_n(&lq, out, 8), 6, "pop_n covers ring + inbox");
+    for (uint32_t i = 0; i < 6; i++)
+        GMK_ASSERT_EQ(out[i].type, i, "pop_n order");
+    GMK_ASSERT_EQ(gmk_lq_pop_n(&lq, out, 8), 0, "empty");
+
+    gmk_lq_destroy(&lq);
+}
+
+/* ── Concurrent remote producers, owner consumer ─────────────── */
+#define REMOTE_PRODUCERS 3
+#define REMOTE_COUNT     20000
+
+static gmk_lq_t remote_lq;
+
+static void *remote_producer_fn(void *arg) {
+    uint32_t base = (uint32_t)(uintptr_t)arg * REMOTE_COUNT;
+    for (uint32_t i = 0; i < REMOTE_COUNT; i++) {
+        gmk_task_t t = make_task(base + i);
+        while (gmk_lq_push_remote(&remote_lq, &t) != 0) {
+            /* spin */
+        }
+    }
+    return NULL;
+}
+
+static void test_concurrent_remote(void) {
+    GMK_ASSERT_EQ(gmk_lq_init(&remote_lq, 256), 0, "init");
+
+    pthread_t prod[REMOTE_PRODUCERS];
+    for (uintptr_t i = 0; i < REMOTE_PRODUCERS; i++)
+        pthread_create(&prod[i], NULL, remote_producer_fn, (void *)i);
+
+    /* Owner: interleave local pushes with pops, as a worker does */
+    uint64_t sum = 0;
+    uint32_t got = 0, local = 0;
+    uint32_t last[REMOTE_PRODUCERS] = {0};
+    bool ordered = true;
+    while (got < REMOTE_PRODUCERS * REMOTE_COUNT) {
+        gmk_task_t out;
+        if (gmk_lq_pop(&remote_lq, &out) != 0) continue;
+        if (out.type == UINT32_MAX) { local--; continue; }
+
+        uint32_t p = out.type / REMOTE_COUNT;
+        if (out.type % REMOTE_COUNT != last[p]) ordered = false;
+        last[p]++;
+        sum += out.type;
+        got++;
+
+        if (local < 4) {
+            gmk_task_t mine = make_task(UINT32_MAX);
+            if (gmk_lq_push(&remote_lq, &mine) == 0) local++;
+        }
+    }
+    for (int i = 0; i < REMOTE_PRODUCERS; i++)
+        pthread_join(prod[i], NULL);
+
+    uint64_t n = (uint64_t)REMOTE_PRODUCERS * REMOTE_COUNT;
+    GMK_ASSERT_EQ(sum, (n - 1) * n / 2, "every remote task seen once");
+    GMK_ASSERT(ordered, "per-producer FIFO preserved");
+
+    gmk_lq_destroy(&remote_lq);
+}
+
 int main(void) {
     GMK_TEST_BEGIN("sched_lq");
     GMK_RUN_TEST(test_basic);
     GMK_RUN_TEST(test_yield_watermark);
     GMK_RUN_TEST(test_fifo_order);
+    GMK_RUN_TEST(test_steal);
+    GMK_RUN_TEST(test_remote_inbox);
+    GMK_RUN_TEST(test_pop_n);
+    GMK_RUN_TEST(test_concurrent_remote);
     GMK_TEST_END();
     return 0;
 }
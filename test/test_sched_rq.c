@@ -98,12 +98,57 @@ static void test_empty_pop(void) {
     gmk_rq_destroy(&rq);
 }
 
+static void test_bulk_push_pop(void) {
+    gmk_rq_t rq;
+    gmk_rq_init(&rq, 64);
+
+    /* Mixed priorities: runs of P2, P0, P3 */
+    gmk_task_t in[12];
+    for (int i = 0; i < 12; i++) {
+        uint32_t prio = i < 4 ? GMK_PRIO_NORMAL
+                      : i < 8 ? GMK_PRIO_CRITICAL : GMK_PRIO_LOW;
+        in[i] = make_task((uint32_t)i, prio);
+    }
+    GMK_ASSERT_EQ(gmk_rq_push_n(&rq, in, 12), 12, "push_n all");
+    GMK_ASSERT_EQ(gmk_rq_count(&rq), 12, "count == 12");
+
+    /* One weighted round: P0 (4 of 8 budget), P2 (4 of 2 budget -> 2),
+     * P3 (1), then a new round continues with the rest */
+    gmk_task_t out[16];
+    GMK_ASSERT_EQ(gmk_rq_pop_n(&rq, out, 7), 7, "pop_n 7");
+    GMK_ASSERT_EQ(out[0].type, 4, "P0 first");
+    GMK_ASSERT_EQ(out[3].type, 7, "P0 run in order");
+    GMK_ASSERT_EQ(out[4].type, 0, "then P2");
+    GMK_ASSERT_EQ(out[5].type, 1, "P2 capped by weight");
+    GMK_ASSERT_EQ(out[6].type, 8, "then P3");
+
+    GMK_ASSERT_EQ(gmk_rq_pop_n(&rq, out, 16), 5, "pop_n rest");
+    GMK_ASSERT_EQ(gmk_rq_count(&rq), 0, "empty");
+    GMK_ASSERT_EQ(gmk_rq_pop_n(&rq, out, 16), 0, "pop_n on empty");
+
+    gmk_rq_destroy(&rq);
+}
+
+static void test_bulk_push_full(void) {
+    gmk_rq_t rq;
+    gmk_rq_init(&rq, 4);
+
+    gmk_task_t in[6];
+    for (int i = 0; i < 6; i++)
+        in[i] = make_task((uint32_t)i, GMK_PRIO_HIGH);
+    GMK_ASSERT_EQ(gmk_rq_push_n(&rq, in, 6), 4, "push_n stops when full");
+
+    gmk_rq_destroy(&rq);
+}
+
 int main(void) {
     GMK_TEST_BEGIN("sched_rq");
     GMK_RUN_TEST(test_basic_push_pop);
     GMK_RUN_TEST(test_priority_ordering);
     GMK_RUN_TEST(test_weighted_pop);
     GMK_RUN_TEST(test_empty_pop);
+    GMK_RUN_TEST(test_bulk_push_pop);
+    GMK_RUN_TEST(test_bulk_push_full);
     GMK_TEST_END();
     return 0;
 }
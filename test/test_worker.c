@@ -153,10 +153,290 @@ static void test_yield_flow(void) {
     gmk_alloc_destroy(&alloc);
 }
 
+/* ── Test type-sorted batch dispatch ─────────────────────────── */
+static uint32_t batch_seen[64];
+static _Atomic(uint32_t) batch_seen_n;
+
+static int record_handler(gmk_ctx_t *ctx) {
+    uint32_t i = gmk_atomic_add(&batch_seen_n, 1, memory_order_relaxed);
+    if (i < 64)
+        batch_seen[i] = ctx->task->type * 100 + (uint32_t)ctx->task->meta0;
+    return GMK_OK;
+}
+
+static void test_batch_sorted_dispatch(void) {
+    atomic_init(&batch_seen_n, 0);
+
+    gmk_alloc_t alloc;
+    gmk_trace_t trace;
+    gmk_metrics_t metrics;
+    gmk_sched_t sched;
+    gmk_chan_reg_t chan;
+    gmk_module_reg_t modules;
+
+    gmk_alloc_init(&alloc, 1024 * 1024);
+    gmk_trace_init(&trace, 1);
+    gmk_metrics_init(&metrics, 1);
+    gmk_sched_init(&sched, 1);
+    gmk_chan_reg_init(&chan, &sched, &alloc, &trace, &metrics);
+    gmk_module_reg_init(&modules, &chan, &trace, &metrics);
+
+    gmk_handler_reg_t handlers[] = {
+        { .type = 4, .fn = record_handler, .name = "rec_a" },
+        { .type = 5, .fn = record_handler, .name = "rec_b" },
+        { .type = 6, .fn = record_handler, .name = "rec_c" },
+    };
+    gmk_module_t mod = {
+        .name = "batch_test", .handlers = handlers, .n_handlers = 3,
+    };
+    gmk_module_register(&modules, &mod);
+
+    /* Interleaved types 6,5,4,6,5,4,... with meta0 = arrival order */
+    for (uint32_t i = 0; i < 12; i++) {
+        gmk_task_t t;
+        memset(&t, 0, sizeof(t));
+        t.type  = 6 - (i % 3);
+        t.meta0 = i;
+        gmk_lq_push(&sched.lqs[0], &t);
+    }
+
+    gmk_worker_pool_t pool;
+    gmk_worker_pool_init(&pool, 1, &sched, &modules,
+                         &alloc, &chan, &trace, &metrics, NULL);
+    gmk_worker_pool_set_batch(&pool, 12);
+    GMK_ASSERT_EQ(pool.workers[0].batch_size, 12, "batch size applied");
+    gmk_worker_pool_start(&pool);
+
+    for (int wait = 0; wait < 100; wait++) {
+        if (gmk_atomic_load(&batch_seen_n, memory_order_relaxed) >= 12)
+            break;
+        usleep(10000);
+    }
+    GMK_ASSERT_EQ(gmk_atomic_load(&batch_seen_n, memory_order_relaxed), 12,
+                  "all tasks dispatched");
+
+    /* One batch: grouped by type, arrival order kept within a type */
+    uint32_t expect[12] = { 402, 405, 408, 411, 501, 504, 507, 510,
+                            600, 603, 606, 609 };
+    for (int i = 0; i < 12; i++)
+        GMK_ASSERT_EQ(batch_seen[i], expect[i], "stable type-sorted order");
+    GMK_ASSERT_EQ(gmk_metric_batch_get(&metrics, 4), 1,
+                  "one gather of 9..16 tasks recorded");
+
+    gmk_worker_pool_stop(&pool);
+    gmk_worker_pool_destroy(&pool);
+    gmk_module_reg_destroy(&modules);
+    gmk_chan_reg_destroy(&chan);
+    gmk_sched_destroy(&sched);
+    gmk_metrics_destroy(&metrics);
+    gmk_trace_destroy(&trace);
+    gmk_alloc_destroy(&alloc);
+}
+
+/* ── Test stealing from a hot worker's LQ ────────────────────── */
+static _Atomic(int) steal_counter;
+static _Atomic(uint32_t) steal_seen_mask;
+
+static int slow_handler(gmk_ctx_t *ctx) {
+    gmk_atomic_add(&steal_counter, 1, memory_order_relaxed);
+    atomic_fetch_or(&steal_seen_mask, 1u << ctx->worker_id);
+    usleep(200);
+    return GMK_OK;
+}
+
+static void test_work_stealing(void) {
+    atomic_init(&steal_counter, 0);
+    atomic_init(&steal_seen_mask, 0);
+
+    gmk_alloc_t alloc;
+    gmk_trace_t trace;
+    gmk_metrics_t metrics;
+    gmk_sched_t sched;
+    gmk_chan_reg_t chan;
+    gmk_module_reg_t modules;
+
+    gmk_alloc_init(&alloc, 1024 * 1024);
+    gmk_trace_init(&trace, 1);
+    gmk_metrics_init(&metrics, 1);
+    gmk_sched_init(&sched, 4);
+    gmk_chan_reg_init(&chan, &sched, &alloc, &trace, &metrics);
+    gmk_module_reg_init(&modules, &chan, &trace, &metrics);
+
+    gmk_handler_reg_t handlers[] = {
+        { .type = 3, .fn = slow_handler, .name = "slow" },
+    };
+    gmk_module_t mod = {
+        .name = "steal_test", .handlers = handlers, .n_handlers = 1,
+    };
+    gmk_module_register(&modules, &mod);
+
+    /* Skewed load: everything lands on worker 0's LQ before start */
+    int n_tasks = 0;
+    for (int i = 0; i < 256; i++) {
+        gmk_task_t t;
+        memset(&t, 0, sizeof(t));
+        t.type = 3;
+        if (gmk_lq_push(&sched.lqs[0], &t) == 0)
+            n_tasks++;
+    }
+    GMK_ASSERT_EQ(n_tasks, 256, "hot LQ filled");
+
+    gmk_worker_pool_t pool;
+    gmk_worker_pool_init(&pool, 4, &sched, &modules,
+                         &alloc, &chan, &trace, &metrics, NULL);
+    gmk_worker_pool_start(&pool);
+
+    for (int wait = 0; wait < 500; wait++) {
+        if (gmk_atomic_load(&steal_counter, memory_order_relaxed) >= n_tasks)
+            break;
+        usleep(10000);
+    }
+
+    GMK_ASSERT_EQ(gmk_atomic_load(&steal_counter, memory_order_relaxed),
+                  n_tasks, "all tasks dispatched");
+    GMK_ASSERT(gmk_metric_get(&metrics, GMK_METRIC_TASKS_STOLEN) > 0,
+               "tasks were stolen");
+    uint32_t mask = gmk_atomic_load(&steal_seen_mask, memory_order_relaxed);
+    GMK_ASSERT(mask != 1u, "siblings of the hot worker ran tasks");
+
+    gmk_worker_pool_stop(&pool);
+    gmk_worker_pool_destroy(&pool);
+    gmk_module_reg_destroy(&modules);
+    gmk_chan_reg_destroy(&chan);
+    gmk_sched_destroy(&sched);
+    gmk_metrics_destroy(&metrics);
+    gmk_trace_destroy(&trace);
+    gmk_alloc_destroy(&alloc);
+}
+
+/* ── Eventcount parking ──────────────────────────────────────── */
+static void test_park_eventcount(void) {
+    gmk_hal_park_t p;
+    gmk_hal_park_init(&p);
+
+    /* A wake between prepare and commit makes the commit return at once */
+    uint32_t key = gmk_hal_park_prepare(&p);
+    gmk_hal_park_wake(&p);
+    uint64_t t0 = gmk_hal_now_ns();
+    gmk_hal_park_commit(&p, key, 1000000000ull);
+    GMK_ASSERT(gmk_hal_now_ns() - t0 < 100000000ull, "wake before commit not lost");
+
+    /* Cancel leaves no waiter behind; a later commit times out */
+    key = gmk_hal_park_prepare(&p);
+    gmk_hal_park_cancel(&p);
+    key = gmk_hal_park_prepare(&p);
+    t0 = gmk_hal_now_ns();
+    gmk_hal_park_commit(&p, key, 2000000ull);
+    GMK_ASSERT(gmk_hal_now_ns() - t0 >= 1000000ull, "commit waits for its timeout");
+
+    gmk_hal_park_destroy(&p);
+}
+
+static _Atomic(uint64_t) wake_seen_ns;
+
+static int stamp_handler(gmk_ctx_t *ctx) {
+    (void)ctx;
+    gmk_atomic_store(&wake_seen_ns, gmk_hal_now_ns(), memory_order_release);
+    return GMK_OK;
+}
+
+/* Counts sched.wake calls per target (index 0 = any worker) */
+static _Atomic(int) hook_calls[3];
+
+static void counting_notify(void *arg, int worker_id) {
+    gmk_atomic_add(&hook_calls[worker_id + 1], 1, memory_order_relaxed);
+    gmk_worker_notify(arg, worker_id);
+}
+
+/* With spinning off, parked workers must be woken by the enqueue itself
+ * (sched.wake), and an idle pool must stay parked. The pool has no
+ * allocator, so no worker keeps the rebalance cadence and every park
+ * lasts GMK_PARK_TIMEOUT_NS unless something wakes it. */
+static void test_park_wake(void) {
+    atomic_init(&wake_seen_ns, 0);
+    for (int i = 0; i < 3; i++)
+        atomic_init(&hook_calls[i], 0);
+
+    gmk_alloc_t alloc;
+    gmk_trace_t trace;
+    gmk_metrics_t metrics;
+    gmk_sched_t sched;
+    gmk_chan_reg_t chan;
+    gmk_module_reg_t modules;
+
+    gmk_alloc_init(&alloc, 1024 * 1024);
+    gmk_trace_init(&trace, 1);
+    gmk_metrics_init(&metrics, 1);
+    gmk_sched_init(&sched, 2);
+    gmk_chan_reg_init(&chan, &sched, &alloc, &trace, &metrics);
+    gmk_module_reg_init(&modules, &chan, &trace, &metrics);
+
+    gmk_handler_reg_t handlers[] = {
+        { .type = 4, .fn = stamp_handler, .name = "stamp" },
+    };
+    gmk_module_t mod = {
+        .name = "park_test", .handlers = handlers, .n_handlers = 1,
+    };
+    gmk_module_register(&modules, &mod);
+
+    gmk_worker_pool_t pool;
+    gmk_worker_pool_init(&pool, 2, &sched, &modules,
+                         NULL, &chan, &trace, &metrics, NULL);
+    gmk_worker_pool_set_park(&pool, GMK_PARK_SPIN_OFF);
+    sched.wake = counting_notify;
+    sched.wake_arg = &pool;
+    gmk_worker_pool_start(&pool);
+
+    /* Idle: both workers sleep through the safety timeout, at most twice
+     * each in 150 ms */
+    usleep(20000);
+    uint64_t wakes = gmk_metric_get(&metrics, GMK_METRIC_WORKER_WAKES);
+    usleep(150000);
+    wakes = gmk_metric_get(&metrics, GMK_METRIC_WORKER_WAKES) - wakes;
+    GMK_ASSERT(gmk_metric_get(&metrics, GMK_METRIC_WORKER_PARKS) >= 2, "workers parked");
+    GMK_ASSERT(wakes <= 4, "idle workers stay parked");
+
+    for (int round = 0; round < 2; round++) {
+        gmk_task_t t;
+        memset(&t, 0, sizeof(t));
+        t.type = 4;
+        atomic_store(&wake_seen_ns, 0);
+        uint64_t t0 = gmk_hal_now_ns();
+        GMK_ASSERT_EQ(_gmk_enqueue(&sched, &t, round == 0 ? -1 : 1), 0, "enqueue");
+
+        for (int wait = 0; wait < 1000; wait++) {
+            if (gmk_atomic_load(&wake_seen_ns, memory_order_acquire)) break;
+            usleep(100);
+        }
+        uint64_t seen = gmk_atomic_load(&wake_seen_ns, memory_order_acquire);
+        GMK_ASSERT(seen != 0, "parked worker ran the task");
+        /* The hook fired for this route (RQ: any worker; inbox: worker 1)
+         * and the task ran far inside the safety timeout */
+        GMK_ASSERT_EQ(gmk_atomic_load(&hook_calls[round == 0 ? 0 : 2],
+                                      memory_order_relaxed), 1, "wake hook fired");
+        GMK_ASSERT(seen - t0 < GMK_PARK_TIMEOUT_NS / 10, "woken by the enqueue");
+        usleep(20000);
+    }
+
+    sched.wake = NULL;
+    gmk_worker_pool_stop(&pool);
+    gmk_worker_pool_destroy(&pool);
+    gmk_module_reg_destroy(&modules);
+    gmk_chan_reg_destroy(&chan);
+    gmk_sched_destroy(&sched);
+    gmk_metrics_destroy(&metrics);
+    gmk_trace_destroy(&trace);
+    gmk_alloc_destroy(&alloc);
+}
+
 int main(void) {
     GMK_TEST_BEGIN("worker");
     GMK_RUN_TEST(test_basic_dispatch);
     GMK_RUN_TEST(test_yield_flow);
+    GMK_RUN_TEST(test_batch_sorted_dispatch);
+    GMK_RUN_TEST(test_work_stealing);
+    GMK_RUN_TEST(test_park_eventcount);
+    GMK_RUN_TEST(test_park_wake);
     GMK_TEST_END();
     return 0;
 }